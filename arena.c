@@ -0,0 +1,185 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  ARENA -- bump allocation for state that dies all at once
+ *
+ *  An arena hands out memory from a chain of blocks by moving a
+ *  pointer, and takes it all back with arena_reset(), which only
+ *  rewinds to the first block: the blocks stay for the next record
+ *  or batch, so a reader that has seen its largest entry allocates
+ *  nothing more.  arena_free() returns the blocks to malloc.  An
+ *  all-zero struct arena is empty, with ARENA_BLOCK blocks.
+ *
+ *  Each arena belongs to one thread (a scan_state's record, one
+ *  cube's or index's interned names) and takes no locks.  Only
+ *  getting and freeing a block touches the process-wide totals that
+ *  arena_stats() reports, with atomic adds.
+ *
+ *********************************************************************/
+
+#define ARENA_ALIGN     16
+
+struct arena_block {
+  struct arena_block *next;
+  size_t size;                       /* of data[] */
+  char data[] __attribute__((aligned(ARENA_ALIGN)));
+};
+
+static long long reserved_now, reserved_peak;
+
+
+static void account (long long delta) {
+  long long now = __atomic_add_fetch(&reserved_now, delta, __ATOMIC_RELAXED);
+  long long peak = __atomic_load_n(&reserved_peak, __ATOMIC_RELAXED);
+
+  while ((now > peak) &&
+         (!__atomic_compare_exchange_n(&reserved_peak, &peak, now, 1, __ATOMIC_RELAXED,
+                                       __ATOMIC_RELAXED)))
+    ;
+}
+
+
+void arena_init (struct arena *a, size_t block_size) {
+  memset(a, 0, sizeof(*a));
+  a->block_size = block_size ? block_size : ARENA_BLOCK;
+}
+
+
+static size_t in_use (const struct arena *a) {
+  return a->cur ? a->done + (a->p - a->cur->data) : 0;
+}
+
+
+void * arena_alloc (struct arena *a, size_t n) {
+/*****************************************************************
+ *
+ *  n bytes aligned to ARENA_ALIGN, good until the next reset.
+ *  When the current block is full the next one kept from before
+ *  a reset is used if it is big enough; otherwise a new block,
+ *  twice the last and at least n, goes in after the current one.
+ *
+ *****************************************************************/
+  struct arena_block *b;
+  size_t size;
+  void *p;
+
+  n = (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+  if ((a->cur == NULL) || (a->end - a->p < (long)n)) {
+    if (a->cur != NULL)
+      a->done += a->cur->size;
+    if ((a->cur != NULL) && (a->cur->next != NULL) && (a->cur->next->size >= n))
+      b = a->cur->next;
+    else {
+      size = a->cur ? 2*a->cur->size : a->block_size ? a->block_size : ARENA_BLOCK;
+      if (size < n)
+        size = n;
+      if ((b = malloc(sizeof(struct arena_block) + size)) == NULL) {
+        perror("arena");
+        exit(-1);
+      }
+      b->size = size;
+      account(size);
+      a->reserved += size;
+      if (a->cur == NULL) {
+        b->next = a->first;
+        a->first = b;
+      } else {
+        b->next = a->cur->next;
+        a->cur->next = b;
+      }
+    }
+    a->cur = b;
+    a->p = b->data;
+    a->end = b->data + b->size;
+  }
+  p = a->p;
+  a->p += n;
+  return p;
+} //----- arena_alloc -----//
+
+
+char * arena_strndup (struct arena *a, const char *s, size_t n) {
+  char *d = arena_alloc(a, n + 1);
+
+  memcpy(d, s, n);
+  d[n] = '\0';
+  return d;
+}
+
+
+void arena_reset (struct arena *a) {
+/*****************************************************************
+ *  Everything allocated is dead; the blocks are kept
+ *****************************************************************/
+  size_t used = in_use(a);
+
+  if (used > a->peak)
+    a->peak = used;
+  a->cur = a->first;
+  a->done = 0;
+  if (a->cur != NULL) {
+    a->p = a->cur->data;
+    a->end = a->cur->data + a->cur->size;
+  }
+}
+
+
+void arena_free (struct arena *a) {
+  struct arena_block *b, *next;
+
+  arena_reset(a);
+  for (b=a->first;b!=NULL;b=next) {
+    next = b->next;
+    account(-(long long)b->size);
+    free(b);
+  }
+  a->first = a->cur = NULL;
+  a->p = a->end = NULL;
+  a->reserved = 0;
+}
+
+
+size_t arena_peak (const struct arena *a) {
+  size_t used = in_use(a);
+
+  return (used > a->peak) ? used : a->peak;
+}
+
+
+void arena_stats (long long *now, long long *peak) {
+/*****************************************************************
+ *  Bytes in arena blocks across the process, now and at most
+ *****************************************************************/
+  *now = __atomic_load_n(&reserved_now, __ATOMIC_RELAXED);
+  *peak = __atomic_load_n(&reserved_peak, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,428 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "promog.h"
+
+#define STDOUT 1
+
+/*********************************************************************
+ *
+ *  BATCH -- many datafiles in one run on one pool of threads
+ *
+ *  promog [options] <datafile> <datafile> ...  (or --manifest=FILE,
+ *  one path per line) cuts every file into units, byte ranges that
+ *  begin on an entry as in the single-file scan, and -j workers take
+ *  the units in file order.  Each worker compiles the rules once and
+ *  keeps its block and line buffers for all the files it touches.
+ *
+ *  --io-limit=N caps the number of files being read at once: a
+ *  worker only starts on a new file while fewer than N have units
+ *  in flight, and otherwise waits for one to finish, so that
+ *  releases on one disk are not all read at the same time.  Within
+ *  a file every worker may help.
+ *
+ *  Each file's units are merged into a report of its own, printed
+ *  and drawn under its name in the order given, then all of them
+ *  into a "combined" report.  With --cache a file whose result is
+ *  saved is not read at all, and the files that were are saved.
+ *
+ *********************************************************************/
+
+#define UNIT_MIN          (4LL<<20)      /* smaller files are fewer units */
+
+struct batch_file {
+  const char *path;
+  struct stat sb;
+  int first, n_units;                /* units[first .. first+n_units-1] */
+  int next, left;                    /* next to hand out, still scanning */
+  struct cache_key key;
+  struct crosstab **cached;          /* the cache answered */
+  struct timespec t_begin, t_end;
+  struct promog_summary sum;
+};
+
+struct batch {
+  const struct batch_opts *o;
+  struct batch_file *files;
+  int n_files;
+  struct scan_state *units;
+  int active;                        /* files with units in flight */
+  int bad;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+struct batch_worker {
+  struct batch *b;
+  struct promog_rules rules;
+  char *block, *line;
+  struct metrics met;
+  pthread_t tid;
+};
+
+
+static struct scan_state * batch_take (struct batch *b, struct batch_file **fp) {
+/*****************************************************************
+ *
+ *  The next unit of the earliest file that still has some, if
+ *  that file is already being read or --io-limit allows one more.
+ *  NULL when every unit has been handed out.  Called locked.
+ *
+ *****************************************************************/
+  struct batch_file *f;
+  int i, waiting;
+
+  for (;;) {
+    waiting = 0;
+    for (i=0;i<b->n_files;i++) {
+      f = &b->files[i];
+      if (f->next == f->n_units)
+        continue;
+      waiting = 1;
+      if ((f->next == 0) && (b->active >= b->o->io_limit))
+        continue;
+      if (f->next == 0) {
+        b->active++;
+        clock_gettime(CLOCK_MONOTONIC, &f->t_begin);
+      }
+      *fp = f;
+      return &b->units[f->first + f->next++];
+    }
+    if (!waiting)
+      return NULL;
+    pthread_cond_wait(&b->cond, &b->lock);
+  }
+} //----- batch_take -----//
+
+
+static void * batch_worker (void *arg) {
+  struct batch_worker *w = arg;
+  struct batch *b = w->b;
+  struct batch_file *f;
+  struct scan_state *st;
+
+  pthread_mutex_lock(&b->lock);
+  while ((st = batch_take(b, &f)) != NULL) {
+    pthread_mutex_unlock(&b->lock);
+
+    if ((st->fd = open(f->path, O_RDONLY)) < 0) {
+      fprintf(stderr, "CAN'T OPEN FILE: %s\n", f->path);
+      pthread_mutex_lock(&b->lock);
+      b->bad = 1;
+      pthread_mutex_unlock(&b->lock);
+    }
+    else {
+      st->rules = &w->rules;
+      st->block = w->block;
+      st->line = w->line;
+      st->met = &w->met;
+      scan_range(st);
+      close(st->fd);
+    }
+
+    pthread_mutex_lock(&b->lock);
+    if (--f->left == 0) {
+      clock_gettime(CLOCK_MONOTONIC, &f->t_end);
+      b->active--;
+      pthread_cond_broadcast(&b->cond);
+    }
+  }
+  pthread_mutex_unlock(&b->lock);
+  return NULL;
+} //----- batch_worker -----//
+
+
+static void batch_add (struct promog_summary *to, const struct promog_summary *from) {
+  int j;
+
+  if (from->report != to->report) {    /* a file's first unit: its cubes */
+    crosstab_merge(to->report, from->report);
+    for (j=0;j<to->n_cubes;j++)
+      crosstab_merge(to->cubes[j], from->cubes[j]);
+  }
+  to->tot_proteins += from->tot_proteins;
+  to->line_num += from->line_num;
+  to->char_count += from->char_count;
+  if (from->max_line > to->max_line)
+    to->max_line = from->max_line;
+  if (from->max_prot_lines > to->max_prot_lines)
+    to->max_prot_lines = from->max_prot_lines;
+  if (from->max_prot_chars > to->max_prot_chars)
+    to->max_prot_chars = from->max_prot_chars;
+  to->corrupt_infile |= from->corrupt_infile;
+}
+
+
+int batch_manifest (const char *path, const char ***paths, int *n) {
+/*****************************************************************
+ *  Append the paths listed in a manifest, one per line; blank
+ *  lines and lines starting with # are skipped
+ *****************************************************************/
+  char buf[4096];
+  int len;
+  FILE *fp;
+
+  if ((fp = fopen(path, "r")) == NULL) {
+    fprintf(stderr, "CAN'T OPEN MANIFEST: %s\n", path);
+    return -1;
+  }
+  while (fgets(buf, sizeof(buf), fp) != NULL) {
+    len = strlen(buf);
+    while ((len > 0) && ((buf[len-1] == '\n') || (buf[len-1] == '\r') || (buf[len-1] == ' ')))
+      buf[--len] = '\0';
+    if ((len == 0) || (buf[0] == '#'))
+      continue;
+    *paths = realloc(*paths, (*n + 1)*sizeof(char *));
+    (*paths)[(*n)++] = strdup(buf);
+  }
+  fclose(fp);
+  return 0;
+} //----- batch_manifest -----//
+
+
+int batch_run (const char **paths, int n_paths, const struct batch_opts *o) {
+/*****************************************************************
+ *
+ *  Scan, report and draw every file, then the combined report.
+ *  0, or -1 if a file could not be opened or a worker started.
+ *
+ *****************************************************************/
+  const int MAXLINE  = getpagesize();
+  struct batch b;
+  struct batch_file *f;
+  struct batch_worker *w;
+  struct scan_state *st;
+  struct promog_summary all;
+  struct progress *pg = NULL;
+  struct timespec t_begin, t_end;
+  long long total = 0, span;
+  int i, j, k, n_units = 0, fd;
+
+  memset(&b, 0, sizeof(b));
+  b.o = o;
+  b.n_files = n_paths;
+  b.files = calloc(n_paths, sizeof(struct batch_file));
+  pthread_mutex_init(&b.lock, NULL);
+  pthread_cond_init(&b.cond, NULL);
+
+  /*****************************************************************
+   *  Stat every file, try the cache, and count the units
+   *****************************************************************/
+  metrics_begin(o->met, MX_SETUP);
+  for (i=0;i<n_paths;i++) {
+    f = &b.files[i];
+    f->path = paths[i];
+    if (((fd = open(f->path, O_RDONLY)) < 0) || (fstat(fd, &f->sb) < 0)) {
+      fprintf(stderr, "CAN'T OPEN FILE: %s\n", f->path);
+      if (fd >= 0)
+        close(fd);
+      return -1;
+    }
+    f->sum.datafile = f->path;
+    f->sum.mem_method = o->mem_method;
+    f->sum.blocksize = o->blocksize;
+    f->sum.render = o->render;
+    f->sum.seq = o->seq;
+    if (o->cache_dir != NULL) {
+      cache_key_init(&f->key, fd, &f->sb, o->seq, o->specs, o->n_specs, o->use_fingerprint);
+      if (cache_load(o->cache_dir, &f->key, &f->sum, &f->cached) < 0)
+        f->cached = NULL;
+    }
+    close(fd);
+    if (f->cached != NULL)
+      continue;
+    f->n_units = 1 + f->sb.st_size/UNIT_MIN;
+    if (f->n_units > o->n_threads)
+      f->n_units = o->n_threads;
+    f->first = n_units;
+    f->left = f->n_units;
+    n_units += f->n_units;
+    total += f->sb.st_size;
+  }
+
+  /*****************************************************************
+   *  Cut the files into units, each with its own cubes
+   *****************************************************************/
+  b.units = calloc(n_units ? n_units : 1, sizeof(struct scan_state));
+  for (i=0;i<n_paths;i++) {
+    f = &b.files[i];
+    if (f->n_units == 0)
+      continue;
+    fd = open(f->path, O_RDONLY);
+    for (k=0;k<f->n_units;k++) {
+      st = &b.units[f->first + k];
+      span = f->sb.st_size;
+      st->start = snap_to_record(fd, k*span/f->n_units);
+      st->origin = st->start;
+      st->end = (k == f->n_units - 1) ? LLONG_MAX :
+                snap_to_record(fd, (k + 1)*span/f->n_units);
+      st->blocksize = o->blocksize;
+      st->n_cubes = o->n_specs;
+      st->cubes = malloc(st->n_cubes*sizeof(struct crosstab *));
+      for (j=0;j<o->n_specs;j++)
+        st->cubes[j] = crosstab_new(o->specs[j]);
+    }
+    close(fd);
+  }
+
+  w = calloc(o->n_threads, sizeof(struct batch_worker));
+  for (k=0;k<o->n_threads;k++) {
+    w[k].b = &b;
+    if (compile_rules(&w[k].rules))
+      return -1;
+    w[k].rules.seq = o->seq;
+    w[k].block = valloc(o->blocksize);
+    w[k].line = malloc((MAXLINE+2)*sizeof(char));
+    metrics_init(&w[k].met);
+  }
+  metrics_end(o->met, MX_SETUP);
+
+  clock_gettime(CLOCK_MONOTONIC, &t_begin);
+  if ((o->progress_interval > 0) && (n_units > 0))
+    pg = progress_start(b.units, n_units, total, o->progress_interval, o->status_path);
+  metrics_begin(o->met, MX_SCAN);
+  for (k=0;k<o->n_threads;k++)
+    if (pthread_create(&w[k].tid, NULL, batch_worker, &w[k])) {
+      fprintf(stderr, "CAN'T START SCANNING THREAD %d\n", k);
+      return -1;
+    }
+  for (k=0;k<o->n_threads;k++)
+    pthread_join(w[k].tid, NULL);
+  metrics_end(o->met, MX_SCAN);
+  progress_stop(pg);
+  clock_gettime(CLOCK_MONOTONIC, &t_end);
+  if (b.bad)
+    return -1;
+
+  /*****************************************************************
+   *  Each file's units in order into its first, then every file
+   *  into the combined cubes
+   *****************************************************************/
+  metrics_begin(o->met, MX_MERGE);
+  memset(&all, 0, sizeof(all));
+  all.datafile = "combined";
+  all.mem_method = o->mem_method;
+  all.n_threads = o->n_threads;
+  all.blocksize = o->blocksize;
+  all.render = o->render;
+  all.seq = o->seq;
+  all.t_begin = t_begin;
+  all.t_end = t_end;
+  all.report = crosstab_new(o->specs[0]);
+  all.n_cubes = o->n_specs - 1;
+  all.cubes = malloc((all.n_cubes + 1)*sizeof(struct crosstab *));
+  for (j=0;j<all.n_cubes;j++)
+    all.cubes[j] = crosstab_new(o->specs[1 + j]);
+  for (i=0;i<n_paths;i++) {
+    f = &b.files[i];
+    if (f->cached == NULL) {
+      st = &b.units[f->first];
+      f->sum.n_threads = f->n_units;
+      f->sum.t_begin = f->t_begin;
+      f->sum.t_end = f->t_end;
+      f->sum.report = st->cubes[0];
+      f->sum.n_cubes = st->n_cubes - 1;
+      f->sum.cubes = st->cubes + 1;
+      for (k=0;k<f->n_units;k++) {
+        struct promog_summary unit;
+
+        st = &b.units[f->first + k];
+        memset(&unit, 0, sizeof(unit));
+        unit.report = st->cubes[0];
+        unit.n_cubes = st->n_cubes - 1;
+        unit.cubes = st->cubes + 1;
+        unit.tot_proteins = st->tot_proteins;
+        unit.line_num = st->line_num;
+        unit.char_count = st->char_count;
+        unit.max_line = st->max_line;
+        unit.max_prot_lines = st->max_prot_lines;
+        unit.max_prot_chars = st->max_prot_chars;
+        unit.corrupt_infile = st->corrupt_infile;
+        batch_add(&f->sum, &unit);
+      }
+    }
+    batch_add(&all, &f->sum);
+  }
+  metrics_end(o->met, MX_MERGE);
+  for (k=0;k<o->n_threads;k++)
+    metrics_merge(o->met, &w[k].met);
+  o->met->ph[MX_SCAN].bytes = o->met->ph[MX_READ].bytes;
+  o->met->ph[MX_SCAN].records = all.tot_proteins;
+  o->met->ph[MX_SCAN].lines = all.line_num;
+
+  for (i=0;i<n_paths;i++) {
+    f = &b.files[i];
+    metrics_begin(o->met, MX_OUTPUT);
+    summary_write(&f->sum, o->format, STDOUT);
+    if ((o->cache_dir != NULL) && (f->cached == NULL))
+      cache_store(o->cache_dir, &f->key, &f->sum);
+    metrics_end(o->met, MX_OUTPUT);
+    metrics_begin(o->met, MX_RENDER);
+    summary_cellgrams(&f->sum);
+    metrics_end(o->met, MX_RENDER);
+  }
+  metrics_begin(o->met, MX_OUTPUT);
+  summary_write(&all, o->format, STDOUT);
+  metrics_end(o->met, MX_OUTPUT);
+  metrics_begin(o->met, MX_RENDER);
+  summary_cellgrams(&all);
+  metrics_end(o->met, MX_RENDER);
+
+  for (k=0;k<n_units;k++) {
+    for (j=0;j<b.units[k].n_cubes;j++)
+      crosstab_free(b.units[k].cubes[j]);
+    free(b.units[k].cubes);
+  }
+  for (i=0;i<n_paths;i++)
+    if (b.files[i].cached != NULL) {
+      for (j=0;j<o->n_specs;j++)
+        crosstab_free(b.files[i].cached[j]);
+      free(b.files[i].cached);
+    }
+  for (j=0;j<all.n_cubes;j++)
+    crosstab_free(all.cubes[j]);
+  free(all.cubes);
+  crosstab_free(all.report);
+  for (k=0;k<o->n_threads;k++) {
+    free_rules(&w[k].rules);
+    free(w[k].block);
+    free(w[k].line);
+  }
+  free(w);
+  free(b.units);
+  free(b.files);
+  return 0;
+} //----- batch_run -----//
@@ -0,0 +1,222 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  CACHE -- saved results keyed on the identity of the input
+ *
+ *  promog --cache=<dir> looks for <dir>/<key>.pmc before scanning.
+ *  The key covers the datafile's device, inode, size and mtime,
+ *  the rules_hash() of the term tables, the sequence stages and
+ *  cube specs of the run and, with --fingerprint, a hash of
+ *  sampled file content (for files rewritten in place with their
+ *  mtime restored).  A hit holds every counter and cube of the
+ *  earlier scan, so the report is reprinted without reading the
+ *  datafile.  After a scan that missed, the results are saved
+ *  under the same key.
+ *
+ *  The file is a raw image for this build: "PROMOGRC", version, the
+ *  key, struct cache_counts, int n_cubes, crosstab_write() images.
+ *
+ *********************************************************************/
+
+#define CACHE_MAGIC       "PROMOGRC"
+#define CACHE_VERSION     2
+#define FP_BLOCK          4096
+#define FP_BLOCKS         64
+
+struct cache_counts {
+  long long tot_proteins, line_num, char_count;
+  long long max_line, max_prot_lines, max_prot_chars, corrupt_infile;
+  long long begin_sec, begin_nsec, end_sec, end_nsec;
+};
+
+
+static unsigned long long fnv (unsigned long long h, const void *p, size_t len) {
+  const unsigned char *s = p;
+
+  while (len--)
+    h = (h ^ *s++) * 1099511628211ULL;
+  return h;
+}
+
+static unsigned long long fingerprint (int fd, long long size) {
+/*****************************************************************
+ *  FNV-1a of FP_BLOCKS blocks spread evenly over the file, the
+ *  first and last included
+ *****************************************************************/
+  unsigned long long h = 14695981039346656037ULL;
+  char buf[FP_BLOCK];
+  long long off;
+  ssize_t n;
+  int i;
+
+  for (i=0;i<FP_BLOCKS;i++) {
+    off = (size > FP_BLOCK) ? (size - FP_BLOCK) / (FP_BLOCKS - 1) * i : 0;
+    if ((n = pread(fd, buf, FP_BLOCK, (off_t) off)) > 0)
+      h = fnv(h, buf, n);
+    if (size <= FP_BLOCK)
+      break;
+  }
+  return h;
+}
+
+
+void cache_key_init (struct cache_key *key, int fd, const struct stat *sb, int seq,
+                     const char **specs, int n_specs, int use_fingerprint) {
+  int i;
+
+  memset(key, 0, sizeof(struct cache_key));
+  key->dev = sb->st_dev;
+  key->ino = sb->st_ino;
+  key->size = sb->st_size;
+  key->mtime_sec = sb->st_mtim.tv_sec;
+  key->mtime_nsec = sb->st_mtim.tv_nsec;
+  key->rules = rules_hash();
+  key->specs = fnv(14695981039346656037ULL, &seq, sizeof(seq));
+  for (i=0;i<n_specs;i++)
+    key->specs = fnv(key->specs, specs[i], strlen(specs[i]) + 1);
+  if (use_fingerprint)
+    key->fingerprint = fingerprint(fd, sb->st_size);
+}
+
+static void cache_path (const char *dir, const struct cache_key *key, char *path, int size) {
+  snprintf(path, size, "%s/%016llx.pmc", dir,
+      fnv(14695981039346656037ULL, key, sizeof(struct cache_key)));
+}
+
+
+int cache_load (const char *dir, const struct cache_key *key,
+                struct promog_summary *sum, struct crosstab ***cubes) {
+/*****************************************************************
+ *
+ *  0 on a hit: fills the counters, timing and cubes of sum, with
+ *  *cubes the array to crosstab_free() and free() afterwards.
+ *  -1 on a miss, including a damaged or foreign cache file.
+ *
+ *****************************************************************/
+  char path[4096], magic[8];
+  struct cache_key saved;
+  struct cache_counts c;
+  struct crosstab **xt;
+  int version, n, i, bad = 0;
+  FILE *fp;
+
+  cache_path(dir, key, path, sizeof(path));
+  if ((fp = fopen(path, "r")) == NULL)
+    return -1;
+  if ((fread(magic, 1, 8, fp) != 8) || memcmp(magic, CACHE_MAGIC, 8) ||
+      (fread(&version, sizeof(int), 1, fp) != 1) || (version != CACHE_VERSION) ||
+      (fread(&saved, sizeof(saved), 1, fp) != 1) || memcmp(&saved, key, sizeof(saved)) ||
+      (fread(&c, sizeof(c), 1, fp) != 1) ||
+      (fread(&n, sizeof(int), 1, fp) != 1) || (n < 1) || (n > 1024)) {
+    fclose(fp);
+    return -1;
+  }
+  xt = calloc(n, sizeof(struct crosstab *));
+  for (i=0;(!bad)&&(i<n);i++)
+    bad = ((xt[i] = crosstab_read(fp)) == NULL);
+  fclose(fp);
+  if (bad) {
+    for (i=0;i<n;i++)
+      crosstab_free(xt[i]);
+    free(xt);
+    return -1;
+  }
+
+  sum->tot_proteins = c.tot_proteins;
+  sum->line_num = c.line_num;
+  sum->char_count = c.char_count;
+  sum->max_line = c.max_line;
+  sum->max_prot_lines = c.max_prot_lines;
+  sum->max_prot_chars = c.max_prot_chars;
+  sum->corrupt_infile = c.corrupt_infile;
+  sum->t_begin.tv_sec = c.begin_sec;
+  sum->t_begin.tv_nsec = c.begin_nsec;
+  sum->t_end.tv_sec = c.end_sec;
+  sum->t_end.tv_nsec = c.end_nsec;
+  sum->report = xt[0];
+  sum->n_cubes = n - 1;
+  sum->cubes = xt + 1;
+  *cubes = xt;
+  return 0;
+} //----- cache_load -----//
+
+
+int cache_store (const char *dir, const struct cache_key *key,
+                 const struct promog_summary *sum) {
+/*****************************************************************
+ *  Written to a temporary name and renamed, so a concurrent run
+ *  never reads half a file
+ *****************************************************************/
+  char path[4096], tmp[4200];
+  struct cache_counts c;
+  int version = CACHE_VERSION, n = sum->n_cubes + 1, i, bad;
+  FILE *fp;
+
+  cache_path(dir, key, path, sizeof(path));
+  snprintf(tmp, sizeof(tmp), "%s.%d", path, (int)getpid());
+  if ((fp = fopen(tmp, "w")) == NULL) {
+    fprintf(stderr, "CAN'T WRITE CACHE FILE: %s\n", tmp);
+    return -1;
+  }
+  memset(&c, 0, sizeof(c));
+  c.tot_proteins = sum->tot_proteins;
+  c.line_num = sum->line_num;
+  c.char_count = sum->char_count;
+  c.max_line = sum->max_line;
+  c.max_prot_lines = sum->max_prot_lines;
+  c.max_prot_chars = sum->max_prot_chars;
+  c.corrupt_infile = sum->corrupt_infile;
+  c.begin_sec = sum->t_begin.tv_sec;
+  c.begin_nsec = sum->t_begin.tv_nsec;
+  c.end_sec = sum->t_end.tv_sec;
+  c.end_nsec = sum->t_end.tv_nsec;
+  fwrite(CACHE_MAGIC, 1, 8, fp);
+  fwrite(&version, sizeof(int), 1, fp);
+  fwrite(key, sizeof(struct cache_key), 1, fp);
+  fwrite(&c, sizeof(c), 1, fp);
+  fwrite(&n, sizeof(int), 1, fp);
+  bad = crosstab_write(sum->report, fp);
+  for (i=0;i<sum->n_cubes;i++)
+    bad |= crosstab_write(sum->cubes[i], fp);
+  bad |= ferror(fp) | fclose(fp);
+  if (bad || rename(tmp, path)) {
+    fprintf(stderr, "FAILED WRITING CACHE FILE: %s\n", path);
+    unlink(tmp);
+    return -1;
+  }
+  return 0;
+} //----- cache_store -----//
@@ -0,0 +1,310 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  CHECKPOINT -- --checkpoint=<file> and --resume
+ *
+ *  Every CKPT_RECORDS entries a scan thread looks at the clock, and
+ *  once --checkpoint-interval seconds have passed since its last
+ *  snapshot it takes a new one: the start of the next entry in its
+ *  range, its counters and its cubes, serialized to memory.  Each
+ *  thread has a slot; the thread that took a snapshot rewrites the
+ *  whole file from all slots (temporary name, fsync, rename), so the
+ *  file on disk is always complete.  A thread that finishes its
+ *  range leaves a final snapshot marked done.
+ *
+ *  --resume loads the slots back into the scan states: each range
+ *  restarts at its saved entry with its saved counters and cubes,
+ *  so the report comes out as an uninterrupted run's would.  The
+ *  file is keyed like the result cache (datafile identity, rules,
+ *  cube specs) and carries the thread count, which --resume must
+ *  repeat, since the ranges depend on it.
+ *
+ *  The file: "PROMOGCK", version, struct cache_key, int n_threads,
+ *  int n_cubes, then per slot int present and, when present,
+ *  struct ckpt_counts and n_cubes crosstab_write() images.
+ *
+ *  The per-protein outputs (-i, -l, -e) are written as they go and
+ *  cannot be rolled back, so they are not checkpointed.
+ *
+ *********************************************************************/
+
+#define CKPT_MAGIC       "PROMOGCK"
+#define CKPT_VERSION     2
+#define CKPT_RECORDS     1024
+
+struct ckpt_counts {
+  long long offset, done;
+  long long tot_proteins, line_num, char_count;
+  long long max_line, max_prot_lines, max_prot_chars, corrupt_infile;
+};
+
+struct checkpoint {
+  const char *path;
+  struct cache_key key;
+  int n_threads, n_cubes, interval;
+  pthread_mutex_t lock;
+  char **slot;                       /* latest snapshot per thread, or NULL */
+  size_t *slot_len;
+  double *last;                      /* when each thread last took one */
+};
+
+
+static double now_sec (void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+struct checkpoint *checkpoint_new (const char *path, const struct cache_key *key,
+                                   int n_threads, int n_cubes, int interval) {
+  struct checkpoint *ck = calloc(1, sizeof(struct checkpoint));
+  int k;
+
+  ck->path = path;
+  ck->key = *key;
+  ck->n_threads = n_threads;
+  ck->n_cubes = n_cubes;
+  ck->interval = interval;
+  pthread_mutex_init(&ck->lock, NULL);
+  ck->slot = calloc(n_threads, sizeof(char *));
+  ck->slot_len = calloc(n_threads, sizeof(size_t));
+  ck->last = malloc(n_threads * sizeof(double));
+  for (k=0;k<n_threads;k++)
+    ck->last[k] = now_sec();
+  return ck;
+}
+
+
+static void snapshot (struct scan_state *st, long long offset, int done) {
+/*****************************************************************
+ *  Serialize one thread's state into its slot
+ *****************************************************************/
+  struct checkpoint *ck = st->ckpt;
+  struct ckpt_counts c;
+  char *buf = NULL;
+  size_t len = 0;
+  FILE *fp;
+  int j;
+
+  memset(&c, 0, sizeof(c));
+  c.offset = offset;
+  c.done = done;
+  c.tot_proteins = st->tot_proteins;
+  c.line_num = st->line_num;
+  c.char_count = st->char_count;
+  c.max_line = st->max_line;
+  c.max_prot_lines = st->max_prot_lines;
+  c.max_prot_chars = st->max_prot_chars;
+  c.corrupt_infile = st->corrupt_infile;
+  if ((fp = open_memstream(&buf, &len)) == NULL)
+    return;
+  fwrite(&c, sizeof(c), 1, fp);
+  for (j=0;j<st->n_cubes;j++)
+    crosstab_write(st->cubes[j], fp);
+  fclose(fp);
+
+  pthread_mutex_lock(&ck->lock);
+  free(ck->slot[st->ckpt_slot]);
+  ck->slot[st->ckpt_slot] = buf;
+  ck->slot_len[st->ckpt_slot] = len;
+  pthread_mutex_unlock(&ck->lock);
+}
+
+static int checkpoint_write (struct checkpoint *ck) {
+/*****************************************************************
+ *  All slots to a temporary file, fsync()ed and renamed over the
+ *  checkpoint; called with ck->lock held
+ *****************************************************************/
+  char tmp[4200];
+  int version = CKPT_VERSION, present, k, bad;
+  FILE *fp;
+
+  snprintf(tmp, sizeof(tmp), "%s.%d", ck->path, (int)getpid());
+  if ((fp = fopen(tmp, "w")) == NULL) {
+    fprintf(stderr, "CAN'T WRITE CHECKPOINT FILE: %s\n", tmp);
+    return -1;
+  }
+  fwrite(CKPT_MAGIC, 1, 8, fp);
+  fwrite(&version, sizeof(int), 1, fp);
+  fwrite(&ck->key, sizeof(struct cache_key), 1, fp);
+  fwrite(&ck->n_threads, sizeof(int), 1, fp);
+  fwrite(&ck->n_cubes, sizeof(int), 1, fp);
+  for (k=0;k<ck->n_threads;k++) {
+    present = (ck->slot[k] != NULL);
+    fwrite(&present, sizeof(int), 1, fp);
+    if (present)
+      fwrite(ck->slot[k], 1, ck->slot_len[k], fp);
+  }
+  bad = (fflush(fp) != 0) || ferror(fp) || fsync(fileno(fp));
+  bad |= fclose(fp);
+  if (bad || rename(tmp, ck->path)) {
+    fprintf(stderr, "FAILED WRITING CHECKPOINT FILE: %s\n", ck->path);
+    unlink(tmp);
+    return -1;
+  }
+  return 0;
+} //----- checkpoint_write (struct checkpoint *ck) -----//
+
+
+void checkpoint_due (struct scan_state *st, long long offset) {
+/*****************************************************************
+ *  Called by scan_range() at an entry boundary when the countdown
+ *  runs out; offset is where the next entry starts
+ *****************************************************************/
+  struct checkpoint *ck = st->ckpt;
+  double t = now_sec();
+
+  st->ckpt_countdown = CKPT_RECORDS;
+  if (t - ck->last[st->ckpt_slot] < ck->interval)
+    return;
+  ck->last[st->ckpt_slot] = t;
+  snapshot(st, offset, 0);
+  pthread_mutex_lock(&ck->lock);
+  checkpoint_write(ck);
+  pthread_mutex_unlock(&ck->lock);
+}
+
+void checkpoint_done (struct scan_state *st) {
+  struct checkpoint *ck = st->ckpt;
+
+  snapshot(st, st->end, 1);
+  pthread_mutex_lock(&ck->lock);
+  checkpoint_write(ck);
+  pthread_mutex_unlock(&ck->lock);
+}
+
+
+int checkpoint_load (struct checkpoint *ck, struct scan_state *st) {
+/*****************************************************************
+ *
+ *  Restore st[0..n_threads-1] from the checkpoint file: start,
+ *  counters and cubes of every range that has a snapshot.  -1 if
+ *  the file is missing, damaged, or from another file, rule set,
+ *  cube list or thread count; st is untouched then.
+ *
+ *****************************************************************/
+  char magic[8];
+  struct cache_key saved;
+  struct ckpt_counts *c;
+  struct crosstab **xt;
+  int version, n_threads, n_cubes, *present, k, j, bad = 0;
+  FILE *fp;
+
+  if ((fp = fopen(ck->path, "r")) == NULL) {
+    perror("CAN'T OPEN CHECKPOINT FILE\ncause");
+    return -1;
+  }
+  if ((fread(magic, 1, 8, fp) != 8) || memcmp(magic, CKPT_MAGIC, 8) ||
+      (fread(&version, sizeof(int), 1, fp) != 1) || (version != CKPT_VERSION) ||
+      (fread(&saved, sizeof(saved), 1, fp) != 1) ||
+      (fread(&n_threads, sizeof(int), 1, fp) != 1) ||
+      (fread(&n_cubes, sizeof(int), 1, fp) != 1)) {
+    fprintf(stderr, "NOT A CHECKPOINT FILE: %s\n", ck->path);
+    fclose(fp);
+    return -1;
+  }
+  if (memcmp(&saved, &ck->key, sizeof(saved)) || (n_cubes != ck->n_cubes)) {
+    fprintf(stderr, "CHECKPOINT %s IS FOR ANOTHER FILE, RULE SET OR -x LIST\n", ck->path);
+    fclose(fp);
+    return -1;
+  }
+  if (n_threads != ck->n_threads) {
+    fprintf(stderr, "CHECKPOINT %s WAS TAKEN WITH -j %d\n", ck->path, n_threads);
+    fclose(fp);
+    return -1;
+  }
+
+  present = calloc(n_threads, sizeof(int));
+  c = calloc(n_threads, sizeof(struct ckpt_counts));
+  xt = calloc(n_threads * n_cubes, sizeof(struct crosstab *));
+  for (k=0;(!bad)&&(k<n_threads);k++) {
+    bad = (fread(&present[k], sizeof(int), 1, fp) != 1);
+    if (bad || !present[k])
+      continue;
+    bad = (fread(&c[k], sizeof(struct ckpt_counts), 1, fp) != 1);
+    for (j=0;(!bad)&&(j<n_cubes);j++)
+      bad = ((xt[k*n_cubes+j] = crosstab_read(fp)) == NULL);
+  }
+  fclose(fp);
+  if (bad) {
+    fprintf(stderr, "DAMAGED CHECKPOINT FILE: %s\n", ck->path);
+    for (k=0;k<n_threads*n_cubes;k++)
+      crosstab_free(xt[k]);
+  }
+  else {
+    for (k=0;k<n_threads;k++) {
+      if (!present[k])
+        continue;
+      st[k].start = c[k].done ? st[k].end : c[k].offset;
+      st[k].tot_proteins = c[k].tot_proteins;
+      st[k].line_num = c[k].line_num;
+      st[k].char_count = c[k].char_count;
+      st[k].max_line = c[k].max_line;
+      st[k].max_prot_lines = c[k].max_prot_lines;
+      st[k].max_prot_chars = c[k].max_prot_chars;
+      st[k].corrupt_infile = c[k].corrupt_infile;
+      for (j=0;j<n_cubes;j++) {
+        crosstab_free(st[k].cubes[j]);
+        st[k].cubes[j] = xt[k*n_cubes+j];
+      }
+      /*  keep the slot, in case this run is stopped before the next one  */
+      snapshot(&st[k], c[k].done ? st[k].end : c[k].offset, (int)c[k].done);
+    }
+  }
+  free(present);
+  free(c);
+  free(xt);
+  return bad ? -1 : 0;
+} //----- checkpoint_load (struct checkpoint *ck, struct scan_state *st) -----//
+
+
+void checkpoint_free (struct checkpoint *ck, int remove_file) {
+  int k;
+
+  if (ck == NULL)
+    return;
+  if (remove_file)
+    unlink(ck->path);
+  for (k=0;k<ck->n_threads;k++)
+    free(ck->slot[k]);
+  free(ck->slot);
+  free(ck->slot_len);
+  free(ck->last);
+  pthread_mutex_destroy(&ck->lock);
+  free(ck);
+}
@@ -0,0 +1,372 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <regex.h>
+#include <sys/types.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  CLASSIFY -- the rules and what one line of an entry says
+ *
+ *  compile_rules() builds a reader's own copy of the patterns of
+ *  terms.c, and classify_line() applies them to each line of an
+ *  entry in turn until classify_end() at its // line.  scan_range()
+ *  and the entry views of libpromog.c share these, so they cannot
+ *  classify a protein differently.
+ *
+ *********************************************************************/
+
+static const char *BRAIN_REGEX = "TISSUE=Brain";
+static const char *MUSCLE_REGEX = "TISSUE=Muscle";
+
+static int compile_one (regex_t *rgx, const char *raw) {
+  if (regcomp(rgx, raw, REG_EXTENDED|REG_NOSUB)) {
+    fprintf(stderr, "Could not compile regex for %s\n", raw);
+    return -1;
+  }
+  return 0;
+}
+
+int compile_rules (struct promog_rules *rules) {
+/*****************************************************************
+ *  REGular EXpression COMPilations; -1 if any fails
+ *****************************************************************/
+  int i;
+
+  rules->seq = 0;
+  for (i=0;i<REGEX_COUNT;i++)
+    if (compile_one(&rules->rgx_array[i], REGEX_RAW_ARRAY[i]))
+      return -1;
+  for (i=0;i<GO_COUNT;i++)
+    if (compile_one(&rules->rgx_GO_array[i], GO_RAW_REGEX_ARRAY[i]))
+      return -1;
+  for (i=0;i<GO_MINOR_COUNT;i++)
+    if (compile_one(&rules->rgx_GO_minor_array[i], GO_RAW_REGEX_MINOR_ARRAY[i]))
+      return -1;
+  if (compile_one(&rules->rgx_brain, BRAIN_REGEX))
+    return -1;
+  if (compile_one(&rules->rgx_muscle, MUSCLE_REGEX))
+    return -1;
+  return 0;
+} //----- compile_rules (struct promog_rules *rules) -----//
+
+
+void free_rules (struct promog_rules *rules) {
+  int i;
+
+  for (i=0;i<REGEX_COUNT;i++)
+    regfree(&rules->rgx_array[i]);
+  for (i=0;i<GO_COUNT;i++)
+    regfree(&rules->rgx_GO_array[i]);
+  for (i=0;i<GO_MINOR_COUNT;i++)
+    regfree(&rules->rgx_GO_minor_array[i]);
+  regfree(&rules->rgx_brain);
+  regfree(&rules->rgx_muscle);
+}
+
+
+static unsigned long long hash_strings (unsigned long long h, const char **s, int n) {
+  const unsigned char *p;
+  int i;
+
+  for (i=0;i<n;i++) {
+    for (p = (const unsigned char *)s[i]; *p; p++)
+      h = (h ^ *p) * 1099511628211ULL;
+    h = (h ^ 0xff) * 1099511628211ULL;       /* separator */
+  }
+  return h;
+}
+
+unsigned long long rules_hash (void) {
+/*****************************************************************
+ *
+ *  FNV-1a over every pattern and term name the scan and its
+ *  measures depend on.  Any edit to the term tables changes it,
+ *  which is what invalidates saved results.
+ *
+ *****************************************************************/
+  unsigned long long h = 14695981039346656037ULL;
+
+  h = hash_strings(h, REGEX_RAW_ARRAY, REGEX_COUNT);
+  h = hash_strings(h, NAMES_ARRAY, REGEX_COUNT);
+  h = hash_strings(h, GO_RAW_REGEX_ARRAY, GO_COUNT);
+  h = hash_strings(h, GO_NAMES_ARRAY, GO_COUNT);
+  h = hash_strings(h, GO_RAW_REGEX_MINOR_ARRAY, GO_MINOR_COUNT);
+  h = hash_strings(h, GO_NAMES_MINOR_ARRAY, GO_MINOR_COUNT);
+  h = hash_strings(h, FT_NAMES_ARRAY, FT_COUNT);
+  h = hash_strings(h, COMP_NAMES_ARRAY, COMP_COUNT);
+  h = hash_strings(h, &BRAIN_REGEX, 1);
+  h = hash_strings(h, &MUSCLE_REGEX, 1);
+  return (h ^ MEASURE_COUNT) * 1099511628211ULL;
+}
+
+
+void classify_line (struct prot_record *rec, const struct promog_rules *rules,
+                    const char *p, int b, char *line, struct metrics *met) {
+/*****************************************************************
+ *
+ *  Everything one line of an entry tells about the protein.  p is
+ *  the line and b its length, p[b] its newline; line is scratch
+ *  of at least b+2 bytes for regexec().  Short lines are never
+ *  read past their newline.  scan_range() calls this for every
+ *  line and libpromog.c for every line of an entry view.
+ *
+ *****************************************************************/
+  const int  FALSE   = 0;
+  const int  TRUE =  1;
+  unsigned long long t;
+  int i;
+
+  if ((p[0] == 'R')&&(p[1] == 'C')) {
+  /*****************************************************************
+   *
+   *  Reference Comment (RC) line
+   *
+   *  http://ca.expasy.org/sprot/userman.html#RC_line
+   *
+   *****************************************************************/
+    for(i=0;i<b+1;i++)
+      line[i] = p[i];
+    line[i] = '\0';
+    t = metrics_ticks();
+    if (!(regexec(&rules->rgx_muscle, line, (size_t)0,NULL,0)))
+      rec->is_muscle = TRUE;
+    if (!(regexec(&rules->rgx_brain, line, (size_t)0,NULL,0)))
+      rec->is_brain = TRUE;
+    met->ph[MX_MATCH].ticks += metrics_ticks() - t;
+    met->ph[MX_MATCH].lines++;
+    add_tissues(rec, line, b);
+    for(i=0;i<b+2;i++)
+      line[i] = '\0';
+  }//---if ((p[0] == 'R')&&(p[1] == 'C'))---//
+
+  if ((p[0] == 'A')&&(p[1] == 'C')&&(rec->accession[0] == '\0')) {
+  /*****************************************************************
+   *
+   *  ACcession number (AC) line: keep the primary accession
+   *
+   *  http://ca.expasy.org/sprot/userman.html#AC_line
+   *
+   *****************************************************************/
+    for(i=0;(i<ACC_WIDTH)&&(5+i<b)&&(p[5+i] != ';');i++)
+      rec->accession[i] = p[5+i];
+    rec->accession[i] = '\0';
+  }
+
+  if ((p[0] == 'O')&&(p[1] == 'X')&&(b > 16)&&(p[5] == 'N')) {
+  /*****************************************************************
+   *
+   *  Organism taXonomy cross-reference (OX) line
+   *
+   *    OX   NCBI_TaxID=9606;
+   *
+   *****************************************************************/
+    rec->taxid = 0;
+    for(i=16;(i<b)&&(p[i] >= '0')&&(p[i] <= '9');i++)
+      rec->taxid = 10*rec->taxid + (p[i] - '0');
+  }
+
+  if ((p[0] == 'P')&&(p[1] == 'E')&&(b > 5)) {
+  /*****************************************************************
+   *
+   *  Protein Existence (PE) line
+   *
+   *    PE   1: Evidence at protein level;
+   *
+   *****************************************************************/
+    if ((p[5] >= '1')&&(p[5] <= '5'))
+      rec->evidence = p[5] - '0';
+  }
+
+  if ((p[0] == 'K')&&(p[1] == 'W')) {
+  /*****************************************************************
+   *
+   *  KeyWord (KW) line
+   *
+   *  http://ca.expasy.org/sprot/userman.html#KW_line
+   *
+   *****************************************************************/
+    add_keywords(rec, p, b);
+  }
+
+  if ((p[0] == 'O')&&(p[1] == 'S')&&(b > 10)) {
+  /*****************************************************************
+   *
+   *  Organism Species (OS) line
+   *
+   *  http://ca.expasy.org/sprot/userman.html#OS_line
+   *
+   *****************************************************************/
+    if ((p[5] == 'H')&&(p[7] == 'm')&&(p[10] == 's'))
+      rec->is_human = TRUE;          /* Homo sapiens */
+    if (rec->organism[0] == '\0') {
+      /*  species name up to the common name or the final period  */
+      for(i=0;(i<ORGANISM_LEN-1)&&(5+i<b);i++) {
+        if ((p[5+i] == '.')||((p[5+i] == ' ')&&(p[6+i] == '(')))
+          break;
+        rec->organism[i] = p[5+i];
+      }
+      rec->organism[i] = '\0';
+    }
+  }
+
+  if ((p[0] == 'F')&&(p[1] == 'T')&&(b > 12)) {
+  /*****************************************************************
+   *
+   *  Feature Table (FT) line
+   *
+   *  http://www.expasy.org/sprot/userman.html#FT_line
+   *
+   *****************************************************************/
+    if ((p[5] == 'T') && (p[6] == 'R') && (p[7] == 'A') && (p[8] == 'N') &&
+        (p[9] == 'S') && (p[10] == 'M') && (p[11] == 'E') && (p[12] == 'M')) {
+      rec->is_FT_TRANSMEM = TRUE;
+      rec->is_REMAINDER = FALSE;
+    } //--- if FT  TRANSMEM ----//
+
+    if ((p[5] == 'L') && (p[6] == 'I') && (p[7] == 'P') && (p[8] == 'I') &&
+        (p[9] == 'D')) {
+      rec->is_FT_LIPID= TRUE;
+      rec->is_REMAINDER = FALSE;
+    } //--- if FT LIPID ----//
+
+    if ((p[5] == 'I') && (p[6] == 'N') && (p[7] == 'T') && (p[8] == 'R') &&
+        (p[9] == 'A') && (p[10] == 'M') && (p[11] == 'E') && (p[12] == 'M')) {
+      rec->is_FT_INTRAMEM = TRUE;
+      rec->is_REMAINDER = FALSE;
+    } //--- if FT  INTRAMEM ----//
+
+    if ((p[5] == 'S') && (p[6] == 'I') && (p[7] == 'G') && (p[8] == 'N') &&
+        (p[9] == 'A') && (p[10] == 'L')) {
+      rec->has_FT_SIGNAL = TRUE;
+      rec->is_REMAINDER = FALSE;
+    } //--- if FT  SIGNAL ----//
+
+    if ((p[5] == 'D') && (p[6] == 'N') && (p[7] == 'A') && (p[8] == '_') &&
+        (p[9] == 'B') && (p[10] == 'I') && (p[11] == 'N') && (p[12] == 'D')) {
+      rec->has_FT_DNA_BIND = TRUE;
+      rec->is_REMAINDER = FALSE;
+    } //--- if FT  DNA_BIND----//
+  } //---if ((p[0] == 'F')&&(p[1] == 'T')) {
+
+  if ((p[0] == 'C')&&(p[1] == 'C')) {
+  /*****************************************************************
+   *
+   *  Comment Block (CC) line
+   *
+   *  http://www.expasy.org/sprot/userman.html#CC_line
+   *
+   *****************************************************************/
+    if ((b > 28) && (p[5] == '-') && (p[6] == '!') && (p[7] == '-') &&
+        (p[9] == 'S') && (p[10] == 'U') && (p[11] == 'B') && (p[12] == 'C') &&
+        (p[13] == 'E') && (p[14] == 'L') && (p[15] == 'L') && (p[16] == 'U') &&
+        (p[17] == 'L') && (p[18] == 'A') && (p[19] == 'R') && (p[21] == 'L') &&
+        (p[22] == 'O') && (p[23] == 'C') && (p[24] == 'A') && (p[25] == 'T') &&
+        (p[26] == 'I') && (p[27] == 'O') && (p[28] == 'N')) {
+      /*  CC   -!- SUBCELLULAR LOCATION  */
+      rec->has_SCL = TRUE;
+      rec->in_SCL = TRUE;
+    }
+    else if ((b > 7) && (p[5] == '-') && ((p[6] == '!') || (p[6] == '-')) &&
+             (p[7] == '-'))
+      rec->in_SCL = FALSE;           /* the next topic, or the copyright */
+
+    if (rec->in_SCL) {
+      for(i=0;i<b+1;i++)
+        line[i] = p[i];
+      line[i] = '\0';
+      t = metrics_ticks();
+      for(i=0;i<REGEX_COUNT;i++) {
+        if (!(regexec(&rules->rgx_array[i], line, (size_t)0,NULL,0))) {
+          rec->is_SCL_ARRAY[i] = TRUE;
+          rec->is_REMAINDER = FALSE;
+        }
+      }
+      met->ph[MX_MATCH].ticks += metrics_ticks() - t;
+      met->ph[MX_MATCH].lines++;
+    }
+  } //---if ((p[0] == 'C')&&(p[1] == 'C')) {
+
+  if ((p[0] == 'D')&&(p[1] == 'R')&&(b > 6)&&(p[5] == 'G')&&(p[6] == 'O')) {
+  /*****************************************************************
+   *
+   *  DR   GO; Gene Ontology cross-reference
+   *
+   *****************************************************************/
+    for(i=0;i<b+1;i++)
+      line[i] = p[i];
+    line[i] = '\0';
+    t = metrics_ticks();
+    for(i=0;i<GO_COUNT;i++) {
+      if (!(regexec(&rules->rgx_GO_array[i], line, (size_t)0,NULL,0))) {
+        rec->has_GO_ARRAY[i] = TRUE;
+        rec->is_REMAINDER = FALSE;
+        rec->is_GO_REMAINDER = FALSE;
+      }
+    }
+    for(i=0;i<GO_MINOR_COUNT;i++) {
+      if (!(regexec(&rules->rgx_GO_minor_array[i], line, (size_t)0,NULL,0))) {
+        rec->has_GO_MINOR_ARRAY[i] = TRUE;
+        rec->is_REMAINDER = FALSE;
+        rec->is_GO_REMAINDER = FALSE;
+      }
+    }
+    met->ph[MX_MATCH].ticks += metrics_ticks() - t;
+    met->ph[MX_MATCH].lines++;
+  } //--- DR   GO ---//
+
+  if ((rules->seq)&&(p[0] == 'S')&&(p[1] == 'Q')) {
+  /*****************************************************************
+   *
+   *  SeQuence header (SQ) line, and the residue lines after it,
+   *  only for the sequence stages (seq.c)
+   *
+   *  http://www.expasy.org/sprot/userman.html#SQ_line
+   *
+   *****************************************************************/
+    seq_begin(rec, p, b, rules->seq);
+  }
+  else if ((rec->in_SQ)&&(p[0] == ' '))
+    seq_line(rec, p, b);
+} //----- classify_line -----//
+
+
+void classify_end (struct prot_record *rec) {
+/*****************************************************************
+ *  At the // line: what follows from the whole entry
+ *****************************************************************/
+  const int  FALSE   = 0;
+
+  rec->compartments = compartment_mask(rec);
+  if (!rec->has_SCL)
+    rec->is_REMAINDER = FALSE;
+  if (rec->in_SQ)
+    seq_end(rec);
+}
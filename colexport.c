@@ -0,0 +1,483 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  COLEXPORT -- per-protein classifications as a columnar file
+ *
+ *  promog -e <file> streams every entry into row groups of at most
+ *  CF_GROUP_ROWS rows; only the group being filled is held in
+ *  memory.  All integers are little endian, whatever the host.
+ *
+ *    "PROMOGCF"  int32 version  int32 n_columns
+ *    per column: int32 type  int32 width  int32 name_len  name
+ *    row groups
+ *    footer:     int64 n_groups, per group int64 offset int64 n_rows
+ *    tail:       int64 footer offset  "PROMOGCF"
+ *
+ *  A row group is int32 n_rows followed, for each column, by an
+ *  int64 byte length and the column's payload:
+ *
+ *    CF_FIXED  n_rows * width bytes, NUL padded (accession)
+ *    CF_BITS   int32 w, n_rows values of w bits (taxon, the
+ *              compartment mask, one 1-bit column per feature
+ *              and per SCL and GO term)
+ *    CF_DICT   dictionary, then int32 w and n_rows ids of w bits
+ *              (organism)
+ *    CF_LIST   dictionary, int32 w, n_rows+1 offsets of w bits,
+ *              int32 w, the ids of w bits (tissues)
+ *
+ *  A dictionary is int32 n then n times int32 len and the bytes;
+ *  it only covers its own row group.  Packed values are stored
+ *  least significant bit first and padded to a whole byte.
+ *
+ *********************************************************************/
+
+#define CF_MAGIC        "PROMOGCF"
+#define CF_VERSION      1
+#define CF_GROUP_ROWS   65536
+#define CF_FIXED        0
+#define CF_BITS         1
+#define CF_DICT         2
+#define CF_LIST         3
+#define CF_COLUMNS      (5 + FT_COUNT + REGEX_COUNT + GO_COUNT + GO_MINOR_COUNT)
+
+struct cf_dict {
+  int n, cap;
+  char **s;                     /* in text, until the row group is written */
+  int *hash, hash_cap;          /* -1 is empty */
+  struct arena text;
+};
+
+struct colx {
+  FILE *fp;
+  int scratch;                  /* no schema or footer: for colx_append() */
+  long long pos;                /* bytes written to fp */
+  int n_groups, cap_groups;
+  long long *group_off, *group_rows;
+  long long n_records;
+
+  /*  the row group being filled  */
+  int n_rows;
+  char *acc;                    /* ACC_WIDTH per row */
+  unsigned int *taxid, *org, *comp;
+  unsigned char *ft, *scl, *go; /* one byte per term per row */
+  int *tis_off, n_tis, cap_tis;
+  unsigned int *tis;
+  struct cf_dict org_dict, tis_dict;
+  unsigned int *scratch_vals;   /* CF_GROUP_ROWS+1 */
+};
+
+
+static void cf_write (struct colx *cx, const void *p, size_t len) {
+  fwrite(p, 1, len, cx->fp);
+  cx->pos += len;
+}
+
+static void cf_int32 (struct colx *cx, int v) {
+  unsigned char b[4];
+  int i;
+
+  for (i=0;i<4;i++)
+    b[i] = ((unsigned int)v >> 8*i) & 0xff;
+  cf_write(cx, b, 4);
+}
+
+static void cf_int64 (struct colx *cx, long long v) {
+  unsigned char b[8];
+  int i;
+
+  for (i=0;i<8;i++)
+    b[i] = ((unsigned long long)v >> 8*i) & 0xff;
+  cf_write(cx, b, 8);
+}
+
+static int cf_width (unsigned int max) {
+  int w = 1;
+
+  while ((w < 32) && (max >> w))
+    w++;
+  return w;
+}
+
+static long long cf_packed_len (long long n, int w) {
+  return (n*w + 7) / 8;
+}
+
+static void cf_pack (struct colx *cx, const unsigned int *v, long long n, int w) {
+/*****************************************************************
+ *  n values of w bits, least significant first
+ *****************************************************************/
+  unsigned char out[4096];
+  unsigned long long acc = 0;
+  int bits = 0, o = 0;
+  long long i;
+
+  for (i=0;i<n;i++) {
+    acc |= (unsigned long long)v[i] << bits;
+    bits += w;
+    while (bits >= 8) {
+      out[o++] = acc & 0xff;
+      acc >>= 8;
+      bits -= 8;
+      if (o == sizeof(out)) {
+        cf_write(cx, out, o);
+        o = 0;
+      }
+    }
+  }
+  if (bits)
+    out[o++] = acc & 0xff;
+  cf_write(cx, out, o);
+}
+
+
+static unsigned int cf_hash (const char *s) {
+  unsigned int h = 2166136261u;
+
+  while (*s)
+    h = (h ^ (unsigned char)*s++) * 16777619u;
+  return h;
+}
+
+static unsigned int cf_intern (struct cf_dict *d, const char *s) {
+  int i, slot;
+
+  if (2*(d->n+1) > d->hash_cap) {
+    free(d->hash);
+    d->hash_cap = d->hash_cap ? 2*d->hash_cap : 256;
+    d->hash = malloc(d->hash_cap*sizeof(int));
+    for (i=0;i<d->hash_cap;i++)
+      d->hash[i] = -1;
+    for (i=0;i<d->n;i++) {
+      slot = cf_hash(d->s[i]) & (d->hash_cap - 1);
+      while (d->hash[slot] >= 0)
+        slot = (slot + 1) & (d->hash_cap - 1);
+      d->hash[slot] = i;
+    }
+  }
+  slot = cf_hash(s) & (d->hash_cap - 1);
+  while (d->hash[slot] >= 0) {
+    if (!strcmp(d->s[d->hash[slot]], s))
+      return d->hash[slot];
+    slot = (slot + 1) & (d->hash_cap - 1);
+  }
+  if (d->n == d->cap) {
+    d->cap = d->cap ? 2*d->cap : 64;
+    d->s = realloc(d->s, d->cap*sizeof(char *));
+  }
+  d->s[d->n] = arena_strndup(&d->text, s, strlen(s));
+  d->hash[slot] = d->n;
+  return d->n++;
+}
+
+static void cf_dict_clear (struct cf_dict *d) {
+  int i;
+
+  arena_reset(&d->text);
+  d->n = 0;
+  for (i=0;i<d->hash_cap;i++)
+    d->hash[i] = -1;
+}
+
+static long long cf_dict_len (const struct cf_dict *d) {
+  long long len = sizeof(int);
+  int i;
+
+  for (i=0;i<d->n;i++)
+    len += sizeof(int) + strlen(d->s[i]);
+  return len;
+}
+
+static void cf_dict_write (struct colx *cx, const struct cf_dict *d) {
+  int i, len;
+
+  cf_int32(cx, d->n);
+  for (i=0;i<d->n;i++) {
+    len = strlen(d->s[i]);
+    cf_int32(cx, len);
+    cf_write(cx, d->s[i], len);
+  }
+}
+
+
+static void cf_bits_column (struct colx *cx, const unsigned int *v, int n) {
+  unsigned int max = 0;
+  int i, w;
+
+  for (i=0;i<n;i++)
+    if (v[i] > max)
+      max = v[i];
+  w = cf_width(max);
+  cf_int64(cx, sizeof(int) + cf_packed_len(n, w));
+  cf_int32(cx, w);
+  cf_pack(cx, v, n, w);
+}
+
+static void cf_flag_column (struct colx *cx, const unsigned char *flags, int stride, int n) {
+  unsigned int *v = cx->scratch_vals;
+  int i;
+
+  for (i=0;i<n;i++)
+    v[i] = flags[i*stride];
+  cf_int64(cx, sizeof(int) + cf_packed_len(n, 1));
+  cf_int32(cx, 1);
+  cf_pack(cx, v, n, 1);
+}
+
+static void cf_flush_group (struct colx *cx) {
+/*****************************************************************
+ *  Encode the row group being filled and start an empty one
+ *****************************************************************/
+  unsigned int *v = cx->scratch_vals, max;
+  int i, n = cx->n_rows, w, wi;
+
+  if (n == 0)
+    return;
+  if (cx->n_groups == cx->cap_groups) {
+    cx->cap_groups = cx->cap_groups ? 2*cx->cap_groups : 16;
+    cx->group_off = realloc(cx->group_off, cx->cap_groups*sizeof(long long));
+    cx->group_rows = realloc(cx->group_rows, cx->cap_groups*sizeof(long long));
+  }
+  cx->group_off[cx->n_groups] = cx->pos;
+  cx->group_rows[cx->n_groups++] = n;
+  cf_int32(cx, n);
+
+  cf_int64(cx, (long long)n*ACC_WIDTH);
+  cf_write(cx, cx->acc, (size_t)n*ACC_WIDTH);
+  cf_bits_column(cx, cx->taxid, n);
+
+  w = cf_width(cx->org_dict.n);
+  cf_int64(cx, cf_dict_len(&cx->org_dict) + sizeof(int) + cf_packed_len(n, w));
+  cf_dict_write(cx, &cx->org_dict);
+  cf_int32(cx, w);
+  cf_pack(cx, cx->org, n, w);
+
+  for (i=0;i<=n;i++)
+    v[i] = cx->tis_off[i];
+  w = cf_width(cx->n_tis);
+  for (max=0, i=0;i<cx->n_tis;i++)
+    if (cx->tis[i] > max)
+      max = cx->tis[i];
+  wi = cf_width(max);
+  cf_int64(cx, cf_dict_len(&cx->tis_dict) + sizeof(int) + cf_packed_len(n+1, w)
+               + sizeof(int) + cf_packed_len(cx->n_tis, wi));
+  cf_dict_write(cx, &cx->tis_dict);
+  cf_int32(cx, w);
+  cf_pack(cx, v, n+1, w);
+  cf_int32(cx, wi);
+  cf_pack(cx, cx->tis, cx->n_tis, wi);
+
+  cf_bits_column(cx, cx->comp, n);
+  for (i=0;i<FT_COUNT;i++)
+    cf_flag_column(cx, cx->ft + i, FT_COUNT, n);
+  for (i=0;i<REGEX_COUNT;i++)
+    cf_flag_column(cx, cx->scl + i, REGEX_COUNT, n);
+  for (i=0;i<GO_COUNT+GO_MINOR_COUNT;i++)
+    cf_flag_column(cx, cx->go + i, GO_COUNT+GO_MINOR_COUNT, n);
+
+  cx->n_rows = 0;
+  cx->n_tis = 0;
+  cf_dict_clear(&cx->org_dict);
+  cf_dict_clear(&cx->tis_dict);
+} //----- cf_flush_group (struct colx *cx) -----//
+
+
+static void cf_schema_column (struct colx *cx, int type, int width, const char *prefix,
+                              const char *name) {
+  char full[128];
+
+  snprintf(full, sizeof(full), "%s%s", prefix, name);
+  cf_int32(cx, type);
+  cf_int32(cx, width);
+  cf_int32(cx, strlen(full));
+  cf_write(cx, full, strlen(full));
+}
+
+struct colx * colx_new (const char *path) {
+/*****************************************************************
+ *  path NULL: row groups only, into a scratch file for
+ *  colx_append()
+ *****************************************************************/
+  struct colx *cx = calloc(1, sizeof(struct colx));
+  int i;
+
+  if (path == NULL) {
+    cx->fp = tmpfile();
+    cx->scratch = 1;
+  }
+  else
+    cx->fp = fopen(path, "w");
+  if (cx->fp == NULL) {
+    fprintf(stderr, "CAN'T OPEN EXPORT FILE: %s\n", path ? path : "(scratch)");
+    free(cx);
+    return NULL;
+  }
+  setvbuf(cx->fp, NULL, _IOFBF, 1<<20);
+  cx->acc = malloc(CF_GROUP_ROWS*ACC_WIDTH);
+  cx->taxid = malloc(CF_GROUP_ROWS*sizeof(unsigned int));
+  cx->org = malloc(CF_GROUP_ROWS*sizeof(unsigned int));
+  cx->comp = malloc(CF_GROUP_ROWS*sizeof(unsigned int));
+  cx->ft = malloc(CF_GROUP_ROWS*FT_COUNT);
+  cx->scl = malloc(CF_GROUP_ROWS*REGEX_COUNT);
+  cx->go = malloc(CF_GROUP_ROWS*(GO_COUNT+GO_MINOR_COUNT));
+  cx->tis_off = malloc((CF_GROUP_ROWS+1)*sizeof(int));
+  cx->scratch_vals = malloc((CF_GROUP_ROWS+1)*sizeof(unsigned int));
+  cx->tis_off[0] = 0;
+
+  if (!cx->scratch) {
+    cf_write(cx, CF_MAGIC, 8);
+    cf_int32(cx, CF_VERSION);
+    cf_int32(cx, CF_COLUMNS);
+    cf_schema_column(cx, CF_FIXED, ACC_WIDTH, "", "accession");
+    cf_schema_column(cx, CF_BITS, 0, "", "taxon");
+    cf_schema_column(cx, CF_DICT, 0, "", "organism");
+    cf_schema_column(cx, CF_LIST, 0, "", "tissues");
+    cf_schema_column(cx, CF_BITS, 0, "", "compartments");
+    for (i=0;i<FT_COUNT;i++)
+      cf_schema_column(cx, CF_BITS, 1, "ft:", FT_NAMES_ARRAY[i]);
+    for (i=0;i<REGEX_COUNT;i++)
+      cf_schema_column(cx, CF_BITS, 1, "scl:", NAMES_ARRAY[i]);
+    for (i=0;i<GO_COUNT;i++)
+      cf_schema_column(cx, CF_BITS, 1, "go:", GO_NAMES_ARRAY[i]);
+    for (i=0;i<GO_MINOR_COUNT;i++)
+      cf_schema_column(cx, CF_BITS, 1, "go:", GO_NAMES_MINOR_ARRAY[i]);
+  }
+  return cx;
+} //----- colx_new (const char *path) -----//
+
+
+void colx_add (struct colx *cx, const struct prot_record *rec) {
+  int i, n = cx->n_rows;
+  char acc[ACC_WIDTH+1];
+
+  memset(acc, 0, sizeof(acc));
+  memcpy(acc, rec->accession, strnlen(rec->accession, sizeof(acc) - 1));
+  memcpy(cx->acc + (size_t)n*ACC_WIDTH, acc, ACC_WIDTH);   /* NUL padded */
+  cx->taxid[n] = rec->taxid;
+  cx->org[n] = cf_intern(&cx->org_dict, rec->organism);
+  cx->comp[n] = rec->compartments;
+  if (cx->n_tis + MAX_TISSUES > cx->cap_tis) {
+    cx->cap_tis = cx->cap_tis ? 2*cx->cap_tis : 4*CF_GROUP_ROWS;
+    cx->tis = realloc(cx->tis, cx->cap_tis*sizeof(unsigned int));
+  }
+  for (i=0;i<rec->n_tissues;i++)
+    cx->tis[cx->n_tis++] = cf_intern(&cx->tis_dict, rec->tissues[i]);
+  cx->tis_off[n+1] = cx->n_tis;
+  for (i=0;i<FT_COUNT;i++)
+    cx->ft[n*FT_COUNT+i] = record_has_ft(rec, i) ? 1 : 0;
+  for (i=0;i<REGEX_COUNT;i++)
+    cx->scl[n*REGEX_COUNT+i] = rec->is_SCL_ARRAY[i] ? 1 : 0;
+  for (i=0;i<GO_COUNT;i++)
+    cx->go[n*(GO_COUNT+GO_MINOR_COUNT)+i] = rec->has_GO_ARRAY[i] ? 1 : 0;
+  for (i=0;i<GO_MINOR_COUNT;i++)
+    cx->go[n*(GO_COUNT+GO_MINOR_COUNT)+GO_COUNT+i] = rec->has_GO_MINOR_ARRAY[i] ? 1 : 0;
+  cx->n_records++;
+  if (++cx->n_rows == CF_GROUP_ROWS)
+    cf_flush_group(cx);
+} //----- colx_add (struct colx *cx, const struct prot_record *rec) -----//
+
+
+int colx_append (struct colx *dst, struct colx *src) {
+/*****************************************************************
+ *  Copy the row groups of a scratch export onto the end of dst
+ *****************************************************************/
+  char buf[1<<16];
+  long long base;
+  size_t n;
+  int i;
+
+  cf_flush_group(dst);
+  cf_flush_group(src);
+  fflush(src->fp);
+  rewind(src->fp);
+  base = dst->pos;
+  while ((n = fread(buf, 1, sizeof(buf), src->fp)) > 0)
+    cf_write(dst, buf, n);
+  for (i=0;i<src->n_groups;i++) {
+    if (dst->n_groups == dst->cap_groups) {
+      dst->cap_groups = dst->cap_groups ? 2*dst->cap_groups : 16;
+      dst->group_off = realloc(dst->group_off, dst->cap_groups*sizeof(long long));
+      dst->group_rows = realloc(dst->group_rows, dst->cap_groups*sizeof(long long));
+    }
+    dst->group_off[dst->n_groups] = base + src->group_off[i];
+    dst->group_rows[dst->n_groups++] = src->group_rows[i];
+  }
+  dst->n_records += src->n_records;
+  return ferror(src->fp) ? -1 : 0;
+}
+
+
+int colx_close (struct colx *cx) {
+/*****************************************************************
+ *  Last row group and the footer; frees cx.  -1 on write error.
+ *****************************************************************/
+  long long footer;
+  int i, status;
+
+  if (cx == NULL)
+    return 0;
+  if (!cx->scratch) {
+    cf_flush_group(cx);
+    footer = cx->pos;
+    cf_int64(cx, cx->n_groups);
+    for (i=0;i<cx->n_groups;i++) {
+      cf_int64(cx, cx->group_off[i]);
+      cf_int64(cx, cx->group_rows[i]);
+    }
+    cf_int64(cx, footer);
+    cf_write(cx, CF_MAGIC, 8);
+  }
+  status = (ferror(cx->fp) | fclose(cx->fp)) ? -1 : 0;
+  if (status)
+    fprintf(stderr, "FAILED WRITING EXPORT FILE\n");
+  arena_free(&cx->org_dict.text);
+  arena_free(&cx->tis_dict.text);
+  free(cx->org_dict.s);
+  free(cx->org_dict.hash);
+  free(cx->tis_dict.s);
+  free(cx->tis_dict.hash);
+  free(cx->acc);
+  free(cx->taxid);
+  free(cx->org);
+  free(cx->comp);
+  free(cx->ft);
+  free(cx->scl);
+  free(cx->go);
+  free(cx->tis_off);
+  free(cx->tis);
+  free(cx->scratch_vals);
+  free(cx->group_off);
+  free(cx->group_rows);
+  free(cx);
+  return status;
+} //----- colx_close (struct colx *cx) -----//
@@ -0,0 +1,698 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  CROSSTAB -- N-dimensional count cubes
+ *
+ *  A cube is named by a spec "key[,key...][:measure[,measure...]]",
+ *  e.g. "organism,evidence:compartment,ft".  Every protein adds its
+ *  measures (record_measures()) to the cell its key values select;
+ *  multi-valued keys (compartment, tissue, keyword) add it to one
+ *  cell per value.
+ *
+ *  When every key has a small fixed set of values (human, brain,
+ *  muscle, evidence, compartment) the cells are a dense array
+ *  indexed directly.  Otherwise value strings are interned per key
+ *  and cells live in an open addressing hash on the tuple of value
+ *  ids.
+ *
+ *  Scanning threads each fill their own cube from the same spec;
+ *  crosstab_merge() folds them together after the join.
+ *
+ *********************************************************************/
+
+#define XT_MAX_VALUES   (MAX_KEYWORDS > MAX_TISSUES ? MAX_KEYWORDS : MAX_TISSUES)
+#define XT_NONE         "(none)"
+
+static const char *XK_NAMES_ARRAY[XK_COUNT] = {"human", "brain", "muscle", "evidence",
+             "compartment", "organism", "taxon", "tissue", "keyword"};
+
+/*  values of the dense keys; 0 means hashed  */
+static const int XK_CARD_ARRAY[XK_COUNT] = {2, 2, 2, 6, 5, 0, 0, 0, 0};
+
+static const char *XK_LABELS_ARRAY[XK_COMPARTMENT+1][6] = {
+             {"nonhuman", "human"}, {"other", "brain"}, {"other", "muscle"},
+             {"0", "1", "2", "3", "4", "5"},
+             {"none", "nuclear", "cytosolic", "membrane", "extracellular"}};
+
+struct xt_strings {
+  int n, cap;
+  char **s;                   /* in text */
+  int *hash, hash_cap;        /* -1 is empty */
+  struct arena text;
+};
+
+struct crosstab {
+  char *spec;
+  int n_keys, keys[XT_MAX_KEYS];
+  int n_measures, measures[MEASURE_COUNT];
+  int column[MEASURE_COUNT];  /* measure -> column, -1 if not kept */
+  int dense;
+  struct xt_strings strings[XT_MAX_KEYS];
+  int n_rows, cap_rows;
+  int *row_vals;              /* n_keys value ids per row */
+  long long *counts;          /* n_measures per row */
+  int *hash, hash_cap;        /* hashed cubes: tuple -> row, -1 is empty */
+};
+
+
+static unsigned int xt_hash_bytes (const void *p, int len) {
+  const unsigned char *s = p;
+  unsigned int h = 2166136261u;
+
+  while (len--)
+    h = (h ^ *s++) * 16777619u;
+  return h;
+}
+
+static int xt_intern (struct xt_strings *t, const char *s) {
+/*****************************************************************
+ *  id of s among the values seen for one hashed key
+ *****************************************************************/
+  int i, slot;
+
+  if (t->hash_cap) {
+    slot = xt_hash_bytes(s, strlen(s)) & (t->hash_cap - 1);
+    while (t->hash[slot] >= 0) {
+      if (!strcmp(t->s[t->hash[slot]], s))
+        return t->hash[slot];
+      slot = (slot + 1) & (t->hash_cap - 1);
+    }
+  }
+  if (t->n == t->cap) {
+    t->cap = t->cap ? 2*t->cap : 64;
+    t->s = realloc(t->s, t->cap*sizeof(char *));
+  }
+  t->s[t->n] = arena_strndup(&t->text, s, strlen(s));
+  if (2*(t->n+1) > t->hash_cap) {
+    free(t->hash);
+    t->hash_cap = t->hash_cap ? 2*t->hash_cap : 256;
+    t->hash = malloc(t->hash_cap*sizeof(int));
+    for (i=0;i<t->hash_cap;i++)
+      t->hash[i] = -1;
+    for (i=0;i<t->n;i++) {
+      slot = xt_hash_bytes(t->s[i], strlen(t->s[i])) & (t->hash_cap - 1);
+      while (t->hash[slot] >= 0)
+        slot = (slot + 1) & (t->hash_cap - 1);
+      t->hash[slot] = i;
+    }
+  }
+  slot = xt_hash_bytes(s, strlen(s)) & (t->hash_cap - 1);
+  while (t->hash[slot] >= 0)
+    slot = (slot + 1) & (t->hash_cap - 1);
+  t->hash[slot] = t->n;
+  return t->n++;
+}
+
+static const char * xt_label (const struct crosstab *xt, int k, int v) {
+  int key = xt->keys[k];
+
+  if (XK_CARD_ARRAY[key])
+    return XK_LABELS_ARRAY[key][v];
+  return xt->strings[k].s[v];
+}
+
+static int xt_add_row (struct crosstab *xt, const int *vals) {
+  int row = xt->n_rows;
+
+  if (xt->n_rows == xt->cap_rows) {
+    xt->cap_rows = xt->cap_rows ? 2*xt->cap_rows : 64;
+    xt->row_vals = realloc(xt->row_vals, xt->cap_rows*XT_MAX_KEYS*sizeof(int));
+    xt->counts = realloc(xt->counts, xt->cap_rows*(xt->n_measures)*sizeof(long long));
+  }
+  memcpy(&xt->row_vals[row*XT_MAX_KEYS], vals, XT_MAX_KEYS*sizeof(int));
+  memset(&xt->counts[row*xt->n_measures], 0, xt->n_measures*sizeof(long long));
+  xt->n_rows++;
+  return row;
+}
+
+static int xt_row (struct crosstab *xt, const int *vals) {
+/*****************************************************************
+ *  Row of the cell selected by one tuple of key value ids
+ *****************************************************************/
+  int i, k, row, slot;
+
+  if (xt->dense) {
+    for (row=0, k=0;k<xt->n_keys;k++)
+      row = row*XK_CARD_ARRAY[xt->keys[k]] + vals[k];
+    return row;
+  }
+  slot = xt_hash_bytes(vals, XT_MAX_KEYS*sizeof(int)) & (xt->hash_cap - 1);
+  while ((row = xt->hash[slot]) >= 0) {
+    if (!memcmp(&xt->row_vals[row*XT_MAX_KEYS], vals, XT_MAX_KEYS*sizeof(int)))
+      return row;
+    slot = (slot + 1) & (xt->hash_cap - 1);
+  }
+  row = xt_add_row(xt, vals);
+  if (2*xt->n_rows > xt->hash_cap) {
+    free(xt->hash);
+    xt->hash_cap *= 2;
+    xt->hash = malloc(xt->hash_cap*sizeof(int));
+    for (i=0;i<xt->hash_cap;i++)
+      xt->hash[i] = -1;
+    for (i=0;i<xt->n_rows;i++) {
+      slot = xt_hash_bytes(&xt->row_vals[i*XT_MAX_KEYS], XT_MAX_KEYS*sizeof(int))
+             & (xt->hash_cap - 1);
+      while (xt->hash[slot] >= 0)
+        slot = (slot + 1) & (xt->hash_cap - 1);
+      xt->hash[slot] = i;
+    }
+  }
+  else
+    xt->hash[slot] = row;
+  return row;
+}
+
+static int xt_add_measures (struct crosstab *xt, const char *name) {
+/*****************************************************************
+ *  A measure group (all, compartment, ft, scl, go, annotation,
+ *  predicted; sequence, aa, length, nterm) or one measure by its
+ *  column name; returns 0 if unknown.  all is every measure of
+ *  the group report, so not the sequence statistics.
+ *****************************************************************/
+  char mname[128];
+  int m, lo = -1, hi = -1;
+
+  if (!strcmp(name, "all")) {
+    lo = 0;
+    hi = REPORT_MEASURES;
+  }
+  else if (!strcmp(name, "compartment")) {
+    lo = M_COMP;
+    hi = M_FT;
+  }
+  else if (!strcmp(name, "ft")) {
+    lo = M_FT;
+    hi = M_SCL_NULL;
+  }
+  else if (!strcmp(name, "annotation")) {
+    lo = M_SCL_NULL;
+    hi = M_SCL;
+  }
+  else if (!strcmp(name, "scl")) {
+    lo = M_SCL;
+    hi = M_GO;
+  }
+  else if (!strcmp(name, "go")) {
+    lo = M_GO;
+    hi = M_PREDICTED;
+  }
+  else if (!strcmp(name, "predicted")) {
+    lo = M_PREDICTED;
+    hi = M_RESIDUES;
+  }
+  else if (!strcmp(name, "sequence")) {
+    lo = M_RESIDUES;
+    hi = MEASURE_COUNT;
+  }
+  else if (!strcmp(name, "aa")) {
+    lo = M_AA;
+    hi = M_LEN;
+  }
+  else if (!strcmp(name, "length")) {
+    lo = M_LEN;
+    hi = M_NTERM;
+  }
+  else if (!strcmp(name, "nterm")) {
+    lo = M_NTERM;
+    hi = MEASURE_COUNT;
+  }
+  else {
+    for (m=0;m<MEASURE_COUNT;m++) {
+      measure_name(m, mname, sizeof(mname));
+      if (!strcmp(name, mname)) {
+        lo = m;
+        hi = m + 1;
+        break;
+      }
+    }
+  }
+  if (lo < 0)
+    return 0;
+  for (m=lo;m<hi;m++)
+    if (xt->column[m] < 0) {
+      xt->column[m] = xt->n_measures;
+      xt->measures[xt->n_measures++] = m;
+    }
+  return 1;
+}
+
+
+struct crosstab * crosstab_new (const char *spec) {
+  struct crosstab *xt = calloc(1, sizeof(struct crosstab));
+  char *copy = strdup(spec), *keys, *measures, *tok, *save;
+  int i, k, rows, vals[XT_MAX_KEYS], bad = 0;
+
+  xt->spec = strdup(spec);
+  for (i=0;i<MEASURE_COUNT;i++)
+    xt->column[i] = -1;
+  xt_add_measures(xt, "proteins");
+
+  keys = copy;
+  if ((measures = strchr(copy, ':')) != NULL)
+    *measures++ = '\0';
+  for (tok = strtok_r(keys, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+    for (k=0;k<XK_COUNT;k++)
+      if (!strcmp(tok, XK_NAMES_ARRAY[k]))
+        break;
+    if ((k == XK_COUNT) || (xt->n_keys == XT_MAX_KEYS)) {
+      fprintf(stderr, "crosstab %s: unknown or one too many key \"%s\"\n", spec, tok);
+      bad = 1;
+      break;
+    }
+    xt->keys[xt->n_keys++] = k;
+  }
+  if ((measures == NULL) || (*measures == '\0'))
+    xt_add_measures(xt, "compartment");
+  else
+    for (tok = strtok_r(measures, ",", &save); tok; tok = strtok_r(NULL, ",", &save))
+      if (!xt_add_measures(xt, tok)) {
+        fprintf(stderr, "crosstab %s: unknown measure \"%s\"\n", spec, tok);
+        bad = 1;
+      }
+  free(copy);
+  if (bad) {
+    crosstab_free(xt);
+    return NULL;
+  }
+
+  xt->dense = 1;
+  for (rows=1, k=0;k<xt->n_keys;k++) {
+    if (XK_CARD_ARRAY[xt->keys[k]] == 0)
+      xt->dense = 0;
+    rows *= XK_CARD_ARRAY[xt->keys[k]];
+  }
+  if (xt->dense) {
+    /*  every cell exists from the start, in row-major key order  */
+    memset(vals, 0, sizeof(vals));
+    for (i=0;i<rows;i++) {
+      xt_add_row(xt, vals);
+      for (k=xt->n_keys-1;k>=0;k--) {
+        if (++vals[k] < XK_CARD_ARRAY[xt->keys[k]])
+          break;
+        vals[k] = 0;
+      }
+    }
+  }
+  else {
+    xt->hash_cap = 1024;
+    xt->hash = malloc(xt->hash_cap*sizeof(int));
+    for (i=0;i<xt->hash_cap;i++)
+      xt->hash[i] = -1;
+  }
+  return xt;
+} //----- crosstab_new (const char *spec) -----//
+
+
+static int xt_values (struct crosstab *xt, int k, const struct prot_record *rec, int *vals) {
+/*****************************************************************
+ *  Value ids of key k for this protein; at least one.
+ *****************************************************************/
+  char taxon[16];
+  int i, n;
+
+  switch (xt->keys[k]) {
+    case XK_HUMAN:
+      vals[0] = rec->is_human ? 1 : 0;
+      return 1;
+    case XK_BRAIN:
+      vals[0] = rec->is_brain ? 1 : 0;
+      return 1;
+    case XK_MUSCLE:
+      vals[0] = rec->is_muscle ? 1 : 0;
+      return 1;
+    case XK_EVIDENCE:
+      vals[0] = ((rec->evidence >= 1) && (rec->evidence <= 5)) ? rec->evidence : 0;
+      return 1;
+    case XK_COMPARTMENT:
+      n = 0;
+      for (i=0;i<COMP_COUNT;i++)
+        if (rec->compartments & (1<<i))
+          vals[n++] = 1 + i;
+      if (n == 0)
+        vals[n++] = 0;
+      return n;
+    case XK_ORGANISM:
+      vals[0] = xt_intern(&xt->strings[k], rec->organism[0] ? rec->organism : XT_NONE);
+      return 1;
+    case XK_TAXON:
+      snprintf(taxon, sizeof(taxon), "%d", rec->taxid);
+      vals[0] = xt_intern(&xt->strings[k], rec->taxid ? taxon : XT_NONE);
+      return 1;
+    case XK_TISSUE:
+      for (i=0;i<rec->n_tissues;i++)
+        vals[i] = xt_intern(&xt->strings[k], rec->tissues[i]);
+      if (i)
+        return i;
+      break;
+    case XK_KEYWORD:
+      for (i=0;i<rec->n_keywords;i++)
+        vals[i] = xt_intern(&xt->strings[k], rec->keywords[i]);
+      if (i)
+        return i;
+      break;
+  } //--- switch (xt->keys[k]) ---//
+  vals[0] = xt_intern(&xt->strings[k], XT_NONE);
+  return 1;
+}
+
+
+void crosstab_add (struct crosstab *xt, const struct prot_record *rec,
+                   const int *m) {
+  int vals[XT_MAX_KEYS][XT_MAX_VALUES], n_vals[XT_MAX_KEYS], pick[XT_MAX_KEYS];
+  int tuple[XT_MAX_KEYS], j, k, row;
+  long long *cell;
+
+  for (k=0;k<xt->n_keys;k++) {
+    n_vals[k] = xt_values(xt, k, rec, vals[k]);
+    pick[k] = 0;
+  }
+  memset(tuple, 0, sizeof(tuple));
+  for (;;) {
+    for (k=0;k<xt->n_keys;k++)
+      tuple[k] = vals[k][pick[k]];
+    row = xt_row(xt, tuple);          /* may grow counts[] */
+    cell = &xt->counts[row*xt->n_measures];
+    for (j=0;j<xt->n_measures;j++)
+      cell[j] += m[xt->measures[j]];
+    /*  next combination of multi-valued key values  */
+    for (k=xt->n_keys-1;k>=0;k--) {
+      if (++pick[k] < n_vals[k])
+        break;
+      pick[k] = 0;
+    }
+    if (k < 0)
+      break;
+  }
+} //----- crosstab_add -----//
+
+
+void crosstab_merge (struct crosstab *dst, const struct crosstab *src) {
+/*****************************************************************
+ *  dst += src, for two cubes built from the same spec
+ *****************************************************************/
+  int tuple[XT_MAX_KEYS], i, j, k, row;
+  const int *vals;
+
+  for (i=0;i<src->n_rows;i++) {
+    vals = &src->row_vals[i*XT_MAX_KEYS];
+    memset(tuple, 0, sizeof(tuple));
+    for (k=0;k<src->n_keys;k++)
+      tuple[k] = src->dense ? vals[k] :
+          (XK_CARD_ARRAY[src->keys[k]] ? vals[k] :
+           xt_intern(&dst->strings[k], src->strings[k].s[vals[k]]));
+    row = xt_row(dst, tuple);
+    for (j=0;j<dst->n_measures;j++)
+      dst->counts[row*dst->n_measures+j] += src->counts[i*src->n_measures+j];
+  }
+} //----- crosstab_merge -----//
+
+
+long long crosstab_sum (const struct crosstab *xt, const int *match, int measure) {
+/*****************************************************************
+ *
+ *  Sum of one measure over the cells whose key values equal
+ *  match[k] (a value id, or XT_ANY) for every key.  For the dense
+ *  keys the value id is the value itself: 1 for human, brain and
+ *  muscle, the PE level for evidence.
+ *
+ *****************************************************************/
+  long long sum = 0;
+  int i, k, col;
+
+  if ((measure < 0) || (measure >= MEASURE_COUNT) || ((col = xt->column[measure]) < 0))
+    return 0;
+  for (i=0;i<xt->n_rows;i++) {
+    for (k=0;k<xt->n_keys;k++)
+      if ((match[k] != XT_ANY) && (match[k] != xt->row_vals[i*XT_MAX_KEYS+k]))
+        break;
+    if (k == xt->n_keys)
+      sum += xt->counts[i*xt->n_measures+col];
+  }
+  return sum;
+}
+
+
+const char * crosstab_spec (const struct crosstab *xt) {
+  return xt->spec;
+}
+
+
+static int xt_compare_rows (const void *a, const void *b, void *arg) {
+  const struct crosstab *xt = arg;
+  const int *x = &xt->row_vals[*(const int *)a*XT_MAX_KEYS];
+  const int *y = &xt->row_vals[*(const int *)b*XT_MAX_KEYS];
+  int k, c;
+
+  for (k=0;k<xt->n_keys;k++) {
+    if (XK_CARD_ARRAY[xt->keys[k]])
+      c = x[k] - y[k];
+    else
+      c = strcmp(xt->strings[k].s[x[k]], xt->strings[k].s[y[k]]);
+    if (c)
+      return c;
+  }
+  return 0;
+}
+
+static int * xt_sorted_rows (const struct crosstab *xt) {
+  int *order, i;
+
+  order = malloc((xt->n_rows ? xt->n_rows : 1)*sizeof(int));
+  for (i=0;i<xt->n_rows;i++)
+    order[i] = i;
+  qsort_r(order, xt->n_rows, sizeof(int), xt_compare_rows, (void *)xt);
+  return order;
+}
+
+void crosstab_print (const struct crosstab *xt, FILE *fp) {
+/*****************************************************************
+ *
+ *  Tab separated: one header line of key and measure names, then
+ *  one line per non-empty cell sorted by key values, so the
+ *  output does not depend on how many threads filled the cube.
+ *
+ *****************************************************************/
+  char name[128];
+  int *order, i, j, k, row;
+
+  for (k=0;k<xt->n_keys;k++)
+    fprintf(fp, "%s\t", XK_NAMES_ARRAY[xt->keys[k]]);
+  for (j=0;j<xt->n_measures;j++) {
+    measure_name(xt->measures[j], name, sizeof(name));
+    fprintf(fp, "%s%c", name, (j == xt->n_measures-1) ? '\n' : '\t');
+  }
+  order = xt_sorted_rows(xt);
+  for (i=0;i<xt->n_rows;i++) {
+    row = order[i];
+    if (xt->counts[row*xt->n_measures] == 0)
+      continue;
+    for (k=0;k<xt->n_keys;k++)
+      fprintf(fp, "%s\t", xt_label(xt, k, xt->row_vals[row*XT_MAX_KEYS+k]));
+    for (j=0;j<xt->n_measures;j++)
+      fprintf(fp, "%lld%c", xt->counts[row*xt->n_measures+j],
+          (j == xt->n_measures-1) ? '\n' : '\t');
+  }
+  free(order);
+} //----- crosstab_print (const struct crosstab *xt, FILE *fp) -----//
+
+
+void crosstab_print_json (const struct crosstab *xt, FILE *fp) {
+/*****************************************************************
+ *
+ *  {"spec": ..., "keys": [...], "measures": [...], "rows": [...]}
+ *  with each row the key labels followed by the counts, in the
+ *  order and with the rows of crosstab_print().
+ *
+ *****************************************************************/
+  char name[128];
+  int *order, i, j, k, row, first = 1;
+
+  fprintf(fp, "{\"spec\": ");
+  json_string(fp, xt->spec);
+  fprintf(fp, ", \"keys\": [");
+  for (k=0;k<xt->n_keys;k++)
+    fprintf(fp, "%s\"%s\"", k ? ", " : "", XK_NAMES_ARRAY[xt->keys[k]]);
+  fprintf(fp, "], \"measures\": [");
+  for (j=0;j<xt->n_measures;j++) {
+    measure_name(xt->measures[j], name, sizeof(name));
+    fprintf(fp, "%s", j ? ", " : "");
+    json_string(fp, name);
+  }
+  fprintf(fp, "], \"rows\": [");
+  order = xt_sorted_rows(xt);
+  for (i=0;i<xt->n_rows;i++) {
+    row = order[i];
+    if (xt->counts[row*xt->n_measures] == 0)
+      continue;
+    fprintf(fp, "%s\n    [", first ? "" : ",");
+    first = 0;
+    for (k=0;k<xt->n_keys;k++) {
+      json_string(fp, xt_label(xt, k, xt->row_vals[row*XT_MAX_KEYS+k]));
+      fprintf(fp, ", ");
+    }
+    for (j=0;j<xt->n_measures;j++)
+      fprintf(fp, "%s%lld", j ? ", " : "", xt->counts[row*xt->n_measures+j]);
+    fprintf(fp, "]");
+  }
+  fprintf(fp, "]}");
+  free(order);
+} //----- crosstab_print_json (const struct crosstab *xt, FILE *fp) -----//
+
+
+int crosstab_write (const struct crosstab *xt, FILE *fp) {
+/*****************************************************************
+ *
+ *  Binary image of a cube for crosstab_read():
+ *    int spec_len, spec, int n_rows
+ *    per hashed key: int n, then n times int len and the bytes
+ *    per row: n_keys int value ids, n_measures long long counts
+ *
+ *****************************************************************/
+  int i, k, len;
+
+  len = strlen(xt->spec);
+  fwrite(&len, sizeof(int), 1, fp);
+  fwrite(xt->spec, 1, len, fp);
+  fwrite(&xt->n_rows, sizeof(int), 1, fp);
+  for (k=0;k<xt->n_keys;k++) {
+    if (XK_CARD_ARRAY[xt->keys[k]])
+      continue;
+    fwrite(&xt->strings[k].n, sizeof(int), 1, fp);
+    for (i=0;i<xt->strings[k].n;i++) {
+      len = strlen(xt->strings[k].s[i]);
+      fwrite(&len, sizeof(int), 1, fp);
+      fwrite(xt->strings[k].s[i], 1, len, fp);
+    }
+  }
+  for (i=0;i<xt->n_rows;i++) {
+    fwrite(&xt->row_vals[i*XT_MAX_KEYS], sizeof(int), xt->n_keys, fp);
+    fwrite(&xt->counts[i*xt->n_measures], sizeof(long long), xt->n_measures, fp);
+  }
+  return ferror(fp) ? -1 : 0;
+} //----- crosstab_write (const struct crosstab *xt, FILE *fp) -----//
+
+
+struct crosstab * crosstab_read (FILE *fp) {
+/*****************************************************************
+ *  A cube saved by crosstab_write(), or NULL if fp is short
+ *****************************************************************/
+  struct crosstab *xt = NULL;
+  char *spec, **names[XT_MAX_KEYS];
+  int n_names[XT_MAX_KEYS], tuple[XT_MAX_KEYS], vals[XT_MAX_KEYS];
+  long long counts[MEASURE_COUNT];
+  int i, j, k, len, n_rows = 0, row, bad = 0;
+
+  memset(names, 0, sizeof(names));
+  memset(n_names, 0, sizeof(n_names));
+  if ((fread(&len, sizeof(int), 1, fp) != 1) || (len < 0) || (len > 4096))
+    return NULL;
+  spec = calloc(len + 1, 1);
+  if ((fread(spec, 1, len, fp) != (size_t)len) || ((xt = crosstab_new(spec)) == NULL) ||
+      (fread(&n_rows, sizeof(int), 1, fp) != 1))
+    bad = 1;
+  free(spec);
+
+  for (k=0;(!bad)&&(k<xt->n_keys);k++) {
+    if (XK_CARD_ARRAY[xt->keys[k]])
+      continue;
+    if ((fread(&n_names[k], sizeof(int), 1, fp) != 1) || (n_names[k] < 0)) {
+      n_names[k] = 0;
+      bad = 1;
+      break;
+    }
+    names[k] = calloc(n_names[k] + 1, sizeof(char *));
+    for (i=0;(!bad)&&(i<n_names[k]);i++) {
+      if ((fread(&len, sizeof(int), 1, fp) != 1) || (len < 0) || (len > 4096))
+        bad = 1;
+      else {
+        names[k][i] = calloc(len + 1, 1);
+        bad = (fread(names[k][i], 1, len, fp) != (size_t)len);
+      }
+    }
+  }
+
+  for (i=0;(!bad)&&(i<n_rows);i++) {
+    if ((fread(vals, sizeof(int), xt->n_keys, fp) != (size_t)xt->n_keys) ||
+        (fread(counts, sizeof(long long), xt->n_measures, fp) != (size_t)xt->n_measures)) {
+      bad = 1;
+      break;
+    }
+    memset(tuple, 0, sizeof(tuple));
+    for (k=0;k<xt->n_keys;k++) {
+      if (XK_CARD_ARRAY[xt->keys[k]])
+        bad |= (vals[k] < 0) || (vals[k] >= XK_CARD_ARRAY[xt->keys[k]]);
+      else
+        bad |= (vals[k] < 0) || (vals[k] >= n_names[k]);
+      if (bad)
+        break;
+      tuple[k] = XK_CARD_ARRAY[xt->keys[k]] ? vals[k] :
+                 xt_intern(&xt->strings[k], names[k][vals[k]]);
+    }
+    if (bad)
+      break;
+    row = xt_row(xt, tuple);
+    for (j=0;j<xt->n_measures;j++)
+      xt->counts[row*xt->n_measures+j] += counts[j];
+  }
+
+  for (k=0;k<XT_MAX_KEYS;k++) {
+    for (i=0;(names[k] != NULL)&&(i<n_names[k]);i++)
+      free(names[k][i]);
+    free(names[k]);
+  }
+  if (bad) {
+    crosstab_free(xt);
+    return NULL;
+  }
+  return xt;
+} //----- crosstab_read (FILE *fp) -----//
+
+
+void crosstab_free (struct crosstab *xt) {
+  int k;
+
+  if (xt == NULL)
+    return;
+  for (k=0;k<XT_MAX_KEYS;k++) {
+    arena_free(&xt->strings[k].text);
+    free(xt->strings[k].s);
+    free(xt->strings[k].hash);
+  }
+  free(xt->spec);
+  free(xt->row_vals);
+  free(xt->counts);
+  free(xt->hash);
+  free(xt);
+}
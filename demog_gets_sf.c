@@ -52,7 +52,7 @@ int main (int argc, char *argv[]) {
    //const long long BLOCKSIZE = 1<<30;
 
    int fd, done, block_count, bytes_read,status,line_len;
-   int biggest_line, file_arg = 1, bs_arg = 2,  opt;
+   int biggest_line = 0, file_arg = 1, bs_arg = 2,  opt;
    char  err_msg[MAXLINE], line[MAXLINE], *block, alloc_type='v';
    long long i = 0, inf_size, numlines = 0, j = 0, last_nl = 0, k = 0;
    long long line_begin = 0, last_line_begin = 0;
@@ -112,7 +112,7 @@ int main (int argc, char *argv[]) {
          strcpy(mem_method,"alloca");
          break;
       case 'p':
-         posix_memalign((void **)&block, BLOCKSIZE, PAGESIZE);
+         posix_memalign((void **)&block, PAGESIZE, BLOCKSIZE);
          strcpy(mem_method,"posix_memalign");
          break;
    } //--- switch (alloc_type) ---///
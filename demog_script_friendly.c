@@ -174,7 +174,7 @@ int main (int argc, char *argv[]) {
        strcpy(mem_method, "malloc");
        break;
      case 'p':
-       posix_memalign((void **)&block,BLOCKSIZE,PAGESIZE);
+       posix_memalign((void **)&block, PAGESIZE, BLOCKSIZE);
        strcpy(mem_method, "posix_memalign");
        break;
      case 'a':
@@ -0,0 +1,752 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+/*********************************************************************
+ *
+ *  GENCORPUS -- a synthetic UniProt flat file of any size
+ *
+ *    gencorpus [-s seed] [-S size[K|M|G|T]] [-n records] [-j threads]
+ *              [-d name=value,...] [-o outfile]
+ *
+ *  Entries look like Swiss-Prot text (ID/AC/DT/DE/GN/OS/OC/OX,
+ *  RN..RL references, CC comments, DR cross-references, PE, KW,
+ *  FT features, SQ and the sequence) and carry every line promog
+ *  looks at.  Each entry is drawn from its own generator, seeded
+ *  from the seed and the entry number, so the output depends only
+ *  on -s, -S, -n and -d: never on -j.
+ *
+ *  Each entry first picks a class (membrane, secreted, nuclear,
+ *  cytosolic or unannotated) which decides its SUBCELLULAR
+ *  LOCATION, GO terms, features and keywords, so the promog
+ *  compartment counts come out in plausible proportions.
+ *
+ *  The -d profile (defaults in DEFAULT_PROFILE):
+ *
+ *    seqlen    median sequence length (log-normal)
+ *    seqsigma  sigma of log(sequence length)
+ *    refs      mean references (RN..RL blocks) per entry
+ *    cc        mean free-text comments per entry
+ *    dr        mean DR lines per entry
+ *    ft        mean extra (non-topology) FT features per entry
+ *    kw        mean keywords per entry
+ *    human     fraction of human entries
+ *    species   size of the long tail of made-up organisms
+ *    tail      fraction of entries from that long tail
+ *    tissue    fraction of references with a TISSUE= RC line
+ *    scl       fraction of entries with a SUBCELLULAR LOCATION
+ *    long      fraction of entries with one pathological long line
+ *    longlen   length of that line
+ *
+ *  Sizes stop at the first entry that reaches -S; -n caps the
+ *  number of entries; with neither, 1000 entries are written.
+ *
+ *********************************************************************/
+
+#define BATCH_RECORDS  2048
+#define MAX_THREADS      64
+#define WRAP_COLS        75
+
+struct gen_profile {
+  double seqlen, seqsigma, refs, cc, dr, ft, kw, human, species, tail;
+  double tissue, scl, lng, longlen;
+};
+
+static const struct gen_profile DEFAULT_PROFILE = {
+  360, 0.75, 2.5, 2.0, 24, 6, 8, 0.20, 5000, 0.30,
+  0.35, 0.55, 0.0005, 20000
+};
+
+struct gbuf {
+  char *p;
+  size_t len, cap;
+};
+
+struct gen_shared {
+  struct gen_profile prof;
+  unsigned long long seed;
+  long long max_records, max_bytes;
+  int fd;
+  pthread_mutex_t lock;
+  pthread_cond_t turn;
+  long long next_batch, next_write;     /* batches claimed / written */
+  long long records, bytes;
+  int stop, failed;
+};
+
+/*********************************************************************
+ *  Organisms: the well-annotated head of Swiss-Prot
+ *********************************************************************/
+#define ORGANISMS 10
+static const char *ORGANISM_NAMES_ARRAY[ORGANISMS] = { "Homo sapiens (Human)",
+   "Mus musculus (Mouse)", "Rattus norvegicus (Rat)", "Bos taurus (Bovine)",
+   "Saccharomyces cerevisiae (strain ATCC 204508 / S288c) (Baker's yeast)",
+   "Arabidopsis thaliana (Mouse-ear cress)", "Escherichia coli (strain K12)",
+   "Drosophila melanogaster (Fruit fly)", "Caenorhabditis elegans",
+   "Danio rerio (Zebrafish) (Brachydanio rerio)"};
+static const char *ORGANISM_CODES_ARRAY[ORGANISMS] = {"HUMAN", "MOUSE", "RAT",
+   "BOVIN", "YEAST", "ARATH", "ECOLI", "DROME", "CAEEL", "DANRE"};
+static const int ORGANISM_TAXIDS_ARRAY[ORGANISMS] = {9606, 10090, 10116, 9913,
+   559292, 3702, 83333, 7227, 6239, 7955};
+static const char *ORGANISM_LINEAGE_ARRAY[ORGANISMS] = {
+   "Eukaryota; Metazoa; Chordata; Craniata; Vertebrata; Euteleostomi; Mammalia; "
+   "Eutheria; Euarchontoglires; Primates; Haplorrhini; Catarrhini; Hominidae; Homo.",
+   "Eukaryota; Metazoa; Chordata; Craniata; Vertebrata; Euteleostomi; Mammalia; "
+   "Eutheria; Euarchontoglires; Glires; Rodentia; Myomorpha; Muroidea; Muridae; "
+   "Murinae; Mus; Mus.",
+   "Eukaryota; Metazoa; Chordata; Craniata; Vertebrata; Euteleostomi; Mammalia; "
+   "Eutheria; Euarchontoglires; Glires; Rodentia; Myomorpha; Muroidea; Muridae; "
+   "Murinae; Rattus.",
+   "Eukaryota; Metazoa; Chordata; Craniata; Vertebrata; Euteleostomi; Mammalia; "
+   "Eutheria; Laurasiatheria; Artiodactyla; Ruminantia; Pecora; Bovidae; Bovinae; Bos.",
+   "Eukaryota; Fungi; Dikarya; Ascomycota; Saccharomycotina; Saccharomycetes; "
+   "Saccharomycetales; Saccharomycetaceae; Saccharomyces.",
+   "Eukaryota; Viridiplantae; Streptophyta; Embryophyta; Tracheophyta; "
+   "Spermatophyta; Magnoliopsida; eudicotyledons; Gunneridae; Pentapetalae; "
+   "rosids; malvids; Brassicales; Brassicaceae; Camelineae; Arabidopsis.",
+   "Bacteria; Proteobacteria; Gammaproteobacteria; Enterobacterales; "
+   "Enterobacteriaceae; Escherichia.",
+   "Eukaryota; Metazoa; Ecdysozoa; Arthropoda; Hexapoda; Insecta; Pterygota; "
+   "Neoptera; Endopterygota; Diptera; Brachycera; Muscomorpha; Ephydroidea; "
+   "Drosophilidae; Drosophila; Sophophora.",
+   "Eukaryota; Metazoa; Ecdysozoa; Nematoda; Chromadorea; Rhabditida; "
+   "Rhabditina; Rhabditomorpha; Rhabditoidea; Rhabditidae; Peloderinae; Caenorhabditis.",
+   "Eukaryota; Metazoa; Chordata; Craniata; Vertebrata; Euteleostomi; "
+   "Actinopterygii; Neopterygii; Teleostei; Ostariophysi; Cypriniformes; "
+   "Danionidae; Danioninae; Danio."};
+/*  relative weights of the non-human head  */
+static const double ORGANISM_WEIGHTS_ARRAY[ORGANISMS] = {0, 17, 8, 6, 6, 15, 4, 4, 4, 3};
+
+#define TISSUES 12
+static const char *TISSUE_NAMES_ARRAY[TISSUES] = {"Brain", "Muscle", "Liver",
+   "Kidney", "Lung", "Placenta", "Testis", "Heart", "Skeletal muscle", "Blood",
+   "Fetal brain", "Pancreas"};
+
+/*********************************************************************
+ *  Entry classes and what each one says about itself
+ *********************************************************************/
+#define CLASSES 5
+enum { CL_MEMBRANE, CL_SECRETED, CL_NUCLEAR, CL_CYTOSOLIC, CL_OTHER };
+static const double CLASS_WEIGHTS_ARRAY[CLASSES] = {0.27, 0.12, 0.20, 0.26, 0.15};
+static const char *CLASS_SCL_ARRAY[CLASSES][3] = {
+   {"Cell membrane; Multi-pass membrane protein.",
+    "Endoplasmic reticulum membrane; Single-pass type II membrane protein.",
+    "Golgi apparatus membrane; Multi-pass membrane protein."},
+   {"Secreted.", "Secreted, extracellular space, extracellular matrix.",
+    "Secreted. Cytoplasmic vesicle, secretory vesicle lumen."},
+   {"Nucleus.", "Nucleus, nucleolus.", "Chromosome, centromere, kinetochore. Nucleus."},
+   {"Cytoplasm, cytosol.", "Cytoplasm.", "Cytoplasm, cytoskeleton. Cell projection, cilium."},
+   {"Mitochondrion matrix.", "Peroxisome.", "Lysosome. Endosome."}};
+static const char *CLASS_GO_ARRAY[CLASSES] = {
+   "GO:0016021; C:integral component of membrane",
+   "GO:0005576; C:extracellular region",
+   "GO:0005634; C:nucleus",
+   "GO:0005829; C:cytosol",
+   "GO:0005739; C:mitochondrion"};
+#define GO_TERMS 8
+static const char *GO_TERMS_ARRAY[GO_TERMS] = {
+   "GO:0005886; C:plasma membrane", "GO:0005737; C:cytoplasm",
+   "GO:0031012; C:extracellular matrix", "GO:0003677; F:DNA binding",
+   "GO:0007165; P:signal transduction", "GO:0055114; P:oxidation-reduction process",
+   "GO:0005524; F:ATP binding", "GO:0046872; F:metal ion binding"};
+static const char *CLASS_KW_ARRAY[CLASSES] = {"Membrane", "Secreted", "Nucleus",
+   "Cytoplasm", "Mitochondrion"};
+
+#define KEYWORDS 16
+static const char *KEYWORD_NAMES_ARRAY[KEYWORDS] = {"Reference proteome",
+   "Phosphoprotein", "Acetylation", "Alternative splicing", "Glycoprotein",
+   "Disulfide bond", "Kinase", "Transferase", "Hydrolase", "Metal-binding",
+   "Zinc", "ATP-binding", "Nucleotide-binding", "Repeat", "Ubl conjugation",
+   "3D-structure"};
+
+#define FEATURES 8
+static const char *FEATURE_NAMES_ARRAY[FEATURES] = {"DOMAIN", "REGION",
+   "MOD_RES", "BINDING", "DISULFID", "CARBOHYD", "HELIX", "STRAND"};
+
+/*  all 20 residues in 64 slots, roughly Swiss-Prot proportions  */
+static const char RESIDUES[65] =
+   "LLLLLLAAAAAGGGGGVVVVEEEESSSSIIII"
+   "KKKKRRRRDDDTTTPPPNNNQQQFFYYMMHCW";
+static const char *MONTHS_ARRAY[12] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+   "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+
+/*********************************************************************
+ *  splitmix64: one small generator per entry
+ *********************************************************************/
+static unsigned long long next_rand (unsigned long long *s) {
+  unsigned long long z = (*s += 0x9E3779B97F4A7C15ULL);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static double uniform (unsigned long long *s) {
+  return (next_rand(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int below (unsigned long long *s, int n) {
+  return (int)(uniform(s) * n);
+}
+
+static int poisson (unsigned long long *s, double mean) {
+/*****************************************************************
+ *  Knuth's method; the profile means are small
+ *****************************************************************/
+  double l = exp(-mean), p = 1.0;
+  int k = 0;
+
+  if (mean <= 0)
+    return 0;
+  do {
+    k++;
+    p *= uniform(s);
+  } while (p > l);
+  return k - 1;
+}
+
+static double normal (unsigned long long *s) {
+  double u = uniform(s), v = uniform(s);
+
+  return sqrt(-2.0 * log(u + 1e-300)) * cos(2.0 * M_PI * v);
+}
+
+static int pick (unsigned long long *s, const double *w, int n) {
+  double total = 0, x;
+  int i;
+
+  for (i=0;i<n;i++)
+    total += w[i];
+  x = uniform(s) * total;
+  for (i=0;i<n-1;i++) {
+    if (x < w[i])
+      return i;
+    x -= w[i];
+  }
+  return n - 1;
+}
+
+
+/*********************************************************************
+ *  Output buffer
+ *********************************************************************/
+static void gb_reserve (struct gbuf *g, size_t n) {
+  if (g->len + n + 1 > g->cap) {
+    while (g->len + n + 1 > g->cap)
+      g->cap = g->cap ? 2*g->cap : 1<<20;
+    g->p = realloc(g->p, g->cap);
+  }
+}
+
+static void gb_put (struct gbuf *g, const char *s, size_t n) {
+  gb_reserve(g, n);
+  memcpy(g->p + g->len, s, n);
+  g->len += n;
+}
+
+static void gb_str (struct gbuf *g, const char *s) {
+  gb_put(g, s, strlen(s));
+}
+
+static void gb_fmt (struct gbuf *g, const char *fmt, ...) {
+  va_list ap;
+  int n;
+
+  gb_reserve(g, 256);
+  va_start(ap, fmt);
+  n = vsnprintf(g->p + g->len, g->cap - g->len, fmt, ap);
+  va_end(ap);
+  if (g->len + n + 1 > g->cap) {
+    gb_reserve(g, n);
+    va_start(ap, fmt);
+    vsnprintf(g->p + g->len, g->cap - g->len, fmt, ap);
+    va_end(ap);
+  }
+  g->len += n;
+}
+
+static void gb_wrap (struct gbuf *g, const char *first, const char *rest, const char *text) {
+/*****************************************************************
+ *  Word-wrap text at WRAP_COLS, first line after first, the
+ *  continuation lines after rest
+ *****************************************************************/
+  const char *prefix = first;
+  size_t n = strlen(text), width, cut;
+
+  while (n > 0) {
+    width = WRAP_COLS - strlen(prefix);
+    cut = n;
+    if (n > width) {
+      for (cut=width;(cut>0)&&(text[cut] != ' ');cut--)
+        ;
+      if (cut == 0)
+        cut = width;
+    }
+    gb_put(g, prefix, strlen(prefix));
+    gb_put(g, text, cut);
+    gb_put(g, "\n", 1);
+    text += cut;
+    n -= cut;
+    while ((n > 0) && (*text == ' ')) {
+      text++;
+      n--;
+    }
+    prefix = rest;
+  }
+}
+
+
+static void accession (long long idx, char *acc) {
+/*****************************************************************
+ *  Swiss-Prot style [OPQ]nnnnn for the first three million
+ *  entries, then TrEMBL style A0A + seven base-36 characters
+ *****************************************************************/
+  const char *B36 = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  int i;
+
+  if (idx < 300000) {
+    sprintf(acc, "%c%05lld", "OPQ"[idx / 100000], idx % 100000);
+    return;
+  }
+  idx -= 300000;
+  strcpy(acc, "A0A");
+  for (i=9;i>=3;i--) {
+    acc[i] = B36[idx % 36];
+    idx /= 36;
+  }
+  acc[10] = '\0';
+}
+
+
+static void gen_entry (const struct gen_profile *pf, unsigned long long seed,
+                       long long idx, struct gbuf *g) {
+/*****************************************************************
+ *
+ *  Append entry idx to g
+ *
+ *****************************************************************/
+  unsigned long long s = seed ^ (0x9E3779B97F4A7C15ULL * (unsigned long long)(idx + 1));
+  unsigned long long r, crc = 0xCBF29CE484222325ULL;
+  char acc[16], code[16], text[512], org[96], *seq;
+  const char *lineage;
+  int len, cls, org_i, n, i, j, k, t, from, to, taxid;
+  int n_refs, n_cc, n_dr, n_ft, n_kw, long_at;
+
+  next_rand(&s);
+  accession(idx, acc);
+  len = (int)(pf->seqlen * exp(pf->seqsigma * normal(&s)));
+  if (len < 10)
+    len = 10;
+  if (len > 35000)
+    len = 35000;
+  cls = pick(&s, CLASS_WEIGHTS_ARRAY, CLASSES);
+
+  /*  organism: human, the annotated head, or the long tail  */
+  if (uniform(&s) < pf->human)
+    org_i = 0;
+  else if (uniform(&s) < pf->tail)
+    org_i = -1;
+  else
+    org_i = pick(&s, ORGANISM_WEIGHTS_ARRAY, ORGANISMS);
+  if (org_i >= 0) {
+    strcpy(org, ORGANISM_NAMES_ARRAY[org_i]);
+    strcpy(code, ORGANISM_CODES_ARRAY[org_i]);
+    taxid = ORGANISM_TAXIDS_ARRAY[org_i];
+    lineage = ORGANISM_LINEAGE_ARRAY[org_i];
+  }
+  else {
+    k = below(&s, pf->species > 1 ? (int)pf->species : 1);
+    sprintf(org, "Synthetica species%d", k);
+    sprintf(code, "SYN%02d", k % 100);
+    taxid = 2000000 + k;
+    lineage = "Bacteria; Synthetica.";
+  }
+
+  n_refs = 1 + poisson(&s, pf->refs - 1);
+  n_cc = poisson(&s, pf->cc);
+  n_dr = poisson(&s, pf->dr);
+  n_ft = poisson(&s, pf->ft);
+  n_kw = poisson(&s, pf->kw);
+  long_at = (uniform(&s) < pf->lng) ? below(&s, n_refs) : -1;
+
+  snprintf(text, sizeof(text), "SYN%lld_%s", idx, code);
+  gb_fmt(g, "ID   %-20s Reviewed; %7d AA.\n", text, len);
+  gb_fmt(g, "AC   %s;\n", acc);
+  gb_fmt(g, "DT   %02d-%s-%d, integrated into UniProtKB/Swiss-Prot.\n",
+         1 + below(&s, 28), MONTHS_ARRAY[below(&s, 12)], 1986 + below(&s, 20));
+  gb_fmt(g, "DT   %02d-%s-%d, sequence version %d.\n",
+         1 + below(&s, 28), MONTHS_ARRAY[below(&s, 12)], 2006 + below(&s, 10), 1 + below(&s, 3));
+  gb_fmt(g, "DT   %02d-%s-%d, entry version %d.\n",
+         1 + below(&s, 28), MONTHS_ARRAY[below(&s, 12)], 2016 + below(&s, 8), 1 + below(&s, 200));
+  gb_fmt(g, "DE   RecName: Full=Synthetic protein %lld;\n", idx);
+  gb_fmt(g, "GN   Name=SYN%lld;\n", idx);
+  gb_fmt(g, "OS   %s.\n", org);
+  gb_wrap(g, "OC   ", "OC   ", lineage);
+  gb_fmt(g, "OX   NCBI_TaxID=%d;\n", taxid);
+
+  for (i=0;i<n_refs;i++) {
+    gb_fmt(g, "RN   [%d]\n", i + 1);
+    gb_str(g, "RP   NUCLEOTIDE SEQUENCE [MRNA].\n");
+    if (uniform(&s) < pf->tissue) {
+      t = below(&s, TISSUES);
+      if (uniform(&s) < 0.3)
+        gb_fmt(g, "RC   TISSUE=%s, and %s;\n", TISSUE_NAMES_ARRAY[t],
+               TISSUE_NAMES_ARRAY[(t + 1 + below(&s, TISSUES-1)) % TISSUES]);
+      else
+        gb_fmt(g, "RC   TISSUE=%s;\n", TISSUE_NAMES_ARRAY[t]);
+    }
+    gb_fmt(g, "RX   PubMed=%d;\n", 1000000 + below(&s, 30000000));
+    gb_fmt(g, "RA   Author%c.%c., Author%c.%c.;\n", 'A' + below(&s, 26), 'A' + below(&s, 26),
+           'A' + below(&s, 26), 'A' + below(&s, 26));
+    if (i == long_at) {
+      /*  pathological: one unwrapped title line of longlen characters  */
+      gb_str(g, "RT   \"");
+      gb_reserve(g, (size_t)pf->longlen);
+      for (j=0;j<(int)pf->longlen;j++)
+        g->p[g->len++] = (j % 8 == 7) ? ' ' : 'x';
+      gb_str(g, "\";\n");
+    }
+    else
+      gb_fmt(g, "RT   \"Characterization of synthetic protein %lld.\";\n", idx);
+    gb_fmt(g, "RL   J. Synth. Biol. %d:%d-%d(%d).\n", 1 + below(&s, 300),
+           100 + below(&s, 800), 900 + below(&s, 100), 1980 + below(&s, 44));
+  }
+
+  for (i=0;i<n_cc;i++) {
+    snprintf(text, sizeof(text), "-!- FUNCTION: Plays a role in synthetic pathway %d, "
+             "probably through interaction with synthetic partner %d in a manner "
+             "that depends on the cell type.", below(&s, 1000), below(&s, 1000));
+    gb_wrap(g, "CC   ", "CC       ", text);
+  }
+  if (uniform(&s) < pf->scl) {
+    snprintf(text, sizeof(text), "-!- SUBCELLULAR LOCATION: %s", CLASS_SCL_ARRAY[cls][below(&s, 3)]);
+    gb_wrap(g, "CC   ", "CC       ", text);
+  }
+  gb_str(g, "CC   -----------------------------------------------------------------------\n"
+            "CC   Copyrighted by the UniProt Consortium, see https://www.uniprot.org/terms\n"
+            "CC   Distributed under the Creative Commons Attribution (CC BY 4.0) License\n"
+            "CC   -----------------------------------------------------------------------\n");
+
+  for (i=0;i<n_dr;i++) {
+    k = below(&s, 10);
+    if (k < 3)
+      gb_fmt(g, "DR   EMBL; X%05d; CAA%05d.1; -; mRNA.\n", below(&s, 100000), below(&s, 100000));
+    else if ((k < 5) || (i == 0))
+      gb_fmt(g, "DR   GO; %s; IDA:UniProtKB.\n", (i == 0) || (k == 3) ?
+             CLASS_GO_ARRAY[cls] : GO_TERMS_ARRAY[below(&s, GO_TERMS)]);
+    else if (k < 7)
+      gb_fmt(g, "DR   InterPro; IPR%06d; Synthetic_dom.\n", below(&s, 50000));
+    else if (k < 8)
+      gb_fmt(g, "DR   Pfam; PF%05d; Synthetic; %d.\n", below(&s, 20000), 1 + below(&s, 3));
+    else
+      gb_fmt(g, "DR   PDB; %d%c%c%c; X-ray; %d.%02d A; A=1-%d.\n", 1 + below(&s, 9),
+             'A' + below(&s, 26), 'A' + below(&s, 26), '0' + below(&s, 10),
+             1 + below(&s, 3), below(&s, 100), len);
+  }
+  gb_fmt(g, "PE   %d: %s;\n", 1 + below(&s, 5), "Evidence at protein level");
+
+  /*  keywords: the class first, then a sample of the rest  */
+  n = snprintf(text, sizeof(text), "%s", CLASS_KW_ARRAY[cls]);
+  if (cls == CL_MEMBRANE)
+    n += snprintf(text + n, sizeof(text) - n, "; Transmembrane; Transmembrane helix");
+  if (cls == CL_SECRETED)
+    n += snprintf(text + n, sizeof(text) - n, "; Signal");
+  for (i=0;(i<n_kw)&&(n<(int)sizeof(text)-40);i++)
+    n += snprintf(text + n, sizeof(text) - n, "; %s", KEYWORD_NAMES_ARRAY[below(&s, KEYWORDS)]);
+  snprintf(text + n, sizeof(text) - n, ".");
+  gb_wrap(g, "KW   ", "KW   ", text);
+
+  /*  features: topology from the class, then the extras  */
+  if ((cls == CL_SECRETED) && (len > 40)) {
+    gb_fmt(g, "FT   SIGNAL          1..%d\n", 18 + below(&s, 10));
+  }
+  if (cls == CL_MEMBRANE) {
+    k = 1 + below(&s, 7);
+    for (i=0;(i<k)&&((i+1)*40<len);i++) {
+      from = i*40 + 5 + below(&s, 10);
+      gb_fmt(g, "FT   TRANSMEM        %d..%d\n", from, from + 20);
+      gb_str(g, "FT                   /note=\"Helical\"\n");
+    }
+  }
+  if ((cls == CL_NUCLEAR) && (uniform(&s) < 0.3) && (len > 80)) {
+    from = 1 + below(&s, len - 70);
+    gb_fmt(g, "FT   DNA_BIND        %d..%d\n", from, from + 60);
+  }
+  gb_fmt(g, "FT   CHAIN           1..%d\n", len);
+  gb_fmt(g, "FT                   /note=\"Synthetic protein %lld\"\n", idx);
+  gb_fmt(g, "FT                   /id=\"PRO_%010lld\"\n", idx);
+  for (i=0;i<n_ft;i++) {
+    from = 1 + below(&s, len);
+    to = from + below(&s, 60);
+    if (to > len)
+      to = len;
+    gb_fmt(g, "FT   %-16s%d..%d\n", FEATURE_NAMES_ARRAY[below(&s, FEATURES)], from, to);
+  }
+  if ((uniform(&s) < 0.01) && (len > 30)) {
+    from = 1 + below(&s, len - 20);
+    gb_fmt(g, "FT   LIPID           %d\n", from);
+    gb_str(g, "FT                   /note=\"S-palmitoyl cysteine\"\n");
+  }
+
+  /*  the sequence: 10 residues from each 60 random bits  */
+  seq = malloc(len + 10);
+  for (i=0;i<len;i+=10) {
+    r = next_rand(&s);
+    for (j=0;j<10;j++,r>>=6)
+      seq[i+j] = RESIDUES[r & 63];
+  }
+  for (i=0;i<len;i++)
+    crc = (crc ^ (unsigned char)seq[i]) * 0x100000001B3ULL;
+  gb_fmt(g, "SQ   SEQUENCE %5d AA; %6d MW;  %016llX CRC64;\n", len,
+         len * 110 + below(&s, 5000), crc);
+  gb_reserve(g, len + len/10 + 2*(len/60) + 8);
+  for (i=0;i<len;i+=60) {
+    gb_str(g, "    ");
+    for (j=i;(j<i+60)&&(j<len);j+=10) {
+      gb_put(g, " ", 1);
+      gb_put(g, &seq[j], (j + 10 <= len) ? 10 : len - j);
+    }
+    gb_put(g, "\n", 1);
+  }
+  gb_str(g, "//\n");
+  free(seq);
+} //----- gen_entry -----//
+
+
+static int write_all (int fd, const char *p, size_t n) {
+  ssize_t w;
+
+  while (n > 0) {
+    if ((w = write(fd, p, n)) < 0)
+      return -1;
+    p += w;
+    n -= w;
+  }
+  return 0;
+}
+
+static void * gen_thread (void *arg) {
+/*****************************************************************
+ *
+ *  Claim batches of BATCH_RECORDS entries, generate them, then
+ *  wait for this batch's turn and write it.  Every claimed batch
+ *  takes its turn, so next_write never stalls.
+ *
+ *****************************************************************/
+  struct gen_shared *sh = arg;
+  struct gbuf g = {NULL, 0, 0};
+  size_t ends[BATCH_RECORDS];
+  long long b, first, count, k, take;
+
+  for (;;) {
+    pthread_mutex_lock(&sh->lock);
+    if (sh->stop || (sh->next_batch * BATCH_RECORDS >= sh->max_records)) {
+      pthread_mutex_unlock(&sh->lock);
+      break;
+    }
+    b = sh->next_batch++;
+    pthread_mutex_unlock(&sh->lock);
+
+    first = b * BATCH_RECORDS;
+    count = sh->max_records - first;
+    if (count > BATCH_RECORDS)
+      count = BATCH_RECORDS;
+    g.len = 0;
+    for (k=0;k<count;k++) {
+      gen_entry(&sh->prof, sh->seed, first + k, &g);
+      ends[k] = g.len;
+    }
+
+    pthread_mutex_lock(&sh->lock);
+    while (sh->next_write != b)
+      pthread_cond_wait(&sh->turn, &sh->lock);
+    if (!sh->stop) {
+      /*  stop at the first entry that reaches the size target  */
+      for (k=0;(k<count-1)&&(sh->bytes+(long long)ends[k]<sh->max_bytes);k++)
+        ;
+      take = (sh->bytes + (long long)ends[count-1] < sh->max_bytes) ? count : k + 1;
+      if (write_all(sh->fd, g.p, ends[take-1]) < 0) {
+        perror("gencorpus: write");
+        sh->failed = 1;
+        sh->stop = 1;
+      }
+      else {
+        sh->bytes += ends[take-1];
+        sh->records += take;
+        if ((sh->bytes >= sh->max_bytes) || (sh->records >= sh->max_records))
+          sh->stop = 1;
+      }
+    }
+    sh->next_write++;
+    pthread_cond_broadcast(&sh->turn);
+    pthread_mutex_unlock(&sh->lock);
+  }
+  free(g.p);
+  return NULL;
+} //----- gen_thread -----//
+
+
+static int set_profile (struct gen_profile *pf, char *spec) {
+  char *tok, *save, *eq;
+  double v;
+
+  for (tok = strtok_r(spec, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+    if ((eq = strchr(tok, '=')) == NULL)
+      return -1;
+    *eq = '\0';
+    v = atof(eq + 1);
+    if (!strcmp(tok, "seqlen"))        pf->seqlen = v;
+    else if (!strcmp(tok, "seqsigma")) pf->seqsigma = v;
+    else if (!strcmp(tok, "refs"))     pf->refs = v;
+    else if (!strcmp(tok, "cc"))       pf->cc = v;
+    else if (!strcmp(tok, "dr"))       pf->dr = v;
+    else if (!strcmp(tok, "ft"))       pf->ft = v;
+    else if (!strcmp(tok, "kw"))       pf->kw = v;
+    else if (!strcmp(tok, "human"))    pf->human = v;
+    else if (!strcmp(tok, "species"))  pf->species = v;
+    else if (!strcmp(tok, "tail"))     pf->tail = v;
+    else if (!strcmp(tok, "tissue"))   pf->tissue = v;
+    else if (!strcmp(tok, "scl"))      pf->scl = v;
+    else if (!strcmp(tok, "long"))     pf->lng = v;
+    else if (!strcmp(tok, "longlen"))  pf->longlen = v;
+    else
+      return -1;
+  }
+  return 0;
+}
+
+static long long parse_size (const char *s) {
+  char *end;
+  double v = strtod(s, &end);
+
+  switch (*end) {
+    case 'T': case 't': v *= 1024;   /* fall through */
+    case 'G': case 'g': v *= 1024;   /* fall through */
+    case 'M': case 'm': v *= 1024;   /* fall through */
+    case 'K': case 'k': v *= 1024;
+  }
+  return (long long)v;
+}
+
+
+int main (int argc, char *argv[]) {
+
+  const int GOOD_EXIT  = 0;
+  const int  BAD_ARGC  = -1;
+  const int BAD_OUTFILE  = -2 ;
+  const int BAD_WRITE  = -3 ;
+
+  struct gen_shared sh;
+  pthread_t tid[MAX_THREADS];
+  struct timespec t_begin, t_end;
+  int n_threads = 1, opt, k, bad = 0;
+  char *outfile = NULL, err_msg[256];
+  double secs;
+
+  memset(&sh, 0, sizeof(sh));
+  sh.prof = DEFAULT_PROFILE;
+  sh.seed = 1;
+  sh.max_records = -1;
+  sh.max_bytes = -1;
+  while ((opt = getopt(argc,argv,"s:S:n:j:d:o:")) != EOF) {
+    switch (opt) {
+      case 's':
+        sh.seed = strtoull(optarg, NULL, 0);
+        break;
+      case 'S':
+        sh.max_bytes = parse_size(optarg);
+        break;
+      case 'n':
+        sh.max_records = atoll(optarg);
+        break;
+      case 'j':
+        n_threads = atoi(optarg);
+        break;
+      case 'd':
+        if (set_profile(&sh.prof, optarg) < 0)
+          bad = 1;
+        break;
+      case 'o':
+        outfile = optarg;
+        break;
+      default:
+        bad = 1;
+    }//--- switch (opt) ---//
+  }
+  if (bad || (optind < argc) || (n_threads < 1) || (n_threads > MAX_THREADS)) {
+    sprintf(err_msg,"USAGE: gencorpus [-s <seed>] [-S <size>[K|M|G|T]] [-n <records>]"
+        " [-j <threads>] [-d <name>=<value>,...] [-o <outfile>] O:=} Not");
+    perror(err_msg);
+    return BAD_ARGC;
+  }
+  if ((sh.max_records < 0) && (sh.max_bytes < 0))
+    sh.max_records = 1000;
+  if (sh.max_records < 0)
+    sh.max_records = 1LL<<62;
+  if (sh.max_bytes < 0)
+    sh.max_bytes = 1LL<<62;
+
+  sh.fd = 1;
+  if ((outfile != NULL) &&
+      ((sh.fd = open(outfile, O_WRONLY|O_CREAT|O_TRUNC, 0644)) < 0)) {
+    sprintf(err_msg,"CAN'T OPEN FILE: %s \ncause", outfile);
+    perror(err_msg);
+    return BAD_OUTFILE;
+  }
+  pthread_mutex_init(&sh.lock, NULL);
+  pthread_cond_init(&sh.turn, NULL);
+
+  clock_gettime(CLOCK_MONOTONIC, &t_begin);
+  for (k=0;k<n_threads;k++)
+    pthread_create(&tid[k], NULL, gen_thread, &sh);
+  for (k=0;k<n_threads;k++)
+    pthread_join(tid[k], NULL);
+  clock_gettime(CLOCK_MONOTONIC, &t_end);
+
+  if ((outfile != NULL) && (close(sh.fd) < 0)) {
+    perror("gencorpus: close");
+    sh.failed = 1;
+  }
+  pthread_mutex_destroy(&sh.lock);
+  pthread_cond_destroy(&sh.turn);
+  secs = (t_end.tv_sec - t_begin.tv_sec) + (t_end.tv_nsec - t_begin.tv_nsec) / 1e9;
+  fprintf(stderr, "gencorpus: %lld entries, %lld bytes in %.3f sec (%.1f MB/s)\n",
+          sh.records, sh.bytes, secs, secs > 0 ? sh.bytes / secs / (1<<20) : 0.0);
+  return sh.failed ? BAD_WRITE : GOOD_EXIT;
+} //----- int main (int argc, char *argv[]) -----//
@@ -0,0 +1,458 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/*********************************************************************
+ *
+ *  IOBENCH -- how fast can a UniProt flat file be split into lines?
+ *
+ *  Supersedes demog_script_friendly (read + lseek) and demog_gets_sf
+ *  (fgets).  Every reader strategy does the same work, counting
+ *  lines and the longest line, so the lines and max_line columns
+ *  must agree across the whole CSV:
+ *
+ *    read     lseek + read() of blocksize blocks, byte loop (as promog)
+ *    fgets    stdio with a blocksize buffer
+ *    getline  stdio with a blocksize buffer
+ *    mmap     the whole file mapped, memchr() per line (no blocksize)
+ *    double   a reader thread fills one block while the other is split
+ *    simd     read() blocks, newlines found 32 bytes at a time
+ *
+ *  Each strategy and block size gets -w warmup runs and -n timed
+ *  runs; the CSV has the median and p95 seconds and the median
+ *  MB/s.  -c drops the file from the page cache before every run
+ *  with posix_fadvise(DONTNEED), for cold-cache numbers.
+ *
+ *********************************************************************/
+
+#define MAX_REPS     1000
+#define STRATEGIES   6
+
+typedef char nl_vec __attribute__ ((vector_size (32)));
+
+struct bench_result {
+  long long lines, max_line;
+};
+
+struct line_state {
+  long long lines, max_line, cur;
+};
+
+static const char *STRATEGY_NAMES_ARRAY[STRATEGIES] = {"read", "fgets", "getline",
+             "mmap", "double", "simd"};
+
+
+static void split_bytes (struct line_state *ls, const char *p, long long n) {
+/*****************************************************************
+ *  The reference splitter: one byte at a time
+ *****************************************************************/
+  long long i;
+
+  for (i=0;i<n;i++) {
+    if (p[i] == '\n') {
+      ls->lines++;
+      if (ls->cur > ls->max_line)
+        ls->max_line = ls->cur;
+      ls->cur = 0;
+    }
+    else
+      ls->cur++;
+  }
+}
+
+static void split_vector (struct line_state *ls, const char *p, long long n) {
+/*****************************************************************
+ *  32 bytes per compare; the 0/-1 lanes are packed into a bit
+ *  per byte and the newlines walked with ctz, so short lines
+ *  cost one step each rather than a byte loop
+ *****************************************************************/
+  const nl_vec NL = {'\n','\n','\n','\n','\n','\n','\n','\n','\n','\n','\n','\n',
+                     '\n','\n','\n','\n','\n','\n','\n','\n','\n','\n','\n','\n',
+                     '\n','\n','\n','\n','\n','\n','\n','\n'};
+  nl_vec v, eq;
+  unsigned long long w[4], mask;
+  long long i = 0, last = -1, pos;
+  int k;
+
+  for (;i+32<=n;i+=32) {
+    memcpy(&v, p + i, 32);
+    eq = (v == NL);
+    memcpy(w, &eq, 32);
+    mask = 0;
+    for (k=0;k<4;k++)
+      mask |= (((w[k] & 0x8080808080808080ULL) * 0x0002040810204081ULL) >> 56) << (8*k);
+    while (mask) {
+      pos = i + __builtin_ctzll(mask);
+      ls->cur += pos - last - 1;
+      ls->lines++;
+      if (ls->cur > ls->max_line)
+        ls->max_line = ls->cur;
+      ls->cur = 0;
+      last = pos;
+      mask &= mask - 1;
+    }
+  }
+  ls->cur += i - last - 1;
+  split_bytes(ls, p + i, n - i);
+}
+
+static void finish (struct line_state *ls, struct bench_result *r) {
+  if (ls->cur > 0) {
+    /*  unterminated last line  */
+    ls->lines++;
+    if (ls->cur > ls->max_line)
+      ls->max_line = ls->cur;
+  }
+  r->lines = ls->lines;
+  r->max_line = ls->max_line;
+}
+
+
+static int bench_read (const char *path, int blocksize, int vector, struct bench_result *r) {
+  struct line_state ls = {0, 0, 0};
+  long long this_seek = 0;
+  char *block = valloc(blocksize);
+  int fd, bytes_read;
+
+  if ((fd = open(path, O_RDONLY)) < 0)
+    return -1;
+  for (;;) {
+    lseek(fd, (off_t) this_seek, SEEK_SET);
+    if ((bytes_read = read(fd, block, blocksize)) <= 0)
+      break;
+    if (vector)
+      split_vector(&ls, block, bytes_read);
+    else
+      split_bytes(&ls, block, bytes_read);
+    this_seek += bytes_read;
+  }
+  close(fd);
+  free(block);
+  finish(&ls, r);
+  return 0;
+}
+
+static int bench_fgets (const char *path, int blocksize, struct bench_result *r) {
+  struct line_state ls = {0, 0, 0};
+  char line[1<<16];
+  int len;
+  FILE *fp;
+
+  if ((fp = fopen(path, "r")) == NULL)
+    return -1;
+  setvbuf(fp, NULL, _IOFBF, blocksize);
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    len = strlen(line);
+    if (line[len-1] == '\n') {
+      ls.cur += len - 1;
+      ls.lines++;
+      if (ls.cur > ls.max_line)
+        ls.max_line = ls.cur;
+      ls.cur = 0;
+    }
+    else
+      ls.cur += len;
+  }
+  fclose(fp);
+  finish(&ls, r);
+  return 0;
+}
+
+static int bench_getline (const char *path, int blocksize, struct bench_result *r) {
+  struct line_state ls = {0, 0, 0};
+  char *line = NULL;
+  size_t cap = 0;
+  ssize_t len;
+  FILE *fp;
+
+  if ((fp = fopen(path, "r")) == NULL)
+    return -1;
+  setvbuf(fp, NULL, _IOFBF, blocksize);
+  while ((len = getline(&line, &cap, fp)) > 0) {
+    if (line[len-1] == '\n') {
+      ls.lines++;
+      if (len - 1 > ls.max_line)
+        ls.max_line = len - 1;
+    }
+    else
+      ls.cur = len;
+  }
+  free(line);
+  fclose(fp);
+  finish(&ls, r);
+  return 0;
+}
+
+static int bench_mmap (const char *path, struct bench_result *r) {
+  struct line_state ls = {0, 0, 0};
+  struct stat sb;
+  const char *map, *p, *end, *nl;
+  int fd;
+
+  if (((fd = open(path, O_RDONLY)) < 0) || (fstat(fd, &sb) < 0))
+    return -1;
+  if (sb.st_size > 0) {
+    if ((map = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED) {
+      close(fd);
+      return -1;
+    }
+    madvise((void *)map, sb.st_size, MADV_SEQUENTIAL);
+    end = map + sb.st_size;
+    for (p = map; (nl = memchr(p, '\n', end - p)) != NULL; p = nl + 1) {
+      ls.lines++;
+      if (nl - p > ls.max_line)
+        ls.max_line = nl - p;
+    }
+    ls.cur = end - p;
+    munmap((void *)map, sb.st_size);
+  }
+  close(fd);
+  finish(&ls, r);
+  return 0;
+}
+
+
+/*********************************************************************
+ *  double: two blocks handed back and forth between a reader
+ *  thread and the splitter
+ *********************************************************************/
+struct dbuf {
+  int fd, blocksize;
+  char *block[2];
+  int len[2];                   /* bytes in block, 0 at EOF; -1 while empty */
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+};
+
+static void * dbuf_reader (void *arg) {
+  struct dbuf *d = arg;
+  int k = 0, n;
+
+  do {
+    pthread_mutex_lock(&d->lock);
+    while (d->len[k] >= 0)
+      pthread_cond_wait(&d->cond, &d->lock);
+    pthread_mutex_unlock(&d->lock);
+    n = read(d->fd, d->block[k], d->blocksize);
+    pthread_mutex_lock(&d->lock);
+    d->len[k] = (n > 0) ? n : 0;
+    pthread_cond_broadcast(&d->cond);
+    pthread_mutex_unlock(&d->lock);
+    k ^= 1;
+  } while (n > 0);
+  return NULL;
+}
+
+static int bench_double (const char *path, int blocksize, struct bench_result *r) {
+  struct line_state ls = {0, 0, 0};
+  struct dbuf d;
+  pthread_t tid;
+  int k = 0, n;
+
+  if ((d.fd = open(path, O_RDONLY)) < 0)
+    return -1;
+  d.blocksize = blocksize;
+  d.block[0] = valloc(blocksize);
+  d.block[1] = valloc(blocksize);
+  d.len[0] = d.len[1] = -1;
+  pthread_mutex_init(&d.lock, NULL);
+  pthread_cond_init(&d.cond, NULL);
+  pthread_create(&tid, NULL, dbuf_reader, &d);
+  for (;;) {
+    pthread_mutex_lock(&d.lock);
+    while (d.len[k] < 0)
+      pthread_cond_wait(&d.cond, &d.lock);
+    n = d.len[k];
+    pthread_mutex_unlock(&d.lock);
+    if (n == 0)
+      break;
+    split_bytes(&ls, d.block[k], n);
+    pthread_mutex_lock(&d.lock);
+    d.len[k] = -1;
+    pthread_cond_broadcast(&d.cond);
+    pthread_mutex_unlock(&d.lock);
+    k ^= 1;
+  }
+  pthread_join(tid, NULL);
+  pthread_mutex_destroy(&d.lock);
+  pthread_cond_destroy(&d.cond);
+  free(d.block[0]);
+  free(d.block[1]);
+  close(d.fd);
+  finish(&ls, r);
+  return 0;
+} //----- bench_double -----//
+
+
+static int run_strategy (int s, const char *path, int blocksize, struct bench_result *r) {
+  switch (s) {
+    case 0: return bench_read(path, blocksize, 0, r);
+    case 1: return bench_fgets(path, blocksize, r);
+    case 2: return bench_getline(path, blocksize, r);
+    case 3: return bench_mmap(path, r);
+    case 4: return bench_double(path, blocksize, r);
+    case 5: return bench_read(path, blocksize, 1, r);
+  }
+  return -1;
+}
+
+static void drop_cache (const char *path) {
+  int fd;
+
+  if ((fd = open(path, O_RDONLY)) >= 0) {
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+  }
+}
+
+static int compare_double (const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+
+  return (x > y) - (x < y);
+}
+
+static double seconds (void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+
+int main (int argc, char *argv[]) {
+
+  const int GOOD_EXIT  = 0;
+  const int  FALSE   = 0;
+  const int  TRUE =  1;
+  const int  BAD_ARGC  = -1;
+  const int BAD_DATAFILE  = -2 ;
+
+  int reps = 5, warmup = 1, cold = FALSE, lo_log = 12, hi_log = 22;
+  int use[STRATEGIES], s, b, i, opt, blocksize;
+  double t[MAX_REPS], t0, median, p95;
+  struct bench_result r, first;
+  int have_first = FALSE, mismatch = FALSE;
+  char *tok, *save, err_msg[256];
+  struct stat statbuf;
+
+  for (s=0;s<STRATEGIES;s++)
+    use[s] = TRUE;
+  while ((opt = getopt(argc,argv,"n:w:cs:b:")) != EOF) {
+    switch (opt) {
+      case 'n':
+        reps = atoi(optarg);
+        break;
+      case 'w':
+        warmup = atoi(optarg);
+        break;
+      case 'c':
+        cold = TRUE;
+        break;
+      case 's':
+        for (s=0;s<STRATEGIES;s++)
+          use[s] = FALSE;
+        for (tok = strtok_r(optarg, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+          for (s=0;s<STRATEGIES;s++)
+            if (!strcmp(tok, STRATEGY_NAMES_ARRAY[s]))
+              use[s] = TRUE;
+        }
+        break;
+      case 'b':
+        if (sscanf(optarg, "%d:%d", &lo_log, &hi_log) == 1)
+          hi_log = lo_log;
+        break;
+      case '?':
+        sprintf(err_msg,"invalid option to %s:",argv[0]);
+        perror(err_msg);
+    }//--- switch (opt) ---//
+  }
+  if ((optind >= argc) || (reps < 1) || (reps > MAX_REPS) || (lo_log < 9) ||
+      (hi_log > 30) || (lo_log > hi_log)) {
+    sprintf(err_msg,"USAGE: iobench [-n <reps>] [-w <warmup>] [-c]"
+        " [-s read,fgets,getline,mmap,double,simd]\n"
+        "               [-b <log2 min block>:<log2 max block>] <datafile> O:=} Not");
+    perror(err_msg);
+    return BAD_ARGC;
+  }
+  if (stat(argv[optind], &statbuf) < 0) {
+    sprintf(err_msg,"CAN'T OPEN FILE: %s \ncause", argv[optind]);
+    perror(err_msg);
+    return BAD_DATAFILE;
+  }
+
+  printf("strategy,blocksize,reps,cold,median_sec,p95_sec,mb_per_sec,lines,max_line\n");
+  for (s=0;s<STRATEGIES;s++) {
+    if (!use[s])
+      continue;
+    for (b=lo_log;b<=hi_log;b++) {
+      /*  mmap has no block size: one row  */
+      blocksize = (s == 3) ? 0 : 1<<b;
+      for (i=0;i<warmup;i++)
+        run_strategy(s, argv[optind], blocksize, &r);
+      for (i=0;i<reps;i++) {
+        if (cold)
+          drop_cache(argv[optind]);
+        t0 = seconds();
+        if (run_strategy(s, argv[optind], blocksize, &r) < 0) {
+          sprintf(err_msg,"%s FAILED ON %s \ncause", STRATEGY_NAMES_ARRAY[s], argv[optind]);
+          perror(err_msg);
+          return BAD_DATAFILE;
+        }
+        t[i] = seconds() - t0;
+      }
+      qsort(t, reps, sizeof(double), compare_double);
+      median = (reps % 2) ? t[reps/2] : (t[reps/2-1] + t[reps/2]) / 2;
+      p95 = t[(95*reps + 99)/100 - 1];      /* nearest rank */
+      printf("%s,%d,%d,%d,%.6f,%.6f,%.1f,%lld,%lld\n", STRATEGY_NAMES_ARRAY[s], blocksize,
+          reps, cold, median, p95, statbuf.st_size / median / (1<<20), r.lines, r.max_line);
+      fflush(stdout);
+      if (!have_first) {
+        first = r;
+        have_first = TRUE;
+      }
+      else if ((r.lines != first.lines) || (r.max_line != first.max_line))
+        mismatch = TRUE;
+      if (s == 3)
+        break;
+    }
+  }
+  if (mismatch)
+    fprintf(stderr, "iobench: strategies disagree on lines or max_line\n");
+  return GOOD_EXIT;
+} //----- int main (int argc, char *argv[]) -----//
@@ -0,0 +1,458 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  LIBPROMOG -- promog's parser for other programs
+ *
+ *  An entry view is a span of the caller's own bytes, from the ID
+ *  line through the newline of its // line, with the protein's
+ *  classification beside it.  Nothing is copied out of the entry:
+ *  the accessors below return spans into it, filling arrays the
+ *  caller passes in.
+ *
+ *  Pull: promog_next() takes the next whole entry from a buffer the
+ *  caller owns (a mapped file, a network buffer) and advances *pos,
+ *  or returns 0 without moving when the entry is not all there.
+ *
+ *  Push: promog_push() takes the input in chunks of any size and
+ *  calls back with every entry.  Entries inside one chunk are viewed
+ *  where they lie; only an entry cut by a chunk boundary is gathered
+ *  into the carry buffer, which the caller may supply
+ *  (promog_carry_buffer()) or leave to grow here as needed.
+ *
+ *  Either way a parser does no allocation per entry.  With
+ *  PROMOG_CLASSIFY it compiles the rules once and classifies each
+ *  entry as scan_range() does, line by line through classify_line(),
+ *  so e->rec holds what promog would count for it until the next
+ *  entry.  A parser is for one thread.
+ *
+ *********************************************************************/
+
+struct promog_parser {
+  int classify;
+  struct promog_rules rules;
+  struct prot_record rec;
+  struct metrics met;
+  char *line;                        /* regexec() scratch */
+  int max_line;
+  long long ordinal;
+  char *carry;                       /* an entry cut by a push boundary */
+  long long carry_len, carry_cap, carry_line;
+  int carry_owned;
+};
+
+
+struct promog_parser * promog_parser_new (int flags) {
+  struct promog_parser *ps = calloc(1, sizeof(struct promog_parser));
+
+  ps->classify = ((flags & PROMOG_CLASSIFY) != 0);
+  if ((ps->classify) && (compile_rules(&ps->rules))) {
+    free(ps);
+    return NULL;
+  }
+  if ((ps->classify) && (flags & PROMOG_PREDICT_TM))
+    ps->rules.seq |= SEQ_TM;
+  if ((ps->classify) && (flags & PROMOG_SEQ_STATS))
+    ps->rules.seq |= SEQ_STATS;
+  ps->max_line = getpagesize();
+  ps->line = malloc(ps->max_line + 2);
+  arena_init(&ps->rec.arena, ARENA_BLOCK);
+  metrics_init(&ps->met);
+  ps->carry_owned = 1;
+  return ps;
+}
+
+
+void promog_parser_free (struct promog_parser *ps) {
+  if (ps == NULL)
+    return;
+  if (ps->classify)
+    free_rules(&ps->rules);
+  if (ps->carry_owned)
+    free(ps->carry);
+  arena_free(&ps->rec.arena);
+  free(ps->line);
+  free(ps);
+}
+
+
+void promog_carry_buffer (struct promog_parser *ps, char *buf, long long cap) {
+/*****************************************************************
+ *  Gather cut entries into buf instead; promog_push() fails on an
+ *  entry longer than cap.  Call before the first push.
+ *****************************************************************/
+  if (ps->carry_owned)
+    free(ps->carry);
+  ps->carry = buf;
+  ps->carry_cap = cap;
+  ps->carry_len = ps->carry_line = 0;
+  ps->carry_owned = 0;
+}
+
+
+int promog_next (struct promog_parser *ps, const char *buf, long long len, long long *pos,
+                 struct promog_entry *e) {
+/*****************************************************************
+ *
+ *  The entry at buf[*pos]: 1 and *pos past it, or 0 and *pos as
+ *  it was if buf ends before its // line does.  Blank lines before
+ *  an entry are skipped.
+ *
+ *****************************************************************/
+  const char *p, *nl, *end = buf + len;
+  long long at = *pos;
+  int b;
+
+  while ((at < len) && (buf[at] == '\n'))
+    at++;
+  if (at >= len)
+    return 0;
+  if (ps->classify)
+    reset_record(&ps->rec);
+  for (p = buf + at; p < end; p = nl + 1) {
+    if ((nl = memchr(p, '\n', end - p)) == NULL)
+      return 0;
+    b = nl - p;
+    if ((b >= 2) && (p[0] == '/') && (p[1] == '/')) {
+      if (ps->classify) {
+        classify_end(&ps->rec);
+        ps->rec.ordinal = ps->ordinal;
+      }
+      e->p = buf + at;
+      e->len = nl + 1 - e->p;
+      e->ordinal = ps->ordinal++;
+      e->rec = ps->classify ? &ps->rec : NULL;
+      *pos = nl + 1 - buf;
+      return 1;
+    }
+    if ((ps->classify) && (b >= 2))
+      classify_line(&ps->rec, &ps->rules, p, (b < ps->max_line) ? b : ps->max_line - 2,
+                    ps->line, &ps->met);
+  }
+  return 0;
+} //----- promog_next -----//
+
+
+static int carry_append (struct promog_parser *ps, const char *data, long long n) {
+  long long cap;
+
+  if (ps->carry_len + n > ps->carry_cap) {
+    if (!ps->carry_owned) {
+      fprintf(stderr, "CAN'T CARRY AN ENTRY OF OVER %lld BYTES\n", ps->carry_cap);
+      return -1;
+    }
+    for (cap=ps->carry_cap ? ps->carry_cap : 1<<16;cap<ps->carry_len+n;cap*=2)
+      ;
+    ps->carry = realloc(ps->carry, cap);
+    ps->carry_cap = cap;
+  }
+  memcpy(ps->carry + ps->carry_len, data, n);
+  ps->carry_len += n;
+  return 0;
+}
+
+
+int promog_push (struct promog_parser *ps, const char *data, long long len,
+                 promog_entry_fn fn, void *arg) {
+/*****************************************************************
+ *
+ *  The next len bytes of input.  fn sees every entry they finish;
+ *  a nonzero return from fn stops the push and is returned (the
+ *  rest of the chunk is dropped).  -1 if a caller's carry buffer
+ *  is too small.
+ *
+ *****************************************************************/
+  struct promog_entry e;
+  const char *nl;
+  long long pos = 0, at;
+  int status;
+
+  /*  first finish an entry carried over from the last chunk, a line at a time  */
+  while ((ps->carry_len > 0) && (pos < len)) {
+    nl = memchr(data + pos, '\n', len - pos);
+    at = nl ? nl + 1 - data : len;
+    if (carry_append(ps, data + pos, at - pos) < 0)
+      return -1;
+    pos = at;
+    if (nl == NULL)
+      break;
+    if ((ps->carry_len - ps->carry_line >= 3) && (ps->carry[ps->carry_line] == '/') &&
+        (ps->carry[ps->carry_line+1] == '/')) {
+      at = 0;
+      if ((promog_next(ps, ps->carry, ps->carry_len, &at, &e) == 1) &&
+          ((status = fn(&e, arg)) != 0)) {
+        ps->carry_len = ps->carry_line = 0;
+        return status;
+      }
+      ps->carry_len = ps->carry_line = 0;
+      break;
+    }
+    ps->carry_line = ps->carry_len;
+  }
+  if (ps->carry_len > 0)
+    return 0;
+
+  /*  then every whole entry in place  */
+  while (promog_next(ps, data, len, &pos, &e) == 1)
+    if ((status = fn(&e, arg)) != 0)
+      return status;
+
+  /*  and keep the start of the next  */
+  for (at=len;(at>pos)&&(data[at-1]!='\n');at--)
+    ;
+  if (carry_append(ps, data + pos, len - pos) < 0)
+    return -1;
+  ps->carry_line = at - pos;
+  return 0;
+} //----- promog_push -----//
+
+
+int promog_push_end (struct promog_parser *ps) {
+/*****************************************************************
+ *  End of input: -1 if it stopped inside an entry
+ *****************************************************************/
+  long long i;
+  int status = 0;
+
+  for (i=0;i<ps->carry_len;i++)
+    if (ps->carry[i] != '\n')
+      status = -1;
+  ps->carry_len = ps->carry_line = 0;
+  return status;
+}
+
+
+/*********************************************************************
+ *
+ *  Accessors.  Line spans leave out the two letter code and the
+ *  three blanks after it, and the newline.  Those that fill an
+ *  array return how many there are, which may be more than max;
+ *  only the first max are stored.
+ *
+ *********************************************************************/
+static int next_line (const struct promog_entry *e, long long *at, struct promog_span *line) {
+  const char *p = e->p + *at, *nl;
+
+  if (*at >= e->len)
+    return 0;
+  nl = memchr(p, '\n', e->len - *at);
+  line->p = p;
+  line->len = nl ? nl - p : e->len - *at;
+  *at += line->len + 1;
+  return 1;
+}
+
+static struct promog_span tail (struct promog_span line) {
+  struct promog_span t;
+
+  t.p = line.p + ((line.len > 5) ? 5 : line.len);
+  t.len = (line.len > 5) ? line.len - 5 : 0;
+  return t;
+}
+
+static int is_code (struct promog_span line, const char *code) {
+  return (line.len >= 2) && (line.p[0] == code[0]) && (line.p[1] == code[1]);
+}
+
+
+int promog_lines (const struct promog_entry *e, const char *code, struct promog_span *out,
+                  int max) {
+  struct promog_span line;
+  long long at = 0;
+  int n = 0;
+
+  while (next_line(e, &at, &line))
+    if (is_code(line, code)) {
+      if (n < max)
+        out[n] = tail(line);
+      n++;
+    }
+  return n;
+}
+
+
+struct promog_span promog_ac (const struct promog_entry *e) {
+/*****************************************************************
+ *  The primary accession, the first on the first AC line
+ *****************************************************************/
+  struct promog_span s;
+  int i;
+
+  if (promog_lines(e, "AC", &s, 1) == 0)
+    return s;
+  for (i=0;(i<s.len)&&(s.p[i]!=';');i++)
+    ;
+  s.len = i;
+  return s;
+}
+
+
+struct promog_span promog_os (const struct promog_entry *e) {
+/*****************************************************************
+ *  The species, without the common name or final period
+ *****************************************************************/
+  struct promog_span s;
+  int i;
+
+  if (promog_lines(e, "OS", &s, 1) == 0)
+    return s;
+  for (i=0;(i<s.len)&&(s.p[i]!='.')&&(!((s.p[i]==' ')&&(i+1<s.len)&&(s.p[i+1]=='(')));i++)
+    ;
+  s.len = i;
+  return s;
+}
+
+
+int promog_ox (const struct promog_entry *e) {
+/*****************************************************************
+ *  The NCBI taxon, 0 if there is none
+ *****************************************************************/
+  struct promog_span s;
+  int i, taxid = 0;
+
+  if ((promog_lines(e, "OX", &s, 1) == 0) || (s.len < 12) || (strncmp(s.p, "NCBI_TaxID=", 11)))
+    return 0;
+  for (i=11;(i<s.len)&&(s.p[i]>='0')&&(s.p[i]<='9');i++)
+    taxid = 10*taxid + (s.p[i] - '0');
+  return taxid;
+}
+
+
+int promog_ft (const struct promog_entry *e, struct promog_feature *out, int max) {
+/*****************************************************************
+ *  Every feature: its key and location ("TRANSMEM", "40..60");
+ *  continuation lines (qualifiers) are skipped
+ *****************************************************************/
+  struct promog_span line, s;
+  long long at = 0;
+  int i, j, n = 0;
+
+  while (next_line(e, &at, &line)) {
+    if ((!is_code(line, "FT")) || ((s = tail(line)).len == 0) || (s.p[0] == ' '))
+      continue;
+    if (n < max) {
+      for (i=0;(i<s.len)&&(s.p[i]!=' ');i++)
+        ;
+      out[n].key.p = s.p;
+      out[n].key.len = i;
+      for (;(i<s.len)&&(s.p[i]==' ');i++)
+        ;
+      for (j=i;(j<s.len)&&(s.p[j]!=' ');j++)
+        ;
+      out[n].location.p = s.p + i;
+      out[n].location.len = j - i;
+    }
+    n++;
+  }
+  return n;
+} //----- promog_ft -----//
+
+
+int promog_cc (const struct promog_entry *e, const char *topic, struct promog_span *out,
+               int max) {
+/*****************************************************************
+ *  The CC lines of one topic ("SUBCELLULAR LOCATION"), from its
+ *  -!- line to the next topic or the copyright, or all of them if
+ *  topic is NULL
+ *****************************************************************/
+  struct promog_span line, s;
+  long long at = 0;
+  int n = 0, in = (topic == NULL), len = topic ? strlen(topic) : 0;
+
+  while (next_line(e, &at, &line)) {
+    if (!is_code(line, "CC"))
+      continue;
+    s = tail(line);
+    if ((topic != NULL) && (s.len >= 3) && (s.p[0] == '-') && (s.p[2] == '-'))
+      in = (s.len > 4 + len) && (s.p[1] == '!') && (!strncmp(s.p + 4, topic, len)) &&
+           (s.p[4+len] == ':');
+    if (in) {
+      if (n < max)
+        out[n] = s;
+      n++;
+    }
+  }
+  return n;
+} //----- promog_cc -----//
+
+
+int promog_dr (const struct promog_entry *e, const char *db, struct promog_span *out, int max) {
+/*****************************************************************
+ *  The cross-references to one database ("GO"), or all if NULL
+ *****************************************************************/
+  struct promog_span line, s;
+  long long at = 0;
+  int n = 0, len = db ? strlen(db) : 0;
+
+  while (next_line(e, &at, &line)) {
+    if (!is_code(line, "DR"))
+      continue;
+    s = tail(line);
+    if ((db != NULL) && ((s.len <= len) || (strncmp(s.p, db, len)) || (s.p[len] != ';')))
+      continue;
+    if (n < max)
+      out[n] = s;
+    n++;
+  }
+  return n;
+}
+
+
+int promog_sq (const struct promog_entry *e, int *length, struct promog_span *out, int max) {
+/*****************************************************************
+ *  The sequence lines, residues in blocks of ten as in the file,
+ *  and in *length the residue count of the SQ line
+ *****************************************************************/
+  struct promog_span line, s;
+  long long at = 0;
+  int i, n = 0, in = 0;
+
+  *length = 0;
+  while (next_line(e, &at, &line)) {
+    if (is_code(line, "SQ")) {
+      s = tail(line);
+      for (i=0;(i<s.len)&&((s.p[i]<'0')||(s.p[i]>'9'));i++)
+        ;
+      for (;(i<s.len)&&(s.p[i]>='0')&&(s.p[i]<='9');i++)
+        *length = 10*(*length) + (s.p[i] - '0');
+      in = 1;
+      continue;
+    }
+    if ((!in) || (line.len < 5) || (line.p[0] != ' '))
+      continue;
+    if (n < max)
+      out[n] = tail(line);
+    n++;
+  }
+  return n;
+} //----- promog_sq -----//
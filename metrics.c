@@ -0,0 +1,279 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  METRICS -- where the time goes
+ *
+ *  Each phase keeps a tick count, process CPU seconds and byte,
+ *  record and line counters.  The main thread brackets setup, scan,
+ *  merge, output and render with metrics_begin()/metrics_end().
+ *  scan_range() adds metrics_ticks() deltas straight into its own
+ *  thread's read, match and aggregate phases, and charges the rest
+ *  of its time to split; the per-thread metrics are then merged,
+ *  so those four are thread-seconds rather than wall time (and,
+ *  with more threads than CPUs, include time spent descheduled).
+ *
+ *  With --perf-counters, m->pc is set and the main thread phases
+ *  also collect the perfctr.c hardware counters, reported per MB of
+ *  input.  The scan threads' hot-loop phases are not split out:
+ *  reading a counter is a system call, too dear per line.
+ *
+ *  The arena line is the most memory the process's arenas (arena.c)
+ *  held at once: records' strings and the interned names of cubes,
+ *  indexes and exports, over all threads.
+ *
+ *  Ticks are TSC cycles on x86 and nanoseconds elsewhere; they are
+ *  converted against CLOCK_MONOTONIC only when reported, so the hot
+ *  loop pays for an rdtsc and an add.
+ *
+ *********************************************************************/
+
+static const char *METRICS_NAMES_ARRAY[MX_COUNT] = {"setup", "scan", "read", "split",
+             "match", "aggregate", "merge", "output", "render"};
+
+static pthread_once_t calibrate_once = PTHREAD_ONCE_INIT;
+static unsigned long long tick0;
+static double mono0;
+
+static double mono_now (void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static double cpu_now (void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void calibrate_start (void) {
+  tick0 = metrics_ticks();
+  mono0 = mono_now();
+}
+
+void metrics_init (struct metrics *m) {
+  int i, j;
+
+  pthread_once(&calibrate_once, calibrate_start);
+  memset(m, 0, sizeof(*m));
+  for (i=0;i<MX_COUNT;i++) {
+    m->ph[i].cpu = -1;
+    for (j=0;j<PC_COUNT;j++)
+      m->ph[i].hw[j] = -1;
+  }
+}
+
+void metrics_begin (struct metrics *m, int phase) {
+  m->ph[phase].t0 = metrics_ticks();
+  m->ph[phase].c0 = cpu_now();
+  if (m->pc != NULL)
+    perfctr_read(m->pc, m->ph[phase].hw0);
+}
+
+void metrics_end (struct metrics *m, int phase) {
+  struct metrics_phase *p = &m->ph[phase];
+  long long hw[PC_COUNT];
+  int j;
+
+  if (m->pc != NULL) {
+    perfctr_read(m->pc, hw);
+    for (j=0;j<PC_COUNT;j++)
+      if ((hw[j] >= 0) && (p->hw0[j] >= 0))
+        p->hw[j] = ((p->hw[j] < 0) ? 0 : p->hw[j]) + hw[j] - p->hw0[j];
+  }
+  p->ticks += metrics_ticks() - p->t0;
+  p->cpu = ((p->cpu < 0) ? 0 : p->cpu) + cpu_now() - p->c0;
+}
+
+void metrics_merge (struct metrics *dst, const struct metrics *src) {
+  int i;
+
+  for (i=0;i<MX_COUNT;i++) {
+    dst->ph[i].ticks += src->ph[i].ticks;
+    dst->ph[i].bytes += src->ph[i].bytes;
+    dst->ph[i].records += src->ph[i].records;
+    dst->ph[i].lines += src->ph[i].lines;
+    if (src->ph[i].cpu >= 0)
+      dst->ph[i].cpu = ((dst->ph[i].cpu < 0) ? 0 : dst->ph[i].cpu) + src->ph[i].cpu;
+  }
+}
+
+double metrics_seconds (unsigned long long ticks) {
+/*****************************************************************
+ *  Ticks to seconds, against at least 10 msec of CLOCK_MONOTONIC
+ *****************************************************************/
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned long long t;
+  double sec;
+
+  pthread_once(&calibrate_once, calibrate_start);
+  while ((sec = mono_now() - mono0) < 0.01)
+    ;
+  t = metrics_ticks() - tick0;
+  return (t > 0) ? ticks * (sec / t) : 0;
+#else
+  return ticks / 1e9;
+#endif
+}
+
+
+void metrics_interval (FILE *fp, long long nsec) {
+/*****************************************************************
+ *  An interval in the three significant decimals and unit that
+ *  print_interval() used: " 12.345 msec"
+ *****************************************************************/
+  static const char *UNITS_ARRAY[4] = {"nsec", "usec", "msec", "sec"};
+  long long whole = nsec, frac = 0;
+  int u = 0;
+
+  if (nsec < 1000) {
+    fprintf(fp, " %lld nsec", nsec);
+    return;
+  }
+  while ((u < 3) && (whole >= 1000)) {
+    frac = whole % 1000;
+    whole /= 1000;
+    u++;
+  }
+  fprintf(fp, " %lld.%03lld %s", whole, frac, UNITS_ARRAY[u]);
+}
+
+
+static double rate (long long n, double sec) {
+  return ((n > 0) && (sec > 0)) ? n / sec : -1;
+}
+
+static void print_ratio (FILE *fp, const char *fmt, long long n, long long d, double scale) {
+  if ((n >= 0) && (d > 0))
+    fprintf(fp, fmt, n * scale / d);
+  else
+    fprintf(fp, "%12s ", "-");
+}
+
+static void metrics_print_perf (const struct metrics *m, FILE *fp) {
+/*****************************************************************
+ *  IPC, branch-miss rate, and cycles and cache misses per MB of
+ *  input, for the phases that were counted
+ *****************************************************************/
+  const struct metrics_phase *p;
+  long long mb_bytes = m->ph[MX_SCAN].bytes;
+  int i;
+
+  fprintf(fp, "--------PERF COUNTERS--------------------\n");
+  fprintf(fp, "%-10s %12s %12s %12s %12s %12s\n", "phase", "cycles/MB", "instr/MB",
+          "IPC", "br_miss_%", "llc_miss/MB");
+  for (i=0;i<MX_COUNT;i++) {
+    p = &m->ph[i];
+    if ((p->hw[PC_CYCLES] < 0) && (p->hw[PC_INSTRUCTIONS] < 0))
+      continue;
+    fprintf(fp, "%-10s ", METRICS_NAMES_ARRAY[i]);
+    print_ratio(fp, "%12.0f ", p->hw[PC_CYCLES], mb_bytes, 1<<20);
+    print_ratio(fp, "%12.0f ", p->hw[PC_INSTRUCTIONS], mb_bytes, 1<<20);
+    print_ratio(fp, "%12.3f ", p->hw[PC_INSTRUCTIONS], p->hw[PC_CYCLES], 1);
+    print_ratio(fp, "%12.3f ", p->hw[PC_BRANCH_MISSES], p->hw[PC_BRANCHES], 100);
+    print_ratio(fp, "%12.1f ", p->hw[PC_CACHE_MISSES], mb_bytes, 1<<20);
+    fprintf(fp, "\n");
+  }
+  fprintf(fp, "(per MB of input; user space only, scan threads included)\n");
+  fprintf(fp, "----------------------------------------\n");
+} //----- metrics_print_perf (const struct metrics *m, FILE *fp) -----//
+
+void metrics_print (const struct metrics *m, FILE *fp) {
+  long long now, peak;
+  double sec, r;
+  int i;
+
+  fprintf(fp, "--------METRICS--------------------------\n");
+  fprintf(fp, "%-10s %10s %10s %10s %12s %12s\n", "phase", "sec", "cpu_sec",
+          "MB/s", "records/s", "lines");
+  for (i=0;i<MX_COUNT;i++) {
+    sec = metrics_seconds(m->ph[i].ticks);
+    fprintf(fp, "%-10s %10.6f ", METRICS_NAMES_ARRAY[i], sec);
+    if (m->ph[i].cpu >= 0)
+      fprintf(fp, "%10.6f ", m->ph[i].cpu);
+    else
+      fprintf(fp, "%10s ", "-");
+    if ((r = rate(m->ph[i].bytes, sec)) >= 0)
+      fprintf(fp, "%10.1f ", r / (1<<20));
+    else
+      fprintf(fp, "%10s ", "-");
+    if ((r = rate(m->ph[i].records, sec)) >= 0)
+      fprintf(fp, "%12.0f ", r);
+    else
+      fprintf(fp, "%12s ", "-");
+    fprintf(fp, "%12lld\n", m->ph[i].lines);
+  }
+  arena_stats(&now, &peak);
+  fprintf(fp, "%-10s %10.1f KB peak in blocks, %.1f KB now\n", "arena", peak / 1024.0,
+          now / 1024.0);
+  fprintf(fp, "(read, split, match and aggregate are summed over scan threads,\n"
+              " including any time those threads spent descheduled)\n");
+  fprintf(fp, "----------------------------------------\n");
+  if (m->pc != NULL)
+    metrics_print_perf(m, fp);
+} //----- metrics_print (const struct metrics *m, FILE *fp) -----//
+
+void metrics_print_json (const struct metrics *m, FILE *fp) {
+  long long now, peak;
+  double sec, r;
+  int i, j;
+
+  fprintf(fp, "{\"phases\": [");
+  for (i=0;i<MX_COUNT;i++) {
+    sec = metrics_seconds(m->ph[i].ticks);
+    fprintf(fp, "%s\n  {\"phase\": \"%s\", \"sec\": %.6f, \"cpu_sec\": ",
+            i ? "," : "", METRICS_NAMES_ARRAY[i], sec);
+    if (m->ph[i].cpu >= 0)
+      fprintf(fp, "%.6f", m->ph[i].cpu);
+    else
+      fprintf(fp, "null");
+    fprintf(fp, ", \"bytes\": %lld, \"records\": %lld, \"lines\": %lld",
+            m->ph[i].bytes, m->ph[i].records, m->ph[i].lines);
+    if ((r = rate(m->ph[i].bytes, sec)) >= 0)
+      fprintf(fp, ", \"mb_per_sec\": %.3f", r / (1<<20));
+    if ((r = rate(m->ph[i].records, sec)) >= 0)
+      fprintf(fp, ", \"records_per_sec\": %.1f", r);
+    if ((m->pc != NULL) && (m->ph[i].hw[PC_CYCLES] >= 0)) {
+      fprintf(fp, ", \"perf\": {");
+      for (j=0;j<PC_COUNT;j++)
+        fprintf(fp, "%s\"%s\": %lld", j ? ", " : "", perfctr_name(j), m->ph[i].hw[j]);
+      fprintf(fp, "}");
+    }
+    fprintf(fp, "}");
+  }
+  arena_stats(&now, &peak);
+  fprintf(fp, "\n], \"arena\": {\"peak_bytes\": %lld, \"bytes\": %lld}}\n", peak, now);
+} //----- metrics_print_json (const struct metrics *m, FILE *fp) -----//
@@ -0,0 +1,193 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  PARTIAL -- the mergeable result of one --range shard
+ *
+ *  promog --range=START:END --partial=<file> scans only the entries
+ *  that start in [START,END) (both snapped forward to entry starts
+ *  with snap_to_record(), so neighbouring shards meet exactly) and
+ *  saves its counters and cubes here.  promog-merge adds any number
+ *  of partials of one datafile back into the whole-file report.
+ *
+ *  The key is the result cache's, with the device and inode zeroed:
+ *  shards run on different nodes see the same file under different
+ *  ones.  Size, mtime, rules and cube specs must still agree.
+ *
+ *  The file: "PROMOGPT", version, struct cache_key, long long start
+ *  and end (the snapped range; end is LLONG_MAX for the last shard),
+ *  struct partial_counts, int datafile length and the name, int
+ *  n_cubes, crosstab_write() images (the report cube first).
+ *
+ *********************************************************************/
+
+#define PARTIAL_MAGIC     "PROMOGPT"
+#define PARTIAL_VERSION   3
+
+struct partial_counts {
+  long long tot_proteins, line_num, char_count;
+  long long max_line, max_prot_lines, max_prot_chars, corrupt_infile;
+  long long n_threads, blocksize, elapsed_nsec;
+  long long seq;                     /* SEQ_* stages the shard ran */
+};
+
+
+int partial_write (const char *path, const struct cache_key *key, long long start,
+                   long long end, const struct promog_summary *sum) {
+/*****************************************************************
+ *  Written to a temporary name and renamed, so that a merge never
+ *  picks up half a shard
+ *****************************************************************/
+  char tmp[4200];
+  struct cache_key k = *key;
+  struct partial_counts c;
+  int version = PARTIAL_VERSION, n = sum->n_cubes + 1, len, i, bad;
+  FILE *fp;
+
+  k.dev = 0;
+  k.ino = 0;
+  snprintf(tmp, sizeof(tmp), "%s.%d", path, (int)getpid());
+  if ((fp = fopen(tmp, "w")) == NULL) {
+    fprintf(stderr, "CAN'T WRITE PARTIAL FILE: %s\n", tmp);
+    return -1;
+  }
+  memset(&c, 0, sizeof(c));
+  c.tot_proteins = sum->tot_proteins;
+  c.line_num = sum->line_num;
+  c.char_count = sum->char_count;
+  c.max_line = sum->max_line;
+  c.max_prot_lines = sum->max_prot_lines;
+  c.max_prot_chars = sum->max_prot_chars;
+  c.corrupt_infile = sum->corrupt_infile;
+  c.n_threads = sum->n_threads;
+  c.blocksize = sum->blocksize;
+  c.seq = sum->seq;
+  c.elapsed_nsec = (sum->t_end.tv_sec - sum->t_begin.tv_sec) * 1000000000LL
+                   + (sum->t_end.tv_nsec - sum->t_begin.tv_nsec);
+  len = strlen(sum->datafile);
+  fwrite(PARTIAL_MAGIC, 1, 8, fp);
+  fwrite(&version, sizeof(int), 1, fp);
+  fwrite(&k, sizeof(struct cache_key), 1, fp);
+  fwrite(&start, sizeof(long long), 1, fp);
+  fwrite(&end, sizeof(long long), 1, fp);
+  fwrite(&c, sizeof(c), 1, fp);
+  fwrite(&len, sizeof(int), 1, fp);
+  fwrite(sum->datafile, 1, len, fp);
+  fwrite(&n, sizeof(int), 1, fp);
+  bad = crosstab_write(sum->report, fp);
+  for (i=0;i<sum->n_cubes;i++)
+    bad |= crosstab_write(sum->cubes[i], fp);
+  bad |= ferror(fp) | fclose(fp);
+  if (bad || rename(tmp, path)) {
+    fprintf(stderr, "FAILED WRITING PARTIAL FILE: %s\n", path);
+    unlink(tmp);
+    return -1;
+  }
+  return 0;
+} //----- partial_write -----//
+
+
+int partial_read (const char *path, struct cache_key *key, long long *start,
+                  long long *end, struct promog_summary *sum, struct crosstab ***cubes) {
+/*****************************************************************
+ *
+ *  Fill key, the range, and the counters, stages, timing and
+ *  cubes of sum from a partial.  sum->datafile and *cubes (the
+ *  report cube first) are the caller's to free.  -1 if the file
+ *  is missing or damaged.
+ *
+ *****************************************************************/
+  char magic[8], *name;
+  struct partial_counts c;
+  struct crosstab **xt;
+  int version, len, n, i, bad = 0;
+  FILE *fp;
+
+  if ((fp = fopen(path, "r")) == NULL) {
+    fprintf(stderr, "CAN'T OPEN PARTIAL FILE: %s\n", path);
+    return -1;
+  }
+  if ((fread(magic, 1, 8, fp) != 8) || memcmp(magic, PARTIAL_MAGIC, 8) ||
+      (fread(&version, sizeof(int), 1, fp) != 1) || (version != PARTIAL_VERSION) ||
+      (fread(key, sizeof(struct cache_key), 1, fp) != 1) ||
+      (fread(start, sizeof(long long), 1, fp) != 1) ||
+      (fread(end, sizeof(long long), 1, fp) != 1) ||
+      (fread(&c, sizeof(c), 1, fp) != 1) ||
+      (fread(&len, sizeof(int), 1, fp) != 1) || (len < 0) || (len > 4096)) {
+    fprintf(stderr, "NOT A PARTIAL FILE: %s\n", path);
+    fclose(fp);
+    return -1;
+  }
+  name = malloc(len + 1);
+  if ((fread(name, 1, len, fp) != (size_t)len) ||
+      (fread(&n, sizeof(int), 1, fp) != 1) || (n < 1) || (n > 1024)) {
+    fprintf(stderr, "DAMAGED PARTIAL FILE: %s\n", path);
+    free(name);
+    fclose(fp);
+    return -1;
+  }
+  name[len] = '\0';
+  xt = calloc(n, sizeof(struct crosstab *));
+  for (i=0;(!bad)&&(i<n);i++)
+    bad = ((xt[i] = crosstab_read(fp)) == NULL);
+  fclose(fp);
+  if (bad) {
+    fprintf(stderr, "DAMAGED PARTIAL FILE: %s\n", path);
+    for (i=0;i<n;i++)
+      crosstab_free(xt[i]);
+    free(xt);
+    free(name);
+    return -1;
+  }
+
+  sum->datafile = name;
+  sum->n_threads = c.n_threads;
+  sum->blocksize = c.blocksize;
+  sum->seq = c.seq;
+  sum->tot_proteins = c.tot_proteins;
+  sum->line_num = c.line_num;
+  sum->char_count = c.char_count;
+  sum->max_line = c.max_line;
+  sum->max_prot_lines = c.max_prot_lines;
+  sum->max_prot_chars = c.max_prot_chars;
+  sum->corrupt_infile = c.corrupt_infile;
+  sum->t_begin.tv_sec = 0;
+  sum->t_begin.tv_nsec = 0;
+  sum->t_end.tv_sec = c.elapsed_nsec / 1000000000LL;
+  sum->t_end.tv_nsec = c.elapsed_nsec % 1000000000LL;
+  sum->report = xt[0];
+  sum->n_cubes = n - 1;
+  sum->cubes = xt + 1;
+  *cubes = xt;
+  return 0;
+} //----- partial_read -----//
@@ -0,0 +1,123 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  PERFCTR -- hardware counters for --perf-counters
+ *
+ *  One perf_event_open() counter per PC_* event, user space only
+ *  (so perf_event_paranoid up to 2 is enough), opened with inherit
+ *  on the main thread before any scan thread is started: a scan
+ *  thread's counts are folded into the main thread's counters when
+ *  it exits, so a read after pthread_join() covers the whole scan.
+ *
+ *  Counters the machine or kernel will not give us (a VM without a
+ *  PMU, a stricter paranoid setting) read as -1; if none open at
+ *  all perfctr_open() says why and returns NULL, and promog keeps
+ *  to timing only.  Multiplexed counters are scaled by
+ *  enabled/running time.
+ *
+ *********************************************************************/
+
+struct perfctr {
+  int fd[PC_COUNT];
+};
+
+static const char *PERFCTR_NAMES_ARRAY[PC_COUNT] = {"cycles", "instructions",
+             "branches", "branch_misses", "cache_misses"};
+static const unsigned long long PERFCTR_CONFIG_ARRAY[PC_COUNT] = {
+             PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+             PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+             PERF_COUNT_HW_CACHE_MISSES};
+
+
+struct perfctr *perfctr_open (void) {
+  struct perf_event_attr attr;
+  struct perfctr *pc = malloc(sizeof(struct perfctr));
+  int i, n_open = 0, first_errno = 0;
+
+  for (i=0;i<PC_COUNT;i++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERFCTR_CONFIG_ARRAY[i];
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    pc->fd[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (pc->fd[i] >= 0)
+      n_open++;
+    else if (first_errno == 0)
+      first_errno = errno;
+  }
+  if (n_open == 0) {
+    fprintf(stderr, "perf counters unavailable (%s); timing only\n",
+            strerror(first_errno));
+    free(pc);
+    return NULL;
+  }
+  return pc;
+} //----- perfctr_open (void) -----//
+
+void perfctr_read (const struct perfctr *pc, long long *v) {
+  unsigned long long r[3];
+  int i;
+
+  for (i=0;i<PC_COUNT;i++) {
+    v[i] = -1;
+    if ((pc->fd[i] < 0) || (read(pc->fd[i], r, sizeof(r)) != sizeof(r)))
+      continue;
+    if ((r[2] > 0) && (r[2] < r[1]))
+      v[i] = (long long)((double)r[0] * r[1] / r[2]);
+    else
+      v[i] = (long long)r[0];
+  }
+}
+
+const char *perfctr_name (int counter) {
+  return PERFCTR_NAMES_ARRAY[counter];
+}
+
+void perfctr_close (struct perfctr *pc) {
+  int i;
+
+  if (pc == NULL)
+    return;
+  for (i=0;i<PC_COUNT;i++)
+    if (pc->fd[i] >= 0)
+      close(pc->fd[i]);
+  free(pc);
+}
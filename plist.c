@@ -0,0 +1,224 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  PLIST -- the per-protein listing
+ *
+ *  One tab separated line per entry: accession, organism and the
+ *  four compartment flags.  Lines are packed into PLIST_CHUNK byte
+ *  chunks and PLIST_IOV full chunks go out in a single writev(),
+ *  so a scan issues one system call per megabyte of listing.
+ *
+ *  Scanning thread 0 writes straight to the listing.  The others
+ *  write to an unlinked scratch file, which plist_append() copies
+ *  onto the listing after the join, in range order, so the lines
+ *  come out in file order whatever -j is.
+ *
+ *********************************************************************/
+
+#define PLIST_CHUNK   (1<<16)
+#define PLIST_IOV     16
+#define PLIST_LINE    (ACC_WIDTH + ORGANISM_LEN + 16)
+
+struct plist {
+  int fd;
+  int scratch;                  /* fd is a scratch file to be appended */
+  int n;                        /* full chunks waiting */
+  int used;                     /* bytes in chunk[n] */
+  char *chunk[PLIST_IOV];
+  long long bytes;
+  int error;                    /* a write failed: nothing more is written */
+};
+
+static const char *PLIST_HEADER =
+    "accession\torganism\tnuclear\tcytosolic\tmembrane\textracellular\n";
+
+
+static int plist_writev (int fd, struct iovec *iov, int n) {
+/*****************************************************************
+ *  writev() until every byte is out; -1 on error
+ *****************************************************************/
+  ssize_t w;
+
+  while (n > 0) {
+    if ((w = writev(fd, iov, n)) < 0)
+      return -1;
+    while ((n > 0) && (w >= (ssize_t)iov->iov_len)) {
+      w -= iov->iov_len;
+      iov++;
+      n--;
+    }
+    if (n > 0) {
+      iov->iov_base = (char *)iov->iov_base + w;
+      iov->iov_len -= w;
+    }
+  }
+  return 0;
+}
+
+static int plist_flush (struct plist *pl) {
+  struct iovec iov[PLIST_IOV];
+  int i, n = pl->n;
+
+  for (i=0;i<pl->n;i++) {
+    iov[i].iov_base = pl->chunk[i];
+    iov[i].iov_len = PLIST_CHUNK;
+  }
+  if (pl->used) {
+    iov[n].iov_base = pl->chunk[n];
+    iov[n].iov_len = pl->used;
+    n++;
+  }
+  pl->n = pl->used = 0;
+  if (pl->error)
+    return -1;
+  if (n && plist_writev(pl->fd, iov, n)) {
+    perror("FAILED WRITING PROTEIN LIST\ncause");
+    pl->error = 1;
+    return -1;
+  }
+  return 0;
+}
+
+
+struct plist * plist_new (int fd) {
+/*****************************************************************
+ *
+ *  fd >= 0: write the listing, header first, to fd.
+ *  fd <  0: buffer into a scratch file for plist_append().
+ *
+ *****************************************************************/
+  struct plist *pl = calloc(1, sizeof(struct plist));
+  FILE *tmp;
+  int i;
+
+  if (fd < 0) {
+    if (((tmp = tmpfile()) == NULL) || ((fd = dup(fileno(tmp))) < 0)) {
+      perror("CAN'T OPEN PROTEIN LIST SCRATCH FILE\ncause");
+      free(pl);
+      return NULL;
+    }
+    fclose(tmp);
+    pl->scratch = 1;
+  }
+  pl->fd = fd;
+  for (i=0;i<PLIST_IOV;i++)
+    pl->chunk[i] = malloc(PLIST_CHUNK);
+  if (!pl->scratch) {
+    memcpy(pl->chunk[0], PLIST_HEADER, strlen(PLIST_HEADER));
+    pl->used = strlen(PLIST_HEADER);
+  }
+  return pl;
+} //----- plist_new (int fd) -----//
+
+
+void plist_add (struct plist *pl, const struct prot_record *rec) {
+  char line[PLIST_LINE], *p = line;
+  int i, len;
+
+  if (pl->error)
+    return;                     /* plist_close() reports it */
+  for (i=0;(i<ACC_WIDTH)&&(rec->accession[i]);i++)
+    *p++ = rec->accession[i];
+  *p++ = '\t';
+  for (i=0;(i<ORGANISM_LEN)&&(rec->organism[i]);i++)
+    *p++ = rec->organism[i];
+  for (i=0;i<COMP_COUNT;i++) {
+    *p++ = '\t';
+    *p++ = (rec->compartments & (1<<i)) ? '1' : '0';
+  }
+  *p++ = '\n';
+  len = p - line;
+
+  if (pl->used + len > PLIST_CHUNK) {
+    /*  top off this chunk so every queued chunk is exactly full  */
+    i = PLIST_CHUNK - pl->used;
+    memcpy(pl->chunk[pl->n] + pl->used, line, i);
+    pl->bytes += i;
+    if (++pl->n == PLIST_IOV) {
+      pl->used = 0;
+      plist_flush(pl);
+    }
+    memcpy(pl->chunk[pl->n], line + i, len - i);
+    pl->used = len - i;
+    pl->bytes += len - i;
+    return;
+  }
+  memcpy(pl->chunk[pl->n] + pl->used, line, len);
+  pl->used += len;
+  pl->bytes += len;
+} //----- plist_add (struct plist *pl, const struct prot_record *rec) -----//
+
+
+int plist_append (struct plist *dst, struct plist *src) {
+/*****************************************************************
+ *  Copy a scratch listing onto the end of dst
+ *****************************************************************/
+  ssize_t n;
+
+  if ((plist_flush(dst)) || (plist_flush(src)) || (lseek(src->fd, 0, SEEK_SET) < 0)) {
+    dst->error = 1;
+    return -1;
+  }
+  while ((n = read(src->fd, dst->chunk[0], PLIST_CHUNK)) > 0) {
+    dst->used = n;
+    if (plist_flush(dst))
+      return -1;
+  }
+  dst->bytes += src->bytes;
+  if (n < 0)
+    dst->error = 1;
+  return (n < 0) ? -1 : 0;
+}
+
+
+int plist_close (struct plist *pl) {
+/*****************************************************************
+ *  Flush and free; the listing descriptor is left to the caller.
+ *  -1 if any write to the listing failed, here or during the scan.
+ *****************************************************************/
+  int i, status;
+
+  if (pl == NULL)
+    return 0;
+  status = (plist_flush(pl) || pl->error) ? -1 : 0;
+  if (pl->scratch)
+    close(pl->fd);
+  for (i=0;i<PLIST_IOV;i++)
+    free(pl->chunk[i]);
+  free(pl);
+  return status;
+}
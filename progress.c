@@ -0,0 +1,186 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  PROGRESS -- is a long scan moving, and when will it finish?
+ *
+ *  A thread of its own wakes every interval seconds, sums the
+ *  progress_bytes and progress_records each scan thread publishes
+ *  with a relaxed atomic store once per block, and reports bytes
+ *  done, MB/s, records/s and an ETA from the average rate so far.
+ *  The scan threads never wait on it.  After --resume the ranges
+ *  count from their original starts, and the rates and ETA from the
+ *  part this run has done.
+ *
+ *  Reports go to stderr (rewriting one line on a terminal, one
+ *  line per report otherwise), or with --status-file to a file
+ *  that is replaced whole each time by rename(), so that whatever
+ *  reads it never sees half a report:
+ *
+ *    bytes=1234567 total=9876543 percent=12.5 records=4567
+ *    mb_per_sec=61.2 records_per_sec=74862 eta_sec=104 done=0
+ *
+ *********************************************************************/
+
+struct progress {
+  struct scan_state *st;
+  int n_threads, interval, tty;
+  long long total, base;             /* base: done before this run */
+  const char *status_path;
+  struct timespec t0;
+  pthread_t tid;
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  int stop;
+  long long records0;
+};
+
+
+static void progress_report (struct progress *pg, int done) {
+  struct timespec now;
+  char line[512], tmp_path[4096];
+  long long bytes = 0, records = 0, b, range;
+  double sec, mb_s, rec_s, eta;
+  FILE *fp;
+  int k;
+
+  for (k=0;k<pg->n_threads;k++) {
+    b = __atomic_load_n(&pg->st[k].progress_bytes, __ATOMIC_RELAXED);
+    range = ((pg->st[k].end < pg->total) ? pg->st[k].end : pg->total) - pg->st[k].origin;
+    bytes += (b < range) ? b : range;
+    records += __atomic_load_n(&pg->st[k].progress_records, __ATOMIC_RELAXED);
+  }
+  if (done)
+    bytes = pg->total;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  sec = (now.tv_sec - pg->t0.tv_sec) + (now.tv_nsec - pg->t0.tv_nsec) / 1e9;
+  mb_s = (sec > 0) ? (bytes - pg->base) / sec / (1<<20) : 0;
+  rec_s = (sec > 0) ? (records - pg->records0) / sec : 0;
+  eta = (bytes > pg->base) ? (pg->total - bytes) * (sec / (bytes - pg->base)) : -1;
+
+  if (pg->status_path != NULL) {
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", pg->status_path);
+    if ((fp = fopen(tmp_path, "w")) == NULL)
+      return;
+    fprintf(fp, "bytes=%lld total=%lld percent=%.1f records=%lld mb_per_sec=%.1f"
+            " records_per_sec=%.0f eta_sec=%.0f done=%d\n", bytes, pg->total,
+            pg->total ? 100.0 * bytes / pg->total : 100.0, records, mb_s, rec_s,
+            eta, done);
+    if (fclose(fp) == 0)
+      rename(tmp_path, pg->status_path);
+    return;
+  }
+  snprintf(line, sizeof(line), "progress: %5.1f%% %lld of %lld MB, %lld records,"
+           " %.1f MB/s, %.0f records/s", pg->total ? 100.0 * bytes / pg->total : 100.0,
+           bytes >> 20, pg->total >> 20, records, mb_s, rec_s);
+  if (!done && (eta >= 0))
+    snprintf(line + strlen(line), sizeof(line) - strlen(line), ", ETA %d:%02d:%02d",
+             (int)eta / 3600, ((int)eta / 60) % 60, (int)eta % 60);
+  fprintf(stderr, pg->tty ? "\r%-100s" : "%s\n", line);
+  if (pg->tty && done)
+    fputc('\n', stderr);
+  fflush(stderr);
+} //----- progress_report (struct progress *pg, int done) -----//
+
+static void * progress_thread (void *arg) {
+  struct progress *pg = arg;
+  struct timespec until;
+
+  pthread_mutex_lock(&pg->lock);
+  clock_gettime(CLOCK_REALTIME, &until);
+  until.tv_sec += pg->interval;
+  while (!pg->stop) {
+    if (pthread_cond_timedwait(&pg->wake, &pg->lock, &until) != ETIMEDOUT)
+      continue;             /* woken by progress_stop(), or spuriously */
+    pthread_mutex_unlock(&pg->lock);
+    progress_report(pg, 0);
+    pthread_mutex_lock(&pg->lock);
+    until.tv_sec += pg->interval;
+  }
+  pthread_mutex_unlock(&pg->lock);
+  return NULL;
+}
+
+
+struct progress *progress_start (struct scan_state *st, int n_threads,
+                                 long long total_bytes, int interval,
+                                 const char *status_path) {
+  struct progress *pg = calloc(1, sizeof(struct progress));
+  long long b;
+  int k;
+
+  pg->st = st;
+  pg->n_threads = n_threads;
+  pg->total = total_bytes;
+  pg->interval = (interval > 0) ? interval : 1;
+  pg->status_path = status_path;
+  for (k=0;k<n_threads;k++) {
+    b = ((st[k].start < total_bytes) ? st[k].start : total_bytes) - st[k].origin;
+    st[k].progress_bytes = b;
+    st[k].progress_records = st[k].tot_proteins;
+    pg->base += b;
+    pg->records0 += st[k].tot_proteins;
+  }
+  pg->tty = (status_path == NULL) && isatty(STDERR_FILENO);
+  clock_gettime(CLOCK_MONOTONIC, &pg->t0);
+  pthread_mutex_init(&pg->lock, NULL);
+  pthread_cond_init(&pg->wake, NULL);
+  if (pthread_create(&pg->tid, NULL, progress_thread, pg)) {
+    perror("CAN'T START PROGRESS THREAD\ncause");
+    pthread_mutex_destroy(&pg->lock);
+    pthread_cond_destroy(&pg->wake);
+    free(pg);
+    return NULL;
+  }
+  return pg;
+} //----- progress_start -----//
+
+void progress_stop (struct progress *pg) {
+/*****************************************************************
+ *  Stop the reporter and give the final figures
+ *****************************************************************/
+  if (pg == NULL)
+    return;
+  pthread_mutex_lock(&pg->lock);
+  pg->stop = 1;
+  pthread_cond_signal(&pg->wake);
+  pthread_mutex_unlock(&pg->lock);
+  pthread_join(pg->tid, NULL);
+  progress_report(pg, 1);
+  pthread_mutex_destroy(&pg->lock);
+  pthread_cond_destroy(&pg->wake);
+  free(pg);
+}
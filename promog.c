@@ -25,25 +25,120 @@ along with this program; if not, see
 
 */
 
+
 #include <stdio.h>
 #include <math.h>
 #include <time.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <fcntl.h>
 #include <regex.h>
+#include <pthread.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include "promog.h"
 
 
 #define    BILLION   1000000000 
 #define STDOUT 1
 #define STDIN 0 
+#define MAX_THREADS  64
+#define MAX_CUBES    16
+
+/*********************************************************************
+ *  The report is read back out of one cube grouped on the three
+ *  legacy dimensions.
+ *********************************************************************/
+static const char *REPORT_SPEC = "human,brain,muscle:all";
+static const char *SEQ_STATS_SPEC = "compartment:sequence";
+
+static int parse_offset (const char *s, long long *v) {
+/*****************************************************************
+ *  A byte offset with an optional K, M, G or T suffix
+ *****************************************************************/
+  char *end;
+
+  *v = strtoll(s, &end, 10);
+  switch (*end) {
+    case 'T': case 't': *v <<= 10;   /* fall through */
+    case 'G': case 'g': *v <<= 10;   /* fall through */
+    case 'M': case 'm': *v <<= 10;   /* fall through */
+    case 'K': case 'k': *v <<= 10;
+      end++;
+  }
+  return ((end == s) || (*end != '\0') || (*v < 0)) ? -1 : 0;
+} //----- parse_offset -----//
 
-static char * line;
+
+static int parse_range (const char *s, long long size, long long *start, long long *end) {
+/*****************************************************************
+ *
+ *  --range=START:END, either end may be left empty for the start
+ *  or the end of the file, or --range=I/N for the I-th (from 0)
+ *  of N equal shards.  Unsnapped: the caller moves both ends on
+ *  to entry starts.  LLONG_MAX for an end at or past EOF.
+ *
+ *****************************************************************/
+  char buf[64], *sep;
+  long long i, n;
+
+  if (strlen(s) >= sizeof(buf))
+    return -1;
+  strcpy(buf, s);
+  if ((sep = strchr(buf, '/')) != NULL) {
+    *sep = '\0';
+    if ((parse_offset(buf, &i) < 0) || (parse_offset(sep + 1, &n) < 0) ||
+        (n < 1) || (i >= n))
+      return -1;
+    *start = i*size/n;
+    *end = (i == n - 1) ? LLONG_MAX : (i + 1)*size/n;
+    return 0;
+  }
+  if ((sep = strchr(buf, ':')) == NULL)
+    return -1;
+  *sep = '\0';
+  *start = 0;
+  *end = LLONG_MAX;
+  if ((buf[0] != '\0') && (parse_offset(buf, start) < 0))
+    return -1;
+  if ((sep[1] != '\0') && (parse_offset(sep + 1, end) < 0))
+    return -1;
+  if (*end >= size)
+    *end = LLONG_MAX;
+  return (*end < *start) ? -1 : 0;
+} //----- parse_range -----//
+
+
+static int render_setup (struct render_opts *ro, const char *book_path,
+                         const char *rcache_dir, long long rcache_bytes, int n_threads) {
+/*****************************************************************
+ *  Open the --cellgrams book and the --render-cache, and check
+ *  the --cellgram-dir
+ *****************************************************************/
+  ro->n_threads = n_threads;
+  if ((book_path != NULL) && ((ro->book = cellgram_book_open(book_path)) == NULL))
+    return -1;
+  if ((ro->dir != NULL) && (mkdir(ro->dir, 0755) < 0) && (access(ro->dir, W_OK) < 0)) {
+    fprintf(stderr, "CAN'T USE CELLGRAM DIRECTORY: %s\n", ro->dir);
+    return -1;
+  }
+  if ((rcache_dir != NULL) && ((ro->rc = rcache_open(rcache_dir, rcache_bytes)) == NULL))
+    return -1;
+  if ((ro->rc != NULL) && (ro->dir == NULL))
+    fprintf(stderr, "--render-cache serves --cellgram-dir only; not used\n");
+  return 0;
+} //----- render_setup -----//
+
+
+static void * scan_thread (void *arg) {
+  scan_range((struct scan_state *)arg);
+  return NULL;
+}
 
 int main (int argc, char *argv[]) {
 
@@ -57,142 +152,140 @@ int main (int argc, char *argv[]) {
   const int BAD_FSTAT = -3 ;
   const int TIME_ERR = -4 ;
   const int REGEX_ERR = -5 ;
+  const int BAD_LISTFILE = -6 ;
   const int  BLOCKSIZE   = 1<<14; 
 //  const long long BLOCKSIZE   = 1<<31; 
 
 /*********************************************************************
- *  Determinants of "membrane" count
+ *  Essential counters & roll flaps 
  *********************************************************************/
-  const int MEMB_INDEX = 1;
-  const int CELL_MEMB_INDEX = 0;
-  const int CELL_SURF_INDEX = 21;
-  const int GO_PMEMB_INDEX = 6;
-  const int GO_INT_MEMB_INDEX = 4;
+  int i, j, k;
+  long long tot_proteins, line_num;
+  int corrupt_infile; 
+  long long char_count;
+  int max_prot_lines,max_prot_chars;
+  int  max_line;
 
 /*********************************************************************
- *  Determinants of "cytoplasmic" count
+ *   File Descriptors 
  *********************************************************************/
-  const int CYTOPLASM_INDEX = 2;
-  const int CYTOSOL_INDEX = 3;
-  const int SOLUBLE_INDEX = 41;
-  const int GO_CYTOSOL_INDEX = 7;
-  const int GO_CYTOPLASM_INDEX = 2;
+  int fd, fd_plist, fd_ERROR, fd_GO_REMAINDER = -1; 
+  int fd_FT_TOPO_DOM, fd_REMAINDER = -1;
 
 /*********************************************************************
- *  Determinants of "extracellular" count
+ *   Scanning threads, one byte range of the datafile each
  *********************************************************************/
-  const int EXTRACELLULAR_INDEX = 4;
-  const int SECRETED_INDEX = 5;
-  const int GO_EXTRACELLULAR_INDEX = 3;
-  const int GO_ECM_INDEX = 5;
+  int n_threads = 1, n_specs = 0;
+  char *xt_specs[MAX_CUBES];
+  struct scan_state st[MAX_THREADS];
+  struct promog_rules rules[MAX_THREADS];
+  pthread_t tid[MAX_THREADS];
+  long long bounds[MAX_THREADS+1];
+  struct crosstab *report;
 
 /*********************************************************************
- *  Determinants of "nucleus" count
+ *   Result cache
  *********************************************************************/
-  const int NUCLEUS_INDEX = 6;
-  const int TELOMERE_INDEX = 30;
-  const int GO_NUCLEUS_INDEX = 0;
-  const int GO_DNA_BIND_INDEX = 8;
+  char *cache_dir = NULL;
+  int use_fingerprint = FALSE;
+  const char *specs[MAX_CUBES];
+  struct cache_key key;
+  struct crosstab **cached;
 
 /*********************************************************************
- *  Regular expression data 
+ *   Checkpoints, --checkpoint and --resume
  *********************************************************************/
-  const int REGEX_COUNT = 45;
-  const char* REGEX_RAW_ARRAY[] = { "[Cc]ell [Mm]embrane", "[mM]embrane", "[cC]ytoplasm", 
-               "[cC]ytosol", "[Ee]xtracellular", "[Ss]ecreted", "[Nn]ucleus", 
-               "[Mm]itochondrion", "[Ee]ndoplasmic reticulum lumen", "[Cc]ell junction", 
-               "[Pp]eriplasm", "[Vv]acuole", "[Pp]lastid", "[Cc]apsid", 
-               "[Ee]ndoplasmic reticulum", "[Ee]ndosome", "[Ll]ysosome", "[Vv]irion", 
-               "[Cc]entromere", "[Pp]eroxisome", "[Gg]olgi", "[Cc]ell [Ss]urface", 
-               "[Gg]lyoxysome", "[Gg]lyocosome", "[Zz]ona pellucida", "[Kk]inetochore", 
-               "[Ss]pore", "[Bb]acterial", "[Ff]imbrium", "[Mm]elanosome", "[Tt]elomere", 
-               "[Pp]odosome", "[Cc]ilium", "[Tt]richocyst", "[Hh]ydrogenosome", 
-               "[Ss]arcoplasmic [Rr]eticulum", "[Aa]xon", "[Mm]icrosome", "[Aa]ngiotensin",
-               "[Cc]hlorosome", "[tT]hylakoid", "[Ss]oluble", "[bB]ud", "[Ff]lagellum",
-               "[Vv]iral"}; 
-
-  const char* NAMES_ARRAY[] = { "Cell Membrane", "Membrane", "Cytoplasm", "Cytosol", 
-               "Extracellular", "Secreted", "Nucleus", "Mitochondrion", 
-               "Endoplasmic reticulum lumen", "Cell junction", "Periplasm", "Vacuole", 
-               "Plastid", "Capsid", "Endoplasmic reticulum", "Endosome", "Lysosome", 
-               "Virion", "Centromere", "Peroxisome", "Golgi", "Cell Surface", 
-               "Glyoxysome", "Glyocosome", "Zona pellucida", "Kinetochore", "Spore", 
-               "Bacterial", "Fimbrium", "Melanosome", "Telomere", "Podosome", "Cilium",
-               "Trichocyst", "Hydrogenosome", "Sarcoplasmic Reticulum", "Axon", "Microsome",
-               "Angiotensin", "Chlorosome", "Thylakoid", "Soluble", "Bud", "Flagellum",
-               "Viral"}; 
-
-  const int GO_COUNT = 9;
-  const char * GO_RAW_REGEX_ARRAY[] = {"GO:0005634","GO:0007165","GO:0005737","GO:0005576","GO:0016021","GO:0031012","GO:0005886","GO:0005829","GO:0003677"};
-
-  const char * GO_NAMES_ARRAY[] = {"Nucleus","Signal Transduction","Cytoplasm","Extracellular","Integral to Membrane","Extracellular Matrix","Plasma Membrane","Cytosol","DNA binding"};
-
-  const int GO_MINOR_COUNT = 5;
-  const char * GO_RAW_REGEX_MINOR_ARRAY[] = {"GO:0009103","GO:0030573","GO:0055114","GO:0033644"};
-  const char * GO_NAMES_MINOR_ARRAY[] = {"lipopolysaccharide biosynthetic process","Bile Aid Catabolic Process","Oxidation Reduction","Host Cell Membrane"
-};
- 
+  char *ckpt_path = NULL;
+  int ckpt_interval = 60, resume = FALSE;
+  struct checkpoint *ckpt = NULL;
+
 /*********************************************************************
- *  Essential counters & roll flaps 
+ *   Byte-range shards, --range and --partial
  *********************************************************************/
-  int a,b,c, i, len, tot, j,k,l,m,n,got_EOL, line_WRAP;
-  int tot_proteins, tot_human_proteins, line_num, wrap_SHIFT;
-  int wrap_ANNEAL, done, block_done, n_prot_lines, corrupt_infile; 
-  int max_prot_lines,max_prot_chars, this_prot_chars, bytes_read;
-  int  max_line, zero_line;
+  char *range_arg = NULL, *partial_path = NULL;
+  long long range_start = 0, range_end = LLONG_MAX, span;
 
 /*********************************************************************
- *   File Descriptors 
+ *   Batch mode, several datafiles or --manifest
  *********************************************************************/
-  int fd, fd_plist, fd_ERROR, fd_GO_REMAINDER; 
-  int fd_FT_TOPO_DOM, fd_REMAINDER;
+  char *manifest_path = NULL;
+  const char **paths = NULL;
+  int n_paths = 0, io_limit = 2;
+  struct batch_opts bo;
 
 /*********************************************************************
- *  Boolean protein attribute flags
+ *   Approximate counts, --sample
  *********************************************************************/
-  int is_FT_TRANSMEM, is_FT_INTRAMEM, is_FT_TD_extracellular, is_FT_TD_cytoplasmic; 
-  int is_me_DUPE, is_REMAINDER, has_FT_SIGNAL, has_FT_SIG_TRANSMEM, has_FT_DNA_BIND;
-  int is_FT_LIPID, is_mc_DUPE, is_mn_DUPE, is_ce_DUPE, is_cn_DUPE, is_ne_DUPE;
-  int is_FLAGGED, is_SCL_ARRAY[REGEX_COUNT], has_SCL, has_DR_GO, has_GO_ARRAY[GO_COUNT]; 
-  int is_GO_REMAINDER, has_GO_MINOR_ARRAY[GO_MINOR_COUNT], is_brain, is_muscle;
+  struct sample_opts so;
+  double sample_fraction = 0, sample_error = 0;
+  long long sample_window = 1LL<<20;
+  unsigned long long sample_seed = 1;
 
 /*********************************************************************
- *   Human protein tabulators
+ *   Per-phase metrics, --metrics
  *********************************************************************/
-  int hum_transmem, hum_extracellular, hum_cytoplasmic, hum_SIGNAL, hum_SIG_TRANSMEM;
-  int hum_DNA_BIND, hum_mem, hum_intramem, hum_itmem, hum_lipid_bind, hum_membrane; 
-  int in_SCL, hum_REMAINDER, hum_SCL_ARRAY[REGEX_COUNT], hum_SCL_NULL, hum_DR_GO;
-  int hum_GO_ARRAY[GO_COUNT], hum_GO_MINOR_ARRAY[GO_MINOR_COUNT], hum_nuclear; 
+  struct metrics met, thread_met[MAX_THREADS];
+  int metrics_format = -1, perf_counters = FALSE;
 
 /*********************************************************************
- *   Total protein tabulators
+ *   Progress reports, --progress and --status-file
  *********************************************************************/
-  int tot_transmem, tot_extracellular, tot_cytoplasmic, tot_SIGNAL, tot_SIG_TRANSMEM;
-  int tot_DNA_BIND, tot_mem, tot_intramem, tot_itmem, tot_lipid_bind, tot_REMAINDER;
-  int tot_SCL_ARRAY[REGEX_COUNT], tot_membrane, tot_SCL_NULL, tot_DR_GO;
-  int tot_GO_ARRAY[GO_COUNT], tot_GO_MINOR_ARRAY[GO_MINOR_COUNT], tot_nuclear; 
-  int tot_muscle, tot_brain, brain_cytoplasmic, brain_nuclear, brain_membrane;
-  int brain_extracellular, muscle_cytoplasmic, muscle_nuclear, muscle_membrane;
-  int muscle_extracellular;
+  int progress_interval = 0;
+  char *status_path = NULL;
+  struct progress *pg = NULL;
+
+/*********************************************************************
+ *   Cellgrams: --cellgrams, --cellgram-dir and --render-cache
+ *********************************************************************/
+  char *book_path = NULL, *rcache_dir = NULL;
+  long long rcache_bytes = 256LL<<20;
+  struct render_opts ro;
+
+/*********************************************************************
+ *   Sequence stages, --predict-tm and --seq-stats
+ *********************************************************************/
+  int seq_stages = 0;
 
 /*********************************************************************
  *   Miscellaneous, timing, memory 
  *********************************************************************/
-  int file_arg = 1, bs_arg = 2, this_is_human = 0;
-  float r;
-  long long this_seek, line_begin, seek_result, last_lbegin,status;
-  long long char_count;
-  char *this_line, this_char, *block, *wrap_frag, err_msg[MAXLINE],opt;
+  int file_arg = 1, bs_arg = 2;
+  char err_msg[MAXLINE],opt;
+  char *p_colon;
   char alloc_type = 'v', mem_method[20];
   struct stat statbuf;
   struct timespec t_begin, t_end, t_res;
-
-/*********************************************************************
- *  REGular EXpressions compiled variables   
- *********************************************************************/
-  regex_t rgx_array[REGEX_COUNT], rgx_GO_array[GO_COUNT], 
-      rgx_GO_minor_array[GO_MINOR_COUNT], rgx_brain, rgx_muscle;
-  int regex_status;
+  char *index_path = NULL, *query_expr = NULL, *list_path = NULL;
+  char *export_path = NULL;
+  int fd_list = -1, list_status = 0, export_status = 0, index_status = 0;
+  int format = FORMAT_TEXT;
+  struct promog_summary sum;
+  static struct option long_options[] = {
+    {"format", required_argument, NULL, 'F'},
+    {"cache", required_argument, NULL, 'K'},
+    {"fingerprint", no_argument, NULL, 'P'},
+    {"metrics", optional_argument, NULL, 'M'},
+    {"perf-counters", no_argument, NULL, 'H'},
+    {"progress", optional_argument, NULL, 'G'},
+    {"status-file", required_argument, NULL, 'S'},
+    {"checkpoint", required_argument, NULL, 'C'},
+    {"checkpoint-interval", required_argument, NULL, 'I'},
+    {"resume", no_argument, NULL, 'R'},
+    {"range", required_argument, NULL, 'N'},
+    {"partial", required_argument, NULL, 'T'},
+    {"manifest", required_argument, NULL, 'B'},
+    {"io-limit", required_argument, NULL, 'O'},
+    {"sample", required_argument, NULL, 'A'},
+    {"sample-error", required_argument, NULL, 'E'},
+    {"sample-window", required_argument, NULL, 'W'},
+    {"seed", required_argument, NULL, 'D'},
+    {"cellgrams", required_argument, NULL, 'Y'},
+    {"cellgram-dir", required_argument, NULL, 'Z'},
+    {"render-cache", required_argument, NULL, 'Q'},
+    {"predict-tm", no_argument, NULL, 'U'},
+    {"seq-stats", no_argument, NULL, 'V'},
+    {NULL, 0, NULL, 0}};
+  struct pindex *ix = NULL;
 /*********************************************************************
  *  END VARIABLES SECTION 
  *  *************  **************  **************   ************** 
@@ -203,60 +296,28 @@ int main (int argc, char *argv[]) {
  *  END VARIABLES SECTION 
  *********************************************************************/
 
-  line = malloc((MAXLINE+2)*sizeof(char));
-
- #if 0
- for (i=0;i<REGEX_COUNT;i++)
-   printf("index %d: RAW REGEX: %s NAME: %s\n",i,REGEX_RAW_ARRAY[i],NAMES_ARRAY[i]);
- #endif
-
-/*********************************************************************
- *  REGular EXpression COMPilations
- *********************************************************************/
-  for (i=0;i<REGEX_COUNT;i++) {
-    regex_status = regcomp(&rgx_array[i],REGEX_RAW_ARRAY[i] , REG_EXTENDED|REG_NOSUB);
-    if (regex_status) {
-        fprintf(stderr, "Could not compile regex for %s\n",REGEX_RAW_ARRAY[i]);
-        exit(REGEX_ERR);
-    }
-  }
-
-  for (i=0;i<GO_COUNT;i++) {
-    regex_status = regcomp(&rgx_GO_array[i],GO_RAW_REGEX_ARRAY[i] , REG_EXTENDED|REG_NOSUB);
-    if (regex_status) {
-        fprintf(stderr, "Could not compile regex for %s\n",GO_RAW_REGEX_ARRAY[i]);
-        exit(REGEX_ERR);
-    }
-  }
-
-  for (i=0;i<GO_MINOR_COUNT;i++) {
-    regex_status = regcomp(&rgx_GO_minor_array[i],GO_RAW_REGEX_MINOR_ARRAY[i] 
-         , REG_EXTENDED|REG_NOSUB);
-    if (regex_status) {
-        fprintf(stderr, "Could not compile regex for %s\n",GO_RAW_REGEX_MINOR_ARRAY[i]);
-        exit(REGEX_ERR);
-    }
-  }
-
-  regex_status = regcomp(&rgx_brain,"TISSUE=Brain", REG_EXTENDED|REG_NOSUB);
-    if (regex_status) {
-        fprintf(stderr, "Could not compile regex for %s\n","TISSUE=Brain");
-        exit(REGEX_ERR);
-    }
-
-  regex_status = regcomp(&rgx_muscle,"TISSUE=Muscle", REG_EXTENDED|REG_NOSUB);
-    if (regex_status) {
-        fprintf(stderr, "Could not compile regex for %s\n","TISSUE=Muscle");
-        exit(REGEX_ERR);
-    }
-
   if (argc < 2) {
-    sprintf(err_msg,"USAGE: demog_script_friendly [-mvap] <datafile> [log base 2 of BLOCKSIZE] O:=} Not");
+    sprintf(err_msg,"USAGE: promog [-mvap] [--format=text|json|tsv]"
+        " [--cache=<dir> [--fingerprint]] [--metrics[=text|json]] [--perf-counters]\n"
+        "              [--progress[=<sec>]] [--status-file=<file>]\n"
+        "              [--checkpoint=<file> [--checkpoint-interval=<sec>] [--resume]]\n"
+        "              [--range=<start>:<end>|<i>/<n>] [--partial=<file>]\n"
+        "              [--manifest=<file>] [--io-limit=<files>]\n"
+        "              [--sample=<fraction>] [--sample-error=<rel>]"
+        " [--sample-window=<bytes>] [--seed=<n>]\n"
+        "              [--cellgrams=<file.pdf>|<atlas>] [--cellgram-dir=<dir>]"
+        " [--render-cache=<dir>[:<size>]]\n"
+        "              [--predict-tm] [--seq-stats]\n"
+        "              [-j <threads>] [-x <keys>[:<measures>]]"
+        " [-i <indexfile>] [-l <listfile>]"
+        " [-e <exportfile>] <datafile> ...\n"
+        "       promog -i <indexfile> -q <query> O:=} Not");
     perror(err_msg);
     return BAD_ARGC;
   }
 
-  while ((opt = getopt(argc,argv,"mvap")) !=EOF) {
+  memset(&ro, 0, sizeof(ro));
+  while ((opt = getopt_long(argc,argv,"mvapi:q:j:x:l:e:",long_options,NULL)) !=EOF) {
     switch (opt) {
       case 'm':
         alloc_type = 'm';
@@ -278,11 +339,244 @@ int main (int argc, char *argv[]) {
         file_arg++;
         bs_arg++;
         break;
+      case 'i':
+        index_path = optarg;
+        break;
+      case 'q':
+        query_expr = optarg;
+        break;
+      case 'l':
+        list_path = optarg;
+        break;
+      case 'e':
+        export_path = optarg;
+        break;
+      case 'K':
+        cache_dir = optarg;
+        break;
+      case 'P':
+        use_fingerprint = TRUE;
+        break;
+      case 'M':
+        metrics_format = (optarg != NULL) ? summary_format(optarg) : FORMAT_TEXT;
+        if ((metrics_format != FORMAT_TEXT) && (metrics_format != FORMAT_JSON)) {
+          sprintf(err_msg,"--metrics must be text or json, not %s",optarg);
+          perror(err_msg);
+          return BAD_ARGC;
+        }
+        break;
+      case 'G':
+        progress_interval = (optarg != NULL) ? atoi(optarg) : 10;
+        if (progress_interval < 1)
+          progress_interval = 1;
+        break;
+      case 'S':
+        status_path = optarg;
+        if (progress_interval == 0)
+          progress_interval = 10;
+        break;
+      case 'C':
+        ckpt_path = optarg;
+        break;
+      case 'I':
+        ckpt_interval = atoi(optarg);
+        if (ckpt_interval < 1)
+          ckpt_interval = 1;
+        break;
+      case 'R':
+        resume = TRUE;
+        break;
+      case 'H':
+        perf_counters = TRUE;
+        break;
+      case 'N':
+        range_arg = optarg;
+        break;
+      case 'T':
+        partial_path = optarg;
+        break;
+      case 'B':
+        manifest_path = optarg;
+        break;
+      case 'O':
+        io_limit = atoi(optarg);
+        if (io_limit < 1)
+          io_limit = 1;
+        break;
+      case 'A':
+        sample_fraction = atof(optarg);
+        if ((sample_fraction <= 0) || (sample_fraction > 1)) {
+          sprintf(err_msg,"--sample must be a fraction in (0,1], not %s",optarg);
+          perror(err_msg);
+          return BAD_ARGC;
+        }
+        break;
+      case 'E':
+        sample_error = atof(optarg);
+        if (sample_fraction == 0)
+          sample_fraction = 1;
+        break;
+      case 'W':
+        if ((parse_offset(optarg, &sample_window) < 0) || (sample_window < 4096)) {
+          sprintf(err_msg,"--sample-window must be at least 4096 bytes, not %s",optarg);
+          perror(err_msg);
+          return BAD_ARGC;
+        }
+        break;
+      case 'D':
+        sample_seed = strtoull(optarg, NULL, 10);
+        break;
+      case 'Y':
+        book_path = optarg;
+        break;
+      case 'Z':
+        ro.dir = optarg;
+        break;
+      case 'Q':
+        /*  <dir>[:<size>]  */
+        rcache_dir = optarg;
+        if (((p_colon = strrchr(optarg, ':')) != NULL) &&
+            (parse_offset(p_colon + 1, &rcache_bytes) == 0))
+          *p_colon = '\0';
+        break;
+      case 'U':
+        seq_stages |= SEQ_TM;
+        break;
+      case 'V':
+        seq_stages |= SEQ_STATS;
+        break;
+      case 'F':
+        if ((format = summary_format(optarg)) < 0) {
+          sprintf(err_msg,"--format must be text, json or tsv, not %s",optarg);
+          perror(err_msg);
+          return BAD_ARGC;
+        }
+        break;
+      case 'j':
+        n_threads = atoi(optarg);
+        if (n_threads < 1)
+          n_threads = 1;
+        if (n_threads > MAX_THREADS)
+          n_threads = MAX_THREADS;
+        break;
+      case 'x':
+        if (n_specs == MAX_CUBES - 1) {
+          sprintf(err_msg,"at most %d -x cross-tabulations", MAX_CUBES - 1);
+          perror(err_msg);
+          return BAD_ARGC;
+        }
+        xt_specs[n_specs++] = optarg;
+        break;
       case '?':
         sprintf(err_msg,"invalid option to %s:",argv[0]);
         perror(err_msg);
     }//--- switch (opt) ---//
   }//--- while ((opt= getopt(argc,argv,"m")) !=EOF) ---// 
+  if (seq_stages & SEQ_STATS) {
+    /*  the sequence measures, summed per compartment  */
+    if (n_specs == MAX_CUBES - 1) {
+      sprintf(err_msg,"at most %d -x cross-tabulations with --seq-stats", MAX_CUBES - 2);
+      perror(err_msg);
+      return BAD_ARGC;
+    }
+    xt_specs[n_specs++] = (char *)SEQ_STATS_SPEC;
+  }
+  file_arg = optind;
+  bs_arg = optind + 1;
+
+  if (query_expr != NULL) {
+    /*****************************************************************
+     *  Set-algebra query against a record index built by -i: no scan
+     *****************************************************************/
+    if (index_path == NULL) {
+      sprintf(err_msg,"-q needs the record index given with -i");
+      perror(err_msg);
+      return BAD_ARGC;
+    }
+    if (pindex_query(index_path, query_expr, stdout) < 0)
+      return BAD_DATAFILE;
+    return GOOD_EXIT;
+  }
+
+  if ((manifest_path != NULL) || (argc - file_arg > 1)) {
+    /*****************************************************************
+     *  Several datafiles: scanned together on one pool of threads
+     *****************************************************************/
+    if ((index_path != NULL) || (list_path != NULL) || (export_path != NULL) ||
+        (ckpt_path != NULL) || (range_arg != NULL) || (partial_path != NULL) ||
+        (sample_fraction > 0)) {
+      sprintf(err_msg,"several datafiles cannot be used with -i, -l, -e,"
+          " --checkpoint, --range, --partial or --sample");
+      perror(err_msg);
+      return BAD_ARGC;
+    }
+    for (i=file_arg;i<argc;i++) {
+      paths = realloc(paths, (n_paths + 1)*sizeof(char *));
+      paths[n_paths++] = argv[i];
+    }
+    if ((manifest_path != NULL) && (batch_manifest(manifest_path, &paths, &n_paths) < 0))
+      return BAD_DATAFILE;
+    if (n_paths == 0) {
+      sprintf(err_msg,"no datafiles in %s",manifest_path);
+      perror(err_msg);
+      return BAD_ARGC;
+    }
+    specs[0] = REPORT_SPEC;
+    for (j=0;j<n_specs;j++)
+      specs[1+j] = xt_specs[j];
+    metrics_init(&met);
+    if (perf_counters) {
+      met.pc = perfctr_open();
+      if (metrics_format < 0)
+        metrics_format = FORMAT_TEXT;
+    }
+    if (render_setup(&ro, book_path, rcache_dir, rcache_bytes, n_threads) < 0)
+      return BAD_DATAFILE;
+    memset(&bo, 0, sizeof(bo));
+    bo.n_threads = n_threads;
+    bo.io_limit = io_limit;
+    bo.blocksize = BLOCKSIZE;
+    bo.format = format;
+    bo.n_specs = 1 + n_specs;
+    bo.specs = specs;
+    bo.cache_dir = cache_dir;
+    bo.use_fingerprint = use_fingerprint;
+    bo.progress_interval = progress_interval;
+    bo.status_path = status_path;
+    bo.mem_method = "valloc";
+    bo.render = &ro;
+    bo.met = &met;
+    bo.seq = seq_stages;
+    if (batch_run(paths, n_paths, &bo) < 0)
+      return BAD_DATAFILE;
+    if (metrics_format == FORMAT_JSON)
+      metrics_print_json(&met, stderr);
+    else if (metrics_format == FORMAT_TEXT)
+      metrics_print(&met, stderr);
+    cellgram_book_close(ro.book);
+    rcache_close(ro.rc);
+    perfctr_close(met.pc);
+    return GOOD_EXIT;
+  }
+
+  if (file_arg >= argc) {
+    sprintf(err_msg,"USAGE: promog [-mvap] [--format=text|json|tsv]"
+        " [--cache=<dir> [--fingerprint]] [--metrics[=text|json]] [--perf-counters]\n"
+        "              [--progress[=<sec>]] [--status-file=<file>]\n"
+        "              [--checkpoint=<file> [--checkpoint-interval=<sec>] [--resume]]\n"
+        "              [--range=<start>:<end>|<i>/<n>] [--partial=<file>]\n"
+        "              [--manifest=<file>] [--io-limit=<files>]\n"
+        "              [--sample=<fraction>] [--sample-error=<rel>]"
+        " [--sample-window=<bytes>] [--seed=<n>]\n"
+        "              [--cellgrams=<file.pdf>|<atlas>] [--cellgram-dir=<dir>]"
+        " [--render-cache=<dir>[:<size>]]\n"
+        "              [--predict-tm] [--seq-stats]\n"
+        "              [-j <threads>] [-x <keys>[:<measures>]]"
+        " [-i <indexfile>] [-l <listfile>]"
+        " [-e <exportfile>] <datafile> ... O:=} Not");
+    perror(err_msg);
+    return BAD_ARGC;
+  }
 
 #if 0 
   const long long BLOCKSIZE;
@@ -344,751 +638,372 @@ int main (int argc, char *argv[]) {
     return BAD_FSTAT;
   }
 
-
-  i=0;
-  a=0;
-  b=0;
-  c=0;
-  tot_proteins = 0;
-  line_num = 0;
-  char_count = 0;
-  tot_human_proteins = 0;
-  hum_transmem = 0;
-  hum_mem = 0;
-  hum_DR_GO = 0;
-  hum_itmem = 0;
-  hum_intramem = 0;
-  hum_SIGNAL= 0;
-  tot_transmem = 0;
-  tot_mem = 0;
-  tot_brain = 0;
-  tot_muscle = 0;
-  tot_lipid_bind = 0;
-  hum_lipid_bind = 0;
-  tot_itmem = 0;
-  tot_intramem = 0;
-  tot_SIGNAL= 0;
-  hum_DNA_BIND = 0;
-  hum_REMAINDER = 0;
-  tot_REMAINDER = 0;
-  hum_nuclear = 0;
-  tot_nuclear = 0;
-  brain_nuclear = 0;
-  muscle_nuclear = 0;
-  hum_extracellular = 0;
-  brain_extracellular = 0;
-  muscle_extracellular = 0;
-  hum_cytoplasmic = 0;
-  brain_cytoplasmic = 0;
-  muscle_cytoplasmic = 0;
-  hum_membrane = 0;
-  brain_membrane = 0;
-  muscle_membrane = 0;
-  hum_SCL_NULL = 0;
-  tot_SCL_NULL = 0;
-  tot_DR_GO = 0;
-  
-  for(i=0;i<REGEX_COUNT;i++) {
-     hum_SCL_ARRAY[i] = 0;
-     tot_SCL_ARRAY[i] = 0;
-     is_SCL_ARRAY[i] = FALSE;
-  }
-
-  for(i=0;i<GO_COUNT;i++) {
-     hum_GO_ARRAY[i] = 0;
-     tot_GO_ARRAY[i] = 0;
-     has_GO_ARRAY[i] = FALSE;
+  metrics_init(&met);
+  if (perf_counters) {
+    /*  before any scan thread starts, so that they inherit the counters  */
+    met.pc = perfctr_open();
+    if (metrics_format < 0)
+      metrics_format = FORMAT_TEXT;
   }
-
-  for(i=0;i<GO_MINOR_COUNT;i++) {
-     hum_GO_MINOR_ARRAY[i] = 0;
-     tot_GO_MINOR_ARRAY[i] = 0;
-     has_GO_MINOR_ARRAY[i] = FALSE;
+  if (render_setup(&ro, book_path, rcache_dir, rcache_bytes, n_threads) < 0)
+    return BAD_DATAFILE;
+  if (sample_fraction > 0) {
+    /*****************************************************************
+     *  Estimates from a sample of the file instead of a full scan
+     *****************************************************************/
+    if ((index_path != NULL) || (list_path != NULL) || (export_path != NULL) ||
+        (n_specs > 0) || (ckpt_path != NULL) || (range_arg != NULL) ||
+        (partial_path != NULL) || (cache_dir != NULL)) {
+      sprintf(err_msg,"--sample cannot be used with -i, -l, -e, -x, --seq-stats,"
+          " --cache, --checkpoint, --range or --partial");
+      perror(err_msg);
+      return BAD_ARGC;
+    }
+    memset(&so, 0, sizeof(so));
+    so.fraction = sample_fraction;
+    so.max_error = sample_error;
+    so.window = sample_window;
+    so.seed = sample_seed;
+    so.n_threads = n_threads;
+    so.blocksize = BLOCKSIZE;
+    so.format = format;
+    so.spec = REPORT_SPEC;
+    so.render = &ro;
+    so.met = &met;
+    so.seq = seq_stages;
+    if (sample_run(argv[file_arg], statbuf.st_size, &so) < 0)
+      return BAD_DATAFILE;
+    if (metrics_format == FORMAT_JSON)
+      metrics_print_json(&met, stderr);
+    else if (metrics_format == FORMAT_TEXT)
+      metrics_print(&met, stderr);
+    cellgram_book_close(ro.book);
+    rcache_close(ro.rc);
+    perfctr_close(met.pc);
+    close(fd);
+    return GOOD_EXIT;
   }
 
-  tot_extracellular = 0;
-  tot_membrane = 0;
-  tot_cytoplasmic = 0;
-  max_prot_lines = 0;
-  char_count = 0;
-  zero_line = FALSE;
-  corrupt_infile = FALSE;
-  max_prot_chars = 0;
-  this_prot_chars = 0;
-  n_prot_lines = 0;
-
-  this_is_human = FALSE;
-  is_FT_TRANSMEM = FALSE;
-  is_brain = FALSE;
-  is_muscle = FALSE;
-  is_REMAINDER = TRUE;
-  is_GO_REMAINDER = TRUE;
-  is_FT_INTRAMEM = FALSE;
-  is_FT_LIPID = FALSE;
-  has_FT_SIGNAL = FALSE;
-  has_DR_GO = FALSE;
-  has_SCL = FALSE;
-  has_FT_DNA_BIND = FALSE;
-  has_FT_SIG_TRANSMEM = FALSE;
-  is_FT_TD_extracellular = FALSE;
-  is_FT_TD_cytoplasmic = FALSE;
-  in_SCL = FALSE;
-  is_FLAGGED = FALSE;
-
-  /********************************************************
-   *
-   *   Data parameterization: 
-   *
-   *    BLOCKSIZE chunks of the files are removed as this_seek
-   *     is incremented by that amount in the outer  while
-   *     loop with termination on read failure.  The next
-   *     level of while loop iterates on a variable line_begin,
-   *     which must be less than BLOCKSIZE. This index steps
-   *     through the currently examined block by leaps determined
-   *     by an iterator b that checks for newline. 
-   *
-   ********************************************************/
-  this_seek = 0;
-  max_line = 0;
-  line_WRAP = FALSE;
-  done = FALSE; 
-  block_done = FALSE; 
-  wrap_ANNEAL = FALSE;
-
-  if ((seek_result = lseek(fd, (off_t) this_seek, SEEK_SET))<0)
-    done = TRUE;  
+  memset(&sum, 0, sizeof(sum));
+  sum.datafile = argv[file_arg];
+  sum.mem_method = mem_method;
+  sum.n_threads = n_threads;
+  sum.blocksize = BLOCKSIZE;
+  sum.render = &ro;
+  sum.seq = seq_stages;
   switch (alloc_type) { 
      case 'm':
-       block = malloc(BLOCKSIZE);
        strcpy(mem_method, "malloc");
        break;
      case 'p':
-       posix_memalign((void **)&block,BLOCKSIZE,PAGESIZE);
        strcpy(mem_method, "posix_memalign");
        break;
      case 'a':
-       block = alloca(BLOCKSIZE);
        strcpy(mem_method, "alloca");
        break;
-     case 'v':
-       block = valloc(BLOCKSIZE);
-       strcpy(mem_method, "valloc");
-       break;
      default:
-       block = valloc(BLOCKSIZE);
+       strcpy(mem_method, "valloc");
   } //--- switch (alloc_type) ---//
 
-  line_begin = 0;
-  last_lbegin = 0;
-  n_prot_lines = 0;
-  
-  if (clock_gettime(CLOCK_REALTIME, &t_begin)) {
-    sprintf(err_msg, "failed to get start time\n\0");
+  if ((resume) && (ckpt_path == NULL)) {
+    sprintf(err_msg,"--resume needs the --checkpoint file");
     perror(err_msg);
-    return TIME_ERR;
+    return BAD_ARGC;
   }
+  if ((ckpt_path != NULL) &&
+      ((index_path != NULL) || (list_path != NULL) || (export_path != NULL))) {
+    sprintf(err_msg,"--checkpoint cannot be used with -i, -l or -e");
+    perror(err_msg);
+    return BAD_ARGC;
+  }
+  if ((range_arg != NULL) &&
+      ((cache_dir != NULL) || (ckpt_path != NULL) || (index_path != NULL))) {
+    sprintf(err_msg,"--range cannot be used with --cache, --checkpoint or -i");
+    perror(err_msg);
+    return BAD_ARGC;
+  }
+  if ((range_arg != NULL) &&
+      (parse_range(range_arg, statbuf.st_size, &range_start, &range_end) < 0)) {
+    sprintf(err_msg,"--range must be <start>:<end> or <i>/<n>, not %s",range_arg);
+    perror(err_msg);
+    return BAD_ARGC;
+  }
+  specs[0] = REPORT_SPEC;
+  for (j=0;j<n_specs;j++)
+    specs[1+j] = xt_specs[j];
+  if ((cache_dir != NULL) || (ckpt_path != NULL) || (partial_path != NULL))
+    cache_key_init(&key, fd, &statbuf, seq_stages, specs, 1 + n_specs, use_fingerprint);
 
-/*********************************************************************
- *   this_seek--ing BLOCKSIZE steps
- *********************************************************************/
-  if ((bytes_read = read(fd, block, BLOCKSIZE)) <= 0)  
-    done = TRUE;
-  while (!done)  {
-   /*****************************************************************
-    *   hopping line by line through one block
-    *   block_done indicates data in block has been exhausted. 
-    *
-    *****************************************************************/
-    block_done =  FALSE;
-    while (!block_done) {
-       
-      b=0;
-      /**************************************************************
-       *  finding next line_begin with b 
-       **************************************************************/
-      got_EOL =  FALSE;
-      while (!got_EOL) { 
-         //printf ("e!gE.");
-           if (line_begin == bytes_read) {
-             this_seek += BLOCKSIZE;
-             if ((status= (lseek(fd, (off_t) this_seek, SEEK_SET)) < 0)) {
-               done = TRUE;  
-               got_EOL = TRUE;
-               block_done = TRUE;
-               break;
-             }
-             if ((bytes_read = read(fd, block, BLOCKSIZE)) <= 0)  {
-               got_EOL = TRUE;
-               block_done = TRUE;
-               done = TRUE;
-               break;
-             }
-             else
-               line_begin = 0;
-             }
-           b++; 
-           if (line_begin + b >= bytes_read) {
-           /**************************************************************
-            *  this line has wrapped accross a block.
-            *  shift the file pointer so that the beginning of the line
-            *  is the beginning of the new block.
-            **************************************************************/
-             if (bytes_read  < BLOCKSIZE) {
-               /**************************************************************
-                *  If bytes_read is less than BLOCKSIZE, this should imply
-                *  that we are reading the last block of the infile.  Therefore,
-                *  all loops should end.  In the event the file does not terminate
-                *  correctly, the corrupt_infile flag is set. 
-                **************************************************************/
-               if (block[bytes_read-1] != '\n' )
-                 corrupt_infile = TRUE; 
-               got_EOL = TRUE;
-               block_done = TRUE;
-               done = TRUE;
-               break;
-             }
-             wrap_SHIFT = b;
-             this_seek += BLOCKSIZE - wrap_SHIFT;
-             if ((status= (lseek(fd, (off_t) this_seek, SEEK_SET)) < 0))
-               done = TRUE;  
-             line_begin = 0;
-             last_lbegin = 0;
-           if ((bytes_read = read(fd, block, BLOCKSIZE)) <= 0)  {
-         /**************************************************************
-          *
-          *  there is no more file to read--end all loops.
-          *
-          **************************************************************/
-             //printf("status is %lld\n",status);
-             got_EOL = TRUE;
-             block_done = TRUE;
-             done = TRUE;
-           }
-         }// if (line_begin + b == bytes_read) {
-
-         if ( block[line_begin + b ] == '\n')  {
-           n_prot_lines++;
-           char_count += b;
-           this_prot_chars += b;
-           got_EOL = TRUE;
-         }
-         if ( b == MAXLINE) {
-           b -= 2;
-           got_EOL = TRUE;
-         }//----- if ( b == MAXLINE) -----// 
-      }//----- while (!got_EOL) -----// 
-
-      if (line_begin == bytes_read)
-        break;
-      if ( b > max_line)
-          max_line = b;  
-      if (line_begin != bytes_read)
-         line_num++;
-
-      #if 0
-      if (b != 0)
-        printas(STDOUT,block,line_begin,line_begin+b-1);
-      #endif
-
-      a = 0;
-
-      if ((block[line_begin] == '/')&&(block[line_begin+1] == '/')) {
-    /*****************************************************************
-     *  END OF RECORD
-     *****************************************************************/
-        tot_proteins++;
-        if ( n_prot_lines > max_prot_lines)
-          max_prot_lines = n_prot_lines;
-        if (this_prot_chars > max_prot_chars)
-          max_prot_chars = this_prot_chars;
-        if (this_is_human) {
-       /*****************************************************************
-        * HUMAN DATA 
-        *****************************************************************/
-          if (!has_SCL) {
-            hum_SCL_NULL++;
-            is_REMAINDER = FALSE;
-          }
-          if (is_REMAINDER) 
-            hum_REMAINDER++;
-          if (is_FT_TRANSMEM) 
-            hum_transmem++;
-          if (is_FT_INTRAMEM)
-            hum_intramem++;
-          if (is_FT_LIPID)
-            hum_lipid_bind++;
-          if ((is_FT_INTRAMEM)&&(is_FT_TRANSMEM))
-            hum_itmem++;
-          if (is_FT_TD_extracellular)
-            hum_extracellular++;
-          if (is_FT_TD_cytoplasmic)
-            hum_cytoplasmic++;
-          if (has_FT_SIGNAL)
-            hum_SIGNAL++;
-          if (has_FT_DNA_BIND)
-            hum_DNA_BIND++;
-          if (has_DR_GO)
-            hum_DR_GO++;
-          if ((has_FT_SIGNAL) && (is_FT_TRANSMEM))
-            hum_SIG_TRANSMEM++;
-          for(i=0;i<REGEX_COUNT;i++) 
-             if(is_SCL_ARRAY[i])
-                hum_SCL_ARRAY[i]++;
-
-          for(i=0;i<GO_COUNT;i++) 
-             if(has_GO_ARRAY[i])
-                hum_GO_ARRAY[i]++;
-
-          for(i=0;i<GO_MINOR_COUNT;i++) 
-             if(has_GO_MINOR_ARRAY[i])
-                hum_GO_MINOR_ARRAY[i]++;
-
-          if ((is_FT_TRANSMEM) || (is_FT_INTRAMEM) || (is_FT_LIPID) || 
-              (is_SCL_ARRAY[CELL_SURF_INDEX]) || (is_SCL_ARRAY[CELL_MEMB_INDEX])
-              || (is_SCL_ARRAY[MEMB_INDEX]) )
-            hum_membrane++;
-
-          if ((is_SCL_ARRAY[CYTOPLASM_INDEX]) || (is_SCL_ARRAY[CYTOSOL_INDEX]) ||
-	      (is_SCL_ARRAY[SOLUBLE_INDEX]) || (has_GO_ARRAY[GO_CYTOSOL_INDEX]) ||
-              (has_GO_ARRAY[GO_CYTOPLASM_INDEX]))
-            hum_cytoplasmic++;
-
-          if ((has_FT_SIGNAL) || (is_SCL_ARRAY[EXTRACELLULAR_INDEX]) ||
-              (is_SCL_ARRAY[SECRETED_INDEX]) || (has_GO_ARRAY[GO_EXTRACELLULAR_INDEX]) ||
-              (has_GO_ARRAY[GO_ECM_INDEX]))
-            hum_extracellular++;
-
-          if ((is_SCL_ARRAY[NUCLEUS_INDEX]) || (is_SCL_ARRAY[TELOMERE_INDEX]) ||
-              (has_GO_ARRAY[GO_NUCLEUS_INDEX]) || (has_GO_ARRAY[GO_DNA_BIND_INDEX]))
-            hum_nuclear++;
-        }//----  HUMAN DATA -----//
-
-       /*****************************************************************
-       * TOTAL DATA 
-       *****************************************************************/
-        if (is_FT_TRANSMEM)
-          tot_transmem++;
-        if (!has_SCL) {
-          tot_SCL_NULL++;
-          is_REMAINDER = FALSE;
-        }
-        if (is_REMAINDER) 
-          tot_REMAINDER++;
-        if (is_muscle) 
-          tot_muscle++;
-        if (is_brain) 
-          tot_brain++;
-        if (is_FT_LIPID)
-          tot_lipid_bind++;
-        if (has_DR_GO)
-          tot_DR_GO++;
-        if (is_FT_INTRAMEM)
-          tot_intramem++;
-        if ((is_FT_INTRAMEM)&&(is_FT_TRANSMEM))
-          tot_itmem++;
-        if (is_FT_TD_extracellular)
-          tot_extracellular++;
-        if (is_FT_TD_cytoplasmic)
-          tot_cytoplasmic++;
-        if (has_FT_SIGNAL)
-          tot_SIGNAL++;
-        if (has_FT_DNA_BIND)
-          tot_DNA_BIND++;
-        if ((has_FT_SIGNAL) && (is_FT_TRANSMEM))
-          tot_SIG_TRANSMEM++;
-        for(i=0;i<REGEX_COUNT;i++) 
-           if(is_SCL_ARRAY[i])
-              tot_SCL_ARRAY[i]++;
-
-        for(i=0;i<GO_COUNT;i++) 
-           if(has_GO_ARRAY[i])
-              tot_GO_ARRAY[i]++;
-
-        for(i=0;i<GO_MINOR_COUNT;i++) 
-           if(has_GO_MINOR_ARRAY[i])
-              tot_GO_MINOR_ARRAY[i]++;
-
-        if ((is_FT_TRANSMEM) || (is_FT_INTRAMEM) || (is_FT_LIPID) || 
-            (is_SCL_ARRAY[CELL_SURF_INDEX]) || (is_SCL_ARRAY[CELL_MEMB_INDEX])
-            || (is_SCL_ARRAY[MEMB_INDEX]) )
-        {
-          tot_membrane++;
-          if (is_brain)
-            brain_membrane++;
-          if (is_muscle)
-            muscle_membrane++;
-        }
-
-        if ((is_SCL_ARRAY[CYTOPLASM_INDEX]) || (is_SCL_ARRAY[CYTOSOL_INDEX]) ||
-            (is_SCL_ARRAY[SOLUBLE_INDEX]) || (has_GO_ARRAY[GO_CYTOSOL_INDEX]) ||
-            (has_GO_ARRAY[GO_CYTOPLASM_INDEX]))
-        {
-          tot_cytoplasmic++;
-          if (is_brain)
-            brain_cytoplasmic++;
-          if (is_muscle)
-            muscle_cytoplasmic++;
-        }
-
-        if ((has_FT_SIGNAL) || (is_SCL_ARRAY[EXTRACELLULAR_INDEX]) ||
-            (is_SCL_ARRAY[SECRETED_INDEX]) || (has_GO_ARRAY[GO_EXTRACELLULAR_INDEX]) ||
-            (has_GO_ARRAY[GO_ECM_INDEX]))
-        {
-          tot_extracellular++;
-          if (is_brain)
-            brain_extracellular++;
-          if (is_muscle)
-            muscle_extracellular++;
-        }
-
-        if ((is_SCL_ARRAY[NUCLEUS_INDEX]) || (is_SCL_ARRAY[TELOMERE_INDEX]) ||
-            (has_GO_ARRAY[GO_NUCLEUS_INDEX]) || (has_GO_ARRAY[GO_DNA_BIND_INDEX]))
-        {
-          tot_nuclear++;
-          if (is_brain)
-            brain_nuclear++;
-          if (is_muscle)
-            muscle_nuclear++;
-        }
-
-    /*****************************************************************
-     *   RESET this protein data
-     *****************************************************************/
-        n_prot_lines = 0;
-        this_prot_chars= 0;
-        this_is_human = FALSE;
-        is_FT_TRANSMEM = FALSE;
-        is_REMAINDER = TRUE;
-        is_GO_REMAINDER = TRUE;
-        is_FT_INTRAMEM = FALSE;
-        is_FT_LIPID = FALSE;
-        is_brain = FALSE;
-        is_muscle = FALSE;
-        has_FT_SIGNAL = FALSE;
-        has_SCL = FALSE;
-        has_DR_GO = FALSE;
-        has_FT_DNA_BIND = FALSE;
-        has_FT_SIG_TRANSMEM = FALSE;
-        is_FT_TD_extracellular = FALSE;
-        is_FT_TD_cytoplasmic = FALSE;
-        in_SCL = FALSE;
-        is_FLAGGED = FALSE;
-
-        for(i=0;i<REGEX_COUNT;i++) 
-           is_SCL_ARRAY[i] = FALSE;
-
-        for(i=0;i<GO_COUNT;i++) 
-           has_GO_ARRAY[i] = FALSE;
-
-        for(i=0;i<GO_MINOR_COUNT;i++) 
-           has_GO_MINOR_ARRAY[i] = FALSE;
-
-      }// ---if ((block[line_begin] == '/')&&(block[line_begin+1] == '/'))---// 
-
-    /*****************************************************************
-     *  Done with End Record processing 
-     *****************************************************************/
-
-#if 1
-      if ((block[line_begin] == 'R')&&(block[line_begin+1] == 'C')) {
-    /*****************************************************************
-     *
-     *  Reference Comment (RC) line
-     *
-     *  http://ca.expasy.org/sprot/userman.html#RC_line
-     *
-     *****************************************************************/
-        for(i=0;i<b+1;i++)
-          line[i] = block[line_begin+i];
-        line[i] = '\0';
-        if (!(regexec(&rgx_muscle, line, (size_t)0,NULL,0))) {
-          is_muscle = TRUE;
-        }
-        if (!(regexec(&rgx_brain, line, (size_t)0,NULL,0))) {
-          is_brain = TRUE;
-        }
-        for(i=0;i<b+2;i++)
-          line[i] = '\0';
-
-      }//---if ((block[line_begin] == 'R')&&(block[line_begin+1] == 'C'))---// 
-#endif
-
-      if ((block[line_begin] == 'O')&&(block[line_begin+1] == 'S')) {
-    /*****************************************************************
-     *
-     *  Organism Species (OS) line
-     *
-     *  http://ca.expasy.org/sprot/userman.html#OS_line
-     *
-     *****************************************************************/
-        if ((block[line_begin+5] == 'H')&&(block[line_begin+7] == 'm') 
-             &&(block[line_begin+10] == 's')) {
+  if (cache_dir != NULL) {
     /*****************************************************************
-     *    Human protein (Homo Sapiens)
+     *  Same file, rules and cubes as a saved run: report from the
+     *  cache.  The per-protein outputs still need a scan.
      *****************************************************************/
-          tot_human_proteins++;
-          this_is_human = TRUE;
-        } 
-     } 
-
-     if ((block[line_begin] == 'F')&&(block[line_begin+1] == 'T') ) {
-        /*****************************************************************
-        *
-        *  Feature Table (FT) line
-        *
-        *  http://www.expasy.org/sprot/userman.html#FT_line
-        *
-        *****************************************************************/
-          if ((block[line_begin+5] == 'T') && (block[line_begin+6] == 'R') &&
-              (block[line_begin+7] == 'A') && (block[line_begin+8] == 'N') &&
-              (block[line_begin+9] == 'S') && (block[line_begin+10] == 'M') &&
-              (block[line_begin+11] == 'E') && (block[line_begin+12] == 'M')) {
-              is_FT_TRANSMEM = TRUE;
-              is_REMAINDER = FALSE;
-          } //--- if FT  TRANSMEM ----//
-
-          if ((block[line_begin+5] == 'L') && (block[line_begin+6] == 'I') &&
-              (block[line_begin+7] == 'P') && (block[line_begin+8] == 'I') &&
-              (block[line_begin+9] == 'D')) {
-              is_FT_LIPID= TRUE;
-              is_REMAINDER = FALSE;
-          } //--- if FT LIPID ----//
-
-          if ((block[line_begin+5] == 'I') && (block[line_begin+6] == 'N') &&
-              (block[line_begin+7] == 'T') && (block[line_begin+8] == 'R') &&
-              (block[line_begin+9] == 'A') && (block[line_begin+10] == 'M') &&
-              (block[line_begin+11] == 'E') && (block[line_begin+12] == 'M')) {
-              is_FT_INTRAMEM = TRUE;
-              is_REMAINDER = FALSE;
-          } //--- if FT  INTRAMEM ----//
-
-          if ((block[line_begin+5] == 'S') && (block[line_begin+6] == 'I') &&
-              (block[line_begin+7] == 'G') && (block[line_begin+8] == 'N') &&
-              (block[line_begin+9] == 'A') && (block[line_begin+10] == 'L')) {
-              has_FT_SIGNAL = TRUE;
-              is_REMAINDER = FALSE;
-          } //--- if FT  SIGNAL ----//
-          if ((block[line_begin+5] == 'D') && (block[line_begin+6] == 'N') &&
-              (block[line_begin+7] == 'A') && (block[line_begin+8] == '_') &&
-              (block[line_begin+9] == 'B') && (block[line_begin+10] == 'I') &&
-              (block[line_begin+11] == 'N') && (block[line_begin+12] == 'D')) {
-              has_FT_DNA_BIND = TRUE;
-              is_REMAINDER = FALSE;
-          } //--- if FT  DNA_BIND----//
-
-        } //---if ((block[line_begin] == 'F')&&(block[line_begin+1] == 'T')) {
-
-
-        if ((block[line_begin] == 'C')&&(block[line_begin+1] == 'C')) {
-        /*****************************************************************
-        *
-        *  Comment Block (CC) line
-        *
-        *  http://www.expasy.org/sprot/userman.html#CC_line
-        *
-        *****************************************************************/
-           if ((block[line_begin+9] == 'S') && (block[line_begin+10] == 'U')&&
-               (block[line_begin+11] == 'B') && (block[line_begin+12] == 'C')&&
-               (block[line_begin+13] == 'E') && (block[line_begin+14] == 'L')&&
-               (block[line_begin+15] == 'L') && (block[line_begin+16] == 'U')&&
-               (block[line_begin+17] == 'L') && (block[line_begin+18] == 'A')&&
-               (block[line_begin+19] == 'R') && (block[line_begin+21] == 'L')&&
-               (block[line_begin+22] == 'O') && (block[line_begin+23] == 'C')&&
-               (block[line_begin+24] == 'A') && (block[line_begin+25] == 'T')&&
-               (block[line_begin+26] == 'I') && (block[line_begin+27] == 'O')&&
-               (block[line_begin+5] == '-')&&(block[line_begin+6] == '!') &&
-               (block[line_begin+7] == '-') && (block[line_begin+28] == 'N')) {
-            /*****************************************************************
-             *
-             *  CC   -!-  SUBCELLULAR LOCATION
-             *
-              *****************************************************************/
-                has_SCL = TRUE;
-                in_SCL = TRUE;
-             } //---  CC   -!-  SUBCELLULAR LOCATION ----//
-             else {
-               if (((block[line_begin+5] == '-')&&(block[line_begin+6] == '!') &&
-                 (block[line_begin+7] == '-'))||
-                   ((block[line_begin+5] == '-')&&(block[line_begin+6] == '-') &&
-                  (block[line_begin+7] == '-')))
-                    in_SCL = FALSE;
-             }
-             if (in_SCL)  {
-                 #if 1
-                 for(i=0;i<b+1;i++)
-                    line[i] = block[line_begin+i];
-                 line[i] = '\0';
-                 #endif
-                 
-                 for(i=0;i<REGEX_COUNT;i++) {
-                    if (!(regexec(&rgx_array[i], line, (size_t)0,NULL,0))) {
-                       is_SCL_ARRAY[i] = TRUE;
-                       is_REMAINDER = FALSE;
-                    }
-                 }
-             } 
-
-        } //---if ((block[line_begin] == 'C')&&(block[line_begin+1] == 'C')) {
-
-     if ((block[line_begin] == 'D')&&(block[line_begin+1] == 'R') ) {
-        /*****************************************************************
-         *
-         *  DR -!-  Database cross-Reference 
-         *
-         *****************************************************************/
-
-         if ((block[line_begin+5] == 'G')&&(block[line_begin+6] == 'O') ) {
-            /*****************************************************************
-             *
-             *  GO  -!-  Gene Ontology reference 
-             *
-             *****************************************************************/
-             for(i=0;i<b+1;i++)
-               line[i] = block[line_begin+i];
-             line[i] = '\0';
-
-             for(i=0;i<GO_COUNT;i++) {
-                if (!(regexec(&rgx_GO_array[i], line, (size_t)0,NULL,0))) {
-                   has_GO_ARRAY[i] = TRUE;
-                   is_REMAINDER = FALSE;
-                   is_GO_REMAINDER = FALSE;
-                }
-             }
-
-             for(i=0;i<GO_MINOR_COUNT;i++) {
-                if (!(regexec(&rgx_GO_minor_array[i], line, (size_t)0,NULL,0))) {
-                   has_GO_MINOR_ARRAY[i] = TRUE;
-                   is_REMAINDER = FALSE;
-                   is_GO_REMAINDER = FALSE;
-                }
-             }
-             
-             if (is_GO_REMAINDER)
-                write(fd_GO_REMAINDER,line,b+1);
-         } //--- ((block[line_begin+5] == 'G')&&(block[line_begin+6] == 'O') ) ---//
- 
-     } //--- if ((block[line_begin] == 'D')&&(block[line_begin+1] == 'R') ) ---// 
-
-        if (is_REMAINDER) 
-            write(fd_REMAINDER,line,b+1);
-
-        last_lbegin = line_begin;
-        line_begin += b + 1;
-        if (line_begin >= bytes_read) {
-          block_done = TRUE;
-        }
+    if ((index_path == NULL) && (list_path == NULL) && (export_path == NULL) &&
+        (cache_load(cache_dir, &key, &sum, &cached) == 0)) {
+      metrics_begin(&met, MX_OUTPUT);
+      summary_write(&sum, format, STDOUT);
+      metrics_end(&met, MX_OUTPUT);
+      metrics_begin(&met, MX_RENDER);
+      summary_cellgrams(&sum);
+      metrics_end(&met, MX_RENDER);
+      if (metrics_format == FORMAT_JSON)
+        metrics_print_json(&met, stderr);
+      else if (metrics_format == FORMAT_TEXT)
+        metrics_print(&met, stderr);
+      cellgram_book_close(ro.book);
+      rcache_close(ro.rc);
+      perfctr_close(met.pc);
+      for (j=0;j<=n_specs;j++)
+        crosstab_free(cached[j]);
+      free(cached);
+      close(fd);
+      return GOOD_EXIT;
+    }
+  }
 
-      }//----- while (!block_done)-----// 
+  if ((list_path != NULL) &&
+      ((fd_list = open( list_path, O_WRONLY|O_CREAT|O_TRUNC, 0644 )) < 0)) {
+    sprintf(err_msg,"CAN'T OPEN FILE: %s \ncause", list_path);
+    perror(err_msg);
+    return BAD_DATAFILE; 
+  }
 
-    /*****************************************************************
-     * wrap up flip
-     *****************************************************************/
-    if (line_begin != bytes_read)
-      this_seek += BLOCKSIZE;
-    block_done = FALSE;
-    lseek(fd, (off_t) this_seek, SEEK_SET);  
-    
-  }//----- while (!done)  was ((bytes_read = read(fd, block, BLOCKSIZE)) > 0) -----// 
+  /********************************************************
+   *
+   *   Cut the file, or the --range shard of it, into
+   *   n_threads byte ranges that each begin on an entry,
+   *   and give every range its own descriptor, block,
+   *   compiled regexes, cubes and index.
+   *
+   ********************************************************/
+  metrics_begin(&met, MX_SETUP);
+  range_start = snap_to_record(fd, range_start);
+  if ((range_end != LLONG_MAX) &&
+      ((range_end = snap_to_record(fd, range_end)) >= statbuf.st_size))
+    range_end = LLONG_MAX;            /* the last shard reads on to EOF */
+  if (range_end < range_start)
+    range_end = range_start;
+  span = ((range_end < statbuf.st_size) ? range_end : statbuf.st_size) - range_start;
+  if (span < 0)
+    span = 0;
+  for (k=0;k<n_threads;k++) {
+    bounds[k] = snap_to_record(fd, range_start + k*span/n_threads);
+    if ((bounds[k] > range_end) || (bounds[k] >= statbuf.st_size))
+      bounds[k] = range_end;
+  }
+  bounds[0] = range_start;
+  bounds[n_threads] = range_end;
+  /* small files snap several cuts onto the same entry or onto EOF; drop the
+     empty ranges so every scanner has bytes of its own */
+  for (j=0,k=1;k<=n_threads;k++)
+    if (bounds[k] > bounds[j])
+      bounds[++j] = bounds[k];
+  n_threads = (j > 0) ? j : 1;
+  bounds[n_threads] = range_end;
+
+  for (k=0;k<n_threads;k++) {
+    memset(&st[k], 0, sizeof(struct scan_state));
+    if ((st[k].fd = open( argv[file_arg], O_RDONLY )) < 0) {
+      sprintf(err_msg,"CAN'T OPEN FILE: %s \ncause", argv[file_arg]);
+      perror(err_msg);
+      return BAD_DATAFILE; 
+    }
+    if (compile_rules(&rules[k]))
+      exit(REGEX_ERR);
+    rules[k].seq = seq_stages;
+    st[k].rules = &rules[k];
+    st[k].start = bounds[k];
+    st[k].end = bounds[k+1];
+    st[k].origin = bounds[k];
+    st[k].blocksize = BLOCKSIZE;
+    metrics_init(&thread_met[k]);
+    st[k].met = &thread_met[k];
+    switch (alloc_type) { 
+       case 'm':
+         st[k].block = malloc(BLOCKSIZE);
+         break;
+       case 'p':
+         posix_memalign((void **)&st[k].block,PAGESIZE,BLOCKSIZE);
+         break;
+       case 'a':
+         st[k].block = alloca(BLOCKSIZE);
+         break;
+       case 'v':
+         st[k].block = valloc(BLOCKSIZE);
+         break;
+       default:
+         st[k].block = valloc(BLOCKSIZE);
+    } //--- switch (alloc_type) ---//
+    st[k].line = malloc((MAXLINE+2)*sizeof(char));
+
+    st[k].n_cubes = 1 + n_specs;
+    st[k].cubes = malloc(st[k].n_cubes*sizeof(struct crosstab *));
+    if ((st[k].cubes[0] = crosstab_new(REPORT_SPEC)) == NULL)
+      return BAD_ARGC;
+    for (j=0;j<n_specs;j++)
+      if ((st[k].cubes[1+j] = crosstab_new(xt_specs[j])) == NULL)
+        return BAD_ARGC;
+    if ((index_path != NULL) && ((st[k].ix = pindex_new()) == NULL))
+      return BAD_DATAFILE;
+    if ((list_path != NULL) && ((st[k].pl = plist_new(k ? -1 : fd_list)) == NULL))
+      return BAD_DATAFILE;
+    if ((export_path != NULL) &&
+        ((st[k].cx = colx_new(k ? NULL : export_path)) == NULL))
+      return BAD_DATAFILE;
+  } //--- for (k=0;k<n_threads;k++) ---//
+
+  if (ckpt_path != NULL) {
+    ckpt = checkpoint_new(ckpt_path, &key, n_threads, 1 + n_specs, ckpt_interval);
+    for (k=0;k<n_threads;k++) {
+      st[k].ckpt = ckpt;
+      st[k].ckpt_slot = k;
+      st[k].ckpt_countdown = 1;
+    }
+    if ((resume) && (checkpoint_load(ckpt, st) < 0))
+      return BAD_DATAFILE;
+  }
+  metrics_end(&met, MX_SETUP);
+  
+  if (clock_gettime(CLOCK_MONOTONIC, &t_begin)) {
+    sprintf(err_msg, "failed to get start time\n\0");
+    perror(err_msg);
+    return TIME_ERR;
+  }
 
-  hum_membrane -= hum_SIGNAL;
-  tot_membrane -= tot_SIGNAL;
+  if (progress_interval > 0)
+    pg = progress_start(st, n_threads, span, progress_interval, status_path);
+  metrics_begin(&met, MX_SCAN);
+  if (n_threads == 1)
+    scan_range(&st[0]);
+  else {
+    for (k=0;k<n_threads;k++)
+      if (pthread_create(&tid[k], NULL, scan_thread, &st[k])) {
+        sprintf(err_msg, "CAN'T START SCANNING THREAD %d\ncause", k);
+        perror(err_msg);
+        return BAD_DATAFILE;
+      }
+    for (k=0;k<n_threads;k++)
+      pthread_join(tid[k], NULL);
+  }
+  metrics_end(&met, MX_SCAN);
+  progress_stop(pg);
 
-  if (clock_gettime(CLOCK_REALTIME, &t_end)) {
+  /********************************************************
+   *   Merge the ranges, in file order, into range 0
+   ********************************************************/
+  metrics_begin(&met, MX_MERGE);
+  report = st[0].cubes[0];
+  ix = st[0].ix;
+  tot_proteins = st[0].tot_proteins;
+  line_num = st[0].line_num;
+  char_count = st[0].char_count;
+  max_line = st[0].max_line;
+  max_prot_lines = st[0].max_prot_lines;
+  max_prot_chars = st[0].max_prot_chars;
+  corrupt_infile = st[0].corrupt_infile;
+  for (k=1;k<n_threads;k++) {
+    for (j=0;j<st[0].n_cubes;j++)
+      crosstab_merge(st[0].cubes[j], st[k].cubes[j]);
+    if (ix != NULL)
+      pindex_merge(ix, st[k].ix, tot_proteins);
+    if (st[0].pl != NULL) {
+      list_status |= plist_append(st[0].pl, st[k].pl);
+      list_status |= plist_close(st[k].pl);
+    }
+    if (st[0].cx != NULL) {
+      export_status |= colx_append(st[0].cx, st[k].cx);
+      export_status |= colx_close(st[k].cx);
+    }
+    tot_proteins += st[k].tot_proteins;
+    line_num += st[k].line_num;
+    char_count += st[k].char_count;
+    if (st[k].max_line > max_line)
+      max_line = st[k].max_line;
+    if (st[k].max_prot_lines > max_prot_lines)
+      max_prot_lines = st[k].max_prot_lines;
+    if (st[k].max_prot_chars > max_prot_chars)
+      max_prot_chars = st[k].max_prot_chars;
+    corrupt_infile |= st[k].corrupt_infile;
+  }
+  if (st[0].pl != NULL) {
+    list_status |= plist_close(st[0].pl);
+    close(fd_list);
+  }
+  if (st[0].cx != NULL)
+    export_status |= colx_close(st[0].cx);
+  metrics_end(&met, MX_MERGE);
+  for (k=0;k<n_threads;k++)
+    metrics_merge(&met, &thread_met[k]);
+  met.ph[MX_SCAN].bytes = met.ph[MX_READ].bytes;
+  met.ph[MX_SCAN].records = tot_proteins;
+  met.ph[MX_SCAN].lines = line_num;
+
+  if (clock_gettime(CLOCK_MONOTONIC, &t_end)) {
     sprintf(err_msg,"failed to get end time\n\0");
     perror(err_msg);
     return TIME_ERR;
   }
+  metrics_begin(&met, MX_OUTPUT);
+  if (ix != NULL)
+    index_status = pindex_write(ix, index_path);
+
     /*****************************************************************
      *
      *  OUTPUT RESULTS
      *
      *****************************************************************/
-  printf("----------------------------------------\n"); 
-  printf("processing %s \n", argv[file_arg] ); 
-  printf("the memory allocation method is %s\n",mem_method); 
-  printf("The longest line has %d characters\n",max_line);
-  printf("There are a total of %d lines\n",line_num);
-  printf("--------HUMAN PROTEINS--------------------\n"); 
-  printf("human proteins: %d\n",tot_human_proteins);
-  printf("human FT TRANSMEM proteins: %d\n",hum_transmem);
-  printf("human FT INTRAMEM proteins: %d\n",hum_intramem);
-  printf("human proteins with covalent lipid binding (FT LIPID): %d\n",hum_lipid_bind);
-  printf("human proteins both intra- & trans- membrane: %d\n",hum_itmem);
-  printf("human FT SIGNAL signal peptide containing proteins: %d\n",hum_SIGNAL);
-  printf("human proteins with both signal sequence and transmembrane: %d\n",hum_SIG_TRANSMEM);
-  printf("human proteins with DNA_BIND: %d\n",hum_DNA_BIND);
-
-  for(i=0;i<REGEX_COUNT;i++) 
-     printf("%d: human proteins with CC SUBCELLULAR LOCATION \"%s\": %d\n",
-         i, NAMES_ARRAY[i], hum_SCL_ARRAY[i]);
-
-  for(i=0;i<GO_COUNT;i++) 
-     printf("%d: human proteins with Gene Ontology \"%s\": %d\n",
-         i, GO_NAMES_ARRAY[i], hum_GO_ARRAY[i]);
-
-  printf("human proteins with no CC SUBCELLULAR LOCATION annotation: %d\n",hum_SCL_NULL);
-  printf("human total membrane proteins: %d\n",hum_membrane);
-  printf("human cytoplasmic proteins: %d\n",hum_cytoplasmic);
-  printf("human extracellular proteins: %d\n",hum_extracellular);
-  printf("human nuclear proteins: %d\n",hum_nuclear);
-  printf("REMAINDER human proteins: %d\n",hum_REMAINDER);
-  printf("----------------------------------------\n"); 
-
-  printf("There are %d total proteins \n",tot_proteins);
-  printf("total FT TRANSMEM proteins: %d\n",tot_transmem);
-  printf("total FT INTRAMEM proteins: %d\n",tot_intramem);
-  printf("total proteins with covalent lipid binding: %d\n",tot_lipid_bind);
-  printf("total proteins both intra- & trans- membrane: %d\n",tot_itmem);
-  printf("total FT SIGNAL signal peptide containing proteins: %d\n",tot_SIGNAL);
-  printf("total proteins with both signal sequence and transmembrane: %d\n",tot_SIG_TRANSMEM);
-  printf("total proteins with DNA_BIND: %d\n",tot_DNA_BIND);
-
-  for(i=0;i<REGEX_COUNT;i++) 
-     printf("%d: total proteins with CC SUBCELLULAR LOCATION \"%s\": %d\n",
-         i, NAMES_ARRAY[i], tot_SCL_ARRAY[i]);
-
-  for(i=0;i<GO_COUNT;i++) 
-     printf("%d: total proteins with Gene Ontology \"%s\": %d\n",
-         i, GO_NAMES_ARRAY[i], tot_GO_ARRAY[i]);
-
-  printf("total proteins with no CC SUBCELLULAR LOCATION annotation: %d\n",tot_SCL_NULL);
-  printf("total total membrane proteins: %d\n",tot_membrane);
-  printf("total cytoplasmic proteins: %d\n",tot_cytoplasmic);
-  printf("total extracellular proteins: %d\n",tot_extracellular);
-  printf("total nuclear proteins: %d\n",tot_nuclear);
-  printf("REMAINDER total proteins: %d\n",tot_REMAINDER);
-  printf("----------------------------------------\n"); 
-  printf("total brain proteins: %d\n",tot_brain);
-  printf("brain nuclear proteins: %d\n",brain_nuclear);
-  printf("brain cytoplasmic proteins: %d\n",brain_cytoplasmic);
-  printf("brain membrane proteins: %d\n",brain_membrane);
-  printf("brain extracellular proteins: %d\n",brain_extracellular);
-  printf("----------------------------------------\n"); 
-  printf("total muscle proteins: %d\n",tot_muscle);
-  printf("muscle nuclear proteins: %d\n",muscle_nuclear);
-  printf("muscle cytoplasmic proteins: %d\n",muscle_cytoplasmic);
-  printf("muscle membrane proteins: %d\n",muscle_membrane);
-  printf("muscle extracellular proteins: %d\n",muscle_extracellular);
-  printf("----------------------------------------\n"); 
-  printf("The protein with the most lines has %d lines\n",max_prot_lines);/**/
-  printf("BLOCKSIZE IS %d\n",BLOCKSIZE);
-  printf("it took");
-  print_interval(&t_begin,&t_end);
-  printf(" to run.\n");
-  printf("----------------------------------------\n"); 
-    /*****************************************************************
-     *
-     *****************************************************************/
-  cellgram("human",argv[file_arg],(double)hum_nuclear,(double)hum_cytoplasmic,
-      (double)hum_membrane,(double)hum_extracellular); 
-  cellgram("total",argv[file_arg],(double)tot_nuclear,(double)tot_cytoplasmic,
-      (double)tot_membrane,(double)tot_extracellular);
-  cellgram("brain",argv[file_arg],(double)brain_nuclear,(double)brain_cytoplasmic,
-      (double)brain_membrane,(double)brain_extracellular);
-  cellgram("muscle",argv[file_arg],(double)muscle_nuclear,(double)muscle_cytoplasmic,
-      (double)muscle_membrane,(double)muscle_extracellular);
+  sum.tot_proteins = tot_proteins;
+  sum.line_num = line_num;
+  sum.char_count = char_count;
+  sum.max_line = max_line;
+  sum.max_prot_lines = max_prot_lines;
+  sum.max_prot_chars = max_prot_chars;
+  sum.corrupt_infile = corrupt_infile;
+  sum.t_begin = t_begin;
+  sum.t_end = t_end;
+  sum.report = report;
+  sum.n_cubes = st[0].n_cubes - 1;
+  sum.cubes = st[0].cubes + 1;
+  sum.index_path = ((ix != NULL) && (index_status == 0)) ? index_path : NULL;
+  sum.list_path = ((list_path != NULL) && (list_status == 0)) ? list_path : NULL;
+  sum.export_path = ((export_path != NULL) && (export_status == 0)) ? export_path : NULL;
+  if (partial_path != NULL) {
+    /*  the report and cellgrams are promog-merge's, over all shards  */
+    if (partial_write(partial_path, &key, range_start, range_end, &sum) < 0)
+      return BAD_DATAFILE;
+  }
+  else
+    summary_write(&sum, format, STDOUT);
+  if (cache_dir != NULL)
+    cache_store(cache_dir, &key, &sum);
+  metrics_end(&met, MX_OUTPUT);
+  metrics_begin(&met, MX_RENDER);
+  if (partial_path == NULL)
+    summary_cellgrams(&sum);
+  metrics_end(&met, MX_RENDER);
+  if (metrics_format == FORMAT_JSON)
+    metrics_print_json(&met, stderr);
+  else if (metrics_format == FORMAT_TEXT)
+    metrics_print(&met, stderr);
+  cellgram_book_close(ro.book);
+  rcache_close(ro.rc);
+  perfctr_close(met.pc);
+  checkpoint_free(ckpt, TRUE);     /* finished: nothing to resume */
+
+  for (k=0;k<n_threads;k++) {
+    for (j=0;j<st[k].n_cubes;j++)
+      crosstab_free(st[k].cubes[j]);
+    free(st[k].cubes);
+    pindex_free(st[k].ix);
+    free_rules(&rules[k]);
+    if ((alloc_type != 'a') && (st[k].block != NULL))
+      free(st[k].block);
+    free(st[k].line);
+    close(st[k].fd);
+  }
   close(fd);
-  return GOOD_EXIT;
+  return list_status ? BAD_LISTFILE : GOOD_EXIT;
 }// int main (int argc, char *argv[]) -----//
 
 
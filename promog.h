@@ -0,0 +1,693 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#ifndef PROMOG_H
+#define PROMOG_H
+
+#include <stdio.h>
+#include <time.h>
+#include <regex.h>
+#include <sys/stat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************************************************************
+ *  Term table sizes (see terms.c)
+ *********************************************************************/
+#define REGEX_COUNT     45
+#define GO_COUNT         9
+#define GO_MINOR_COUNT   4
+#define FT_COUNT         5
+#define COMP_COUNT       4
+
+/*********************************************************************
+ *  Determinants of "membrane" count
+ *********************************************************************/
+#define MEMB_INDEX            1
+#define CELL_MEMB_INDEX       0
+#define CELL_SURF_INDEX      21
+#define GO_PMEMB_INDEX        6
+#define GO_INT_MEMB_INDEX     4
+
+/*********************************************************************
+ *  Determinants of "cytoplasmic" count
+ *********************************************************************/
+#define CYTOPLASM_INDEX       2
+#define CYTOSOL_INDEX         3
+#define SOLUBLE_INDEX        41
+#define GO_CYTOSOL_INDEX      7
+#define GO_CYTOPLASM_INDEX    2
+
+/*********************************************************************
+ *  Determinants of "extracellular" count
+ *********************************************************************/
+#define EXTRACELLULAR_INDEX   4
+#define SECRETED_INDEX        5
+#define GO_EXTRACELLULAR_INDEX 3
+#define GO_ECM_INDEX          5
+
+/*********************************************************************
+ *  Determinants of "nucleus" count
+ *********************************************************************/
+#define NUCLEUS_INDEX         6
+#define TELOMERE_INDEX       30
+#define GO_NUCLEUS_INDEX      0
+#define GO_DNA_BIND_INDEX     8
+
+/*********************************************************************
+ *  Compartment bits of prot_record.compartments, in the order of
+ *  the four compartment model (and of the cellgram() arguments).
+ *********************************************************************/
+#define COMP_NUCLEAR        (1<<0)
+#define COMP_CYTOSOLIC      (1<<1)
+#define COMP_MEMBRANE       (1<<2)
+#define COMP_EXTRACELLULAR  (1<<3)
+
+/*********************************************************************
+ *  FT feature order of FT_NAMES_ARRAY
+ *********************************************************************/
+#define FT_TRANSMEM_INDEX     0
+#define FT_INTRAMEM_INDEX     1
+#define FT_LIPID_INDEX        2
+#define FT_SIGNAL_INDEX       3
+#define FT_DNA_BIND_INDEX     4
+
+#define ACC_WIDTH            10   /* longest UniProt accession */
+#define ORGANISM_LEN         64
+#define MAX_TISSUES          16
+#define TISSUE_LEN           64
+#define MAX_KEYWORDS         32
+#define KEYWORD_LEN          48
+#define SEQ_MAX_LEN      262144   /* residues kept of one SQ block */
+
+/*********************************************************************
+ *  Sequence stages: what is read from the SQ block (see seq.c)
+ *********************************************************************/
+#define SEQ_TM                1   /* --predict-tm: hydropathy TM segments */
+#define SEQ_STATS             2   /* --seq-stats: composition, length, N-terminus */
+
+#define SEQ_AA_COUNT         21   /* the 20 standard residues, then all others */
+#define SEQ_LEN_BINS          6   /* <100, then doubling to 1600+ */
+#define SEQ_NTERM_BINS        4   /* N-terminal hydropathy <0, 0-1, 1-2, 2+ */
+
+#define KD_WINDOW            19   /* residues averaged per hydropathy window */
+#define SEQ_SCRATCH(n)       ((n) + KD_WINDOW + 2*16)   /* shorts for seq_tm_segments() */
+
+/*********************************************************************
+ *  arena: bump allocation, freed all at once (see arena.c)
+ *********************************************************************/
+#define ARENA_BLOCK        4096      /* first block, unless arena_init() says */
+
+struct arena_block;
+
+struct arena {
+  struct arena_block *first, *cur;
+  char *p, *end;                     /* free space in cur */
+  size_t block_size;
+  size_t done;                       /* bytes of the blocks before cur */
+  size_t peak, reserved;
+};
+
+/*********************************************************************
+ *  prot_record
+ *
+ *  Everything promog learns about one entry between its ID line
+ *  and its // terminator.  The scan loop fills it line by line and
+ *  hands it to the report counters and the optional sinks (index,
+ *  per-protein listings) at END OF RECORD.
+ *********************************************************************/
+struct prot_record {
+  long long ordinal;                 /* 0-based entry number in the scan */
+  int taxid;                         /* OX NCBI_TaxID, 0 if absent */
+  int evidence;                      /* PE level 1-5, 0 if absent */
+  int is_human, is_brain, is_muscle;
+  int is_FT_TRANSMEM, is_FT_INTRAMEM, is_FT_LIPID;
+  int has_FT_SIGNAL, has_FT_DNA_BIND;
+  int is_REMAINDER, is_GO_REMAINDER, has_SCL, has_DR_GO, in_SCL;
+  int is_SCL_ARRAY[REGEX_COUNT];
+  int has_GO_ARRAY[GO_COUNT];
+  int has_GO_MINOR_ARRAY[GO_MINOR_COUNT];
+  int compartments;                  /* COMP_* bits, set at END OF RECORD */
+  int n_tissues, n_keywords;
+  int in_SQ, seq_len, seq_stages;    /* SEQ_* asked of this entry's SQ block */
+  int tm_segments;                   /* predicted by hydropathy, with SEQ_TM */
+  int seq_counts[SEQ_AA_COUNT];      /* residues of each kind, with SEQ_STATS */
+  int nterm_kd;                      /* ... N-terminal hydropathy, x 10 */
+  char accession[ACC_WIDTH+1];       /* primary (first) AC */
+  char organism[ORGANISM_LEN];       /* OS species, without the common name */
+
+  /*  reset_record() only clears what comes before this point  */
+  char *tissues[MAX_TISSUES];        /* RC TISSUE= values */
+  char *keywords[MAX_KEYWORDS];      /* KW values */
+  char *seq;                         /* seq_len residues, with seq_stages */
+  int seq_cap;
+  struct arena arena;                /* their strings; reset with the record */
+};
+
+/*********************************************************************
+ *  Per-record measures: what the cross-tabulations count.  Each is
+ *  0 or 1 for one protein, but for the residue counts from M_RESIDUES
+ *  on; see record_measures().  The group report keeps the first
+ *  REPORT_MEASURES, the "all" of a cube spec.
+ *********************************************************************/
+#define M_PROTEINS        0
+#define M_COMP            1                       /* + COMP bit number */
+#define M_NUCLEAR         (M_COMP+0)
+#define M_CYTOSOLIC       (M_COMP+1)
+#define M_MEMBRANE        (M_COMP+2)
+#define M_EXTRACELLULAR   (M_COMP+3)
+#define M_FT              (M_COMP+COMP_COUNT)     /* + FT_*_INDEX */
+#define M_ITMEM           (M_FT+FT_COUNT)         /* INTRAMEM and TRANSMEM */
+#define M_SIG_TRANSMEM    (M_ITMEM+1)             /* SIGNAL and TRANSMEM */
+#define M_SCL_NULL        (M_ITMEM+2)
+#define M_REMAINDER       (M_ITMEM+3)
+#define M_DR_GO           (M_ITMEM+4)
+#define M_SCL             (M_ITMEM+5)             /* + REGEX index */
+#define M_GO              (M_SCL+REGEX_COUNT)     /* + GO index */
+#define M_GO_MINOR        (M_GO+GO_COUNT)         /* + GO minor index */
+#define M_PREDICTED       (M_GO_MINOR+GO_MINOR_COUNT)   /* TM segments, SEQ_TM */
+#define M_PREDICTED_ONLY  (M_PREDICTED+1)         /* ... and not annotated membrane */
+#define M_RESIDUES        (M_PREDICTED+2)         /* SQ length, SEQ_STATS */
+#define M_AA              (M_RESIDUES+1)          /* + SEQ_AA index, residues of each */
+#define M_LEN             (M_AA+SEQ_AA_COUNT)     /* + length bin */
+#define M_NTERM           (M_LEN+SEQ_LEN_BINS)    /* + N-terminal hydropathy bin */
+#define MEASURE_COUNT     (M_NTERM+SEQ_NTERM_BINS)
+#define REPORT_MEASURES   M_RESIDUES
+
+/*********************************************************************
+ *  Cross-tabulation grouping keys
+ *********************************************************************/
+#define XK_HUMAN          0
+#define XK_BRAIN          1
+#define XK_MUSCLE         2
+#define XK_EVIDENCE       3
+#define XK_COMPARTMENT    4
+#define XK_ORGANISM       5
+#define XK_TAXON          6
+#define XK_TISSUE         7
+#define XK_KEYWORD        8
+#define XK_COUNT          9
+#define XT_MAX_KEYS       4
+#define XT_ANY           (-1)
+
+/*********************************************************************
+ *  promog_rules: the compiled matchers.  regexec() on one regex_t
+ *  serializes on a lock inside glibc, so every scanning thread
+ *  compiles its own copy.
+ *********************************************************************/
+struct promog_rules {
+  regex_t rgx_array[REGEX_COUNT];
+  regex_t rgx_GO_array[GO_COUNT];
+  regex_t rgx_GO_minor_array[GO_MINOR_COUNT];
+  regex_t rgx_brain, rgx_muscle;
+  int seq;                           /* SEQ_* stages, 0 unless asked for */
+};
+
+struct crosstab;
+struct pindex;
+struct pindex_view;
+struct plist;
+struct colx;
+struct perfctr;
+struct progress;
+struct checkpoint;
+struct cellgram_book;
+struct cellgram_job;
+struct render_cache;
+struct render_opts;
+
+/*********************************************************************
+ *  Metrics phases (see metrics.c).  setup, scan, merge, output and
+ *  render are timed once on the main thread; read, split, match and
+ *  aggregate are summed per thread inside scan_range().
+ *********************************************************************/
+#define MX_SETUP       0
+#define MX_SCAN        1
+#define MX_READ        2
+#define MX_SPLIT       3
+#define MX_MATCH       4
+#define MX_AGGREGATE   5
+#define MX_MERGE       6
+#define MX_OUTPUT      7
+#define MX_RENDER      8
+#define MX_COUNT       9
+
+/*********************************************************************
+ *  Hardware counters (see perfctr.c), -1 where unavailable
+ *********************************************************************/
+#define PC_CYCLES          0
+#define PC_INSTRUCTIONS    1
+#define PC_BRANCHES        2
+#define PC_BRANCH_MISSES   3
+#define PC_CACHE_MISSES    4
+#define PC_COUNT           5
+
+struct metrics_phase {
+  unsigned long long ticks;          /* summed metrics_ticks() deltas */
+  double cpu;                        /* process CPU seconds, -1 if not measured */
+  long long bytes, records, lines;
+  unsigned long long t0;             /* metrics_begin() marks */
+  double c0;
+  long long hw[PC_COUNT], hw0[PC_COUNT];   /* --perf-counters, main thread phases */
+};
+
+struct metrics {
+  struct metrics_phase ph[MX_COUNT];
+  struct perfctr *pc;                /* NULL unless --perf-counters */
+};
+
+static inline unsigned long long metrics_ticks (void) {
+/*****************************************************************
+ *  The hot loop's clock: the TSC where there is one, else
+ *  CLOCK_MONOTONIC nanoseconds
+ *****************************************************************/
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (unsigned long long)t.tv_sec * 1000000000ULL + t.tv_nsec;
+#endif
+}
+
+/*********************************************************************
+ *  scan_state: one scanner's input range and everything it counts.
+ *  Each thread owns one; main() merges them after the join.
+ *********************************************************************/
+struct scan_state {
+  int fd;
+  long long start, end;              /* scan entries starting in [start,end) */
+  long long origin;                  /* start before any --resume */
+  int blocksize;
+  char *block;                       /* blocksize bytes */
+  char *line;                        /* MAXLINE+2 bytes of regexec scratch */
+  struct promog_rules *rules;
+  int n_cubes;
+  struct crosstab **cubes;
+  struct pindex *ix;                 /* NULL unless -i */
+  struct plist *pl;                  /* NULL unless -l */
+  struct colx *cx;                   /* NULL unless -e */
+  struct metrics *met;               /* this thread's read/split/match/aggregate */
+  long long progress_bytes;          /* published once per block for progress.c */
+  long long progress_records;
+  struct checkpoint *ckpt;           /* NULL unless --checkpoint */
+  int ckpt_slot, ckpt_countdown;
+
+  struct prot_record rec;
+  long long tot_proteins;
+  int max_line, max_prot_lines, max_prot_chars, corrupt_infile;
+  long long line_num, char_count;
+};
+
+/*********************************************************************
+ *  promog_summary: what one run found, for the structured output
+ *  formats.  report is the "human,brain,muscle:all" cube; cubes[]
+ *  are the -x cross-tabulations.
+ *********************************************************************/
+#define FORMAT_TEXT       0
+#define FORMAT_JSON       1
+#define FORMAT_TSV        2
+#define GROUP_COUNT       4          /* human, total, brain, muscle */
+
+struct promog_summary {
+  const char *datafile;
+  const char *mem_method;
+  int n_threads, blocksize;
+  long long tot_proteins, line_num, char_count;
+  int max_line, max_prot_lines, max_prot_chars, corrupt_infile;
+  struct timespec t_begin, t_end;
+  struct crosstab *report;
+  int n_cubes;
+  struct crosstab **cubes;
+  const char *index_path, *list_path, *export_path;   /* NULL if not written */
+  const struct render_opts *render;  /* NULL: cellgram()'s own files */
+  int seq;                           /* SEQ_* stages the scan ran */
+};
+
+/*********************************************************************
+ *  cache_key: identity of one datafile and of the rules and cubes
+ *  it was scanned with (see cache.c)
+ *********************************************************************/
+struct cache_key {
+  unsigned long long dev, ino, size;
+  long long mtime_sec, mtime_nsec;
+  unsigned long long rules, specs, fingerprint;
+};
+
+/*********************************************************************
+ *  terms.c
+ *********************************************************************/
+extern const char *REGEX_RAW_ARRAY[REGEX_COUNT];
+extern const char *NAMES_ARRAY[REGEX_COUNT];
+extern const char *GO_RAW_REGEX_ARRAY[GO_COUNT];
+extern const char *GO_NAMES_ARRAY[GO_COUNT];
+extern const char *GO_RAW_REGEX_MINOR_ARRAY[GO_MINOR_COUNT];
+extern const char *GO_NAMES_MINOR_ARRAY[GO_MINOR_COUNT];
+extern const char *FT_NAMES_ARRAY[FT_COUNT];
+extern const char *COMP_NAMES_ARRAY[COMP_COUNT];
+
+void reset_record (struct prot_record *rec);
+int compartment_mask (const struct prot_record *rec);
+int record_has_ft (const struct prot_record *rec, int ft_index);
+void add_tissues (struct prot_record *rec, const char *line, int len);
+void add_keywords (struct prot_record *rec, const char *line, int len);
+void record_measures (const struct prot_record *rec, int *m);
+void measure_name (int measure, char *name, int size);
+
+/*********************************************************************
+ *  arena.c -- bump allocation for per-record and per-batch state
+ *********************************************************************/
+void arena_init (struct arena *a, size_t block_size);
+void *arena_alloc (struct arena *a, size_t n);
+char *arena_strndup (struct arena *a, const char *s, size_t n);
+void arena_reset (struct arena *a);
+void arena_free (struct arena *a);
+size_t arena_peak (const struct arena *a);
+void arena_stats (long long *now, long long *peak);
+
+/*********************************************************************
+ *  classify.c -- the compiled rules and the per-line classifier
+ *********************************************************************/
+int compile_rules (struct promog_rules *rules);
+void free_rules (struct promog_rules *rules);
+unsigned long long rules_hash (void);
+void classify_line (struct prot_record *rec, const struct promog_rules *rules,
+                    const char *p, int len, char *line, struct metrics *met);
+void classify_end (struct prot_record *rec);
+
+/*********************************************************************
+ *  seq.c -- sequence analysis of the SQ block
+ *********************************************************************/
+void seq_begin (struct prot_record *rec, const char *p, int b, int stages);
+void seq_line (struct prot_record *rec, const char *p, int b);
+int seq_tm_segments (const char *seq, int n, short *scratch);
+void seq_count_residues (const char *seq, int n, int *counts);
+int seq_nterm_kd (const char *seq, int n);
+int seq_len_bin (int n);
+int seq_nterm_bin (int kd);
+void seq_end (struct prot_record *rec);
+
+extern const char *SEQ_AA_NAMES_ARRAY[SEQ_AA_COUNT];
+extern const char *SEQ_LEN_NAMES_ARRAY[SEQ_LEN_BINS];
+extern const char *SEQ_NTERM_NAMES_ARRAY[SEQ_NTERM_BINS];
+
+/*********************************************************************
+ *  scan.c
+ *********************************************************************/
+long long snap_to_record (int fd, long long offset);
+void scan_range (struct scan_state *st);
+
+/*********************************************************************
+ *  crosstab.c -- N-dimensional count cubes
+ *********************************************************************/
+struct crosstab *crosstab_new (const char *spec);
+void crosstab_add (struct crosstab *xt, const struct prot_record *rec,
+                   const int *m);
+void crosstab_merge (struct crosstab *dst, const struct crosstab *src);
+long long crosstab_sum (const struct crosstab *xt, const int *match, int measure);
+const char *crosstab_spec (const struct crosstab *xt);
+void crosstab_print (const struct crosstab *xt, FILE *fp);
+void crosstab_print_json (const struct crosstab *xt, FILE *fp);
+int crosstab_write (const struct crosstab *xt, FILE *fp);
+struct crosstab *crosstab_read (FILE *fp);
+void crosstab_free (struct crosstab *xt);
+
+/*********************************************************************
+ *  prot_index.c -- per-term record bitmaps and set-algebra queries
+ *********************************************************************/
+struct pindex *pindex_new (void);
+void pindex_add (struct pindex *ix, const struct prot_record *rec);
+void pindex_merge (struct pindex *dst, struct pindex *src, long long base);
+int pindex_write (struct pindex *ix, const char *path);
+void pindex_free (struct pindex *ix);
+int pindex_query (const char *path, const char *expr, FILE *out);
+struct pindex_view *pindex_open (const char *path);
+long long pindex_view_records (const struct pindex_view *v);
+int pindex_view_query (const struct pindex_view *v, const char *expr, FILE *out);
+int pindex_view_demog (const struct pindex_view *v, const char *expr, FILE *out);
+int pindex_view_lookup (const struct pindex_view *v, const char *acc, FILE *out);
+void pindex_close (struct pindex_view *v);
+
+/*********************************************************************
+ *  plist.c -- per-protein listing
+ *********************************************************************/
+struct plist *plist_new (int fd);
+void plist_add (struct plist *pl, const struct prot_record *rec);
+int plist_append (struct plist *dst, struct plist *src);
+int plist_close (struct plist *pl);
+
+/*********************************************************************
+ *  colexport.c -- columnar export of the per-protein classifications
+ *********************************************************************/
+struct colx *colx_new (const char *path);
+void colx_add (struct colx *cx, const struct prot_record *rec);
+int colx_append (struct colx *dst, struct colx *src);
+int colx_close (struct colx *cx);
+
+/*********************************************************************
+ *  summary.c -- --format=json|tsv
+ *********************************************************************/
+int summary_format (const char *name);
+int summary_write (const struct promog_summary *sum, int format, int fd);
+void summary_cellgrams (const struct promog_summary *sum);
+int summary_jobs (const struct promog_summary *sum, struct cellgram_job *jobs);
+int summary_values (const struct promog_summary *sum, long long *v);
+void summary_value_name (int i, const char **group, char *measure, int size);
+void json_string (FILE *fp, const char *s);
+
+/*********************************************************************
+ *  cache.c -- result cache keyed on input identity
+ *********************************************************************/
+void cache_key_init (struct cache_key *key, int fd, const struct stat *sb, int seq,
+                     const char **specs, int n_specs, int use_fingerprint);
+int cache_load (const char *dir, const struct cache_key *key,
+                struct promog_summary *sum, struct crosstab ***cubes);
+int cache_store (const char *dir, const struct cache_key *key,
+                 const struct promog_summary *sum);
+
+/*********************************************************************
+ *  perfctr.c -- perf_event_open counters for --perf-counters
+ *********************************************************************/
+struct perfctr *perfctr_open (void);
+void perfctr_read (const struct perfctr *pc, long long *v);
+const char *perfctr_name (int counter);
+void perfctr_close (struct perfctr *pc);
+
+/*********************************************************************
+ *  progress.c -- --progress and --status-file
+ *********************************************************************/
+struct progress *progress_start (struct scan_state *st, int n_threads,
+                                 long long total_bytes, int interval,
+                                 const char *status_path);
+void progress_stop (struct progress *pg);
+
+/*********************************************************************
+ *  checkpoint.c -- --checkpoint and --resume
+ *********************************************************************/
+struct checkpoint *checkpoint_new (const char *path, const struct cache_key *key,
+                                   int n_threads, int n_cubes, int interval);
+int checkpoint_load (struct checkpoint *ck, struct scan_state *st);
+void checkpoint_due (struct scan_state *st, long long offset);
+void checkpoint_done (struct scan_state *st);
+void checkpoint_free (struct checkpoint *ck, int remove_file);
+
+/*********************************************************************
+ *  batch.c -- many datafiles on one pool of threads
+ *********************************************************************/
+struct batch_opts {
+  int n_threads, io_limit, blocksize, format;
+  int n_specs;
+  const char **specs;                /* the report's first */
+  const char *cache_dir;             /* NULL unless --cache */
+  int use_fingerprint;
+  int progress_interval;
+  const char *status_path;
+  const char *mem_method;
+  const struct render_opts *render;
+  struct metrics *met;
+  int seq;                           /* SEQ_* stages */
+};
+
+int batch_manifest (const char *path, const char ***paths, int *n);
+int batch_run (const char **paths, int n_paths, const struct batch_opts *o);
+
+/*********************************************************************
+ *  sample.c -- --sample estimates from random windows
+ *********************************************************************/
+struct sample_opts {
+  double fraction;                   /* of the windows, at most */
+  double max_error;                  /* stop at this relative error, 0 never */
+  long long window;                  /* bytes */
+  unsigned long long seed;
+  int n_threads, blocksize, format;
+  const char *spec;                  /* of the report cube */
+  const struct render_opts *render;
+  struct metrics *met;
+  int seq;                           /* SEQ_* stages */
+};
+
+int sample_run (const char *path, long long size, const struct sample_opts *o);
+
+/*********************************************************************
+ *  partial.c -- --range shards for promog-merge
+ *********************************************************************/
+int partial_write (const char *path, const struct cache_key *key, long long start,
+                   long long end, const struct promog_summary *sum);
+int partial_read (const char *path, struct cache_key *key, long long *start,
+                  long long *end, struct promog_summary *sum, struct crosstab ***cubes);
+
+/*********************************************************************
+ *  metrics.c -- per-phase timing and counters
+ *********************************************************************/
+void metrics_init (struct metrics *m);
+void metrics_begin (struct metrics *m, int phase);
+void metrics_end (struct metrics *m, int phase);
+void metrics_merge (struct metrics *dst, const struct metrics *src);
+double metrics_seconds (unsigned long long ticks);
+void metrics_interval (FILE *fp, long long nsec);
+void metrics_print (const struct metrics *m, FILE *fp);
+void metrics_print_json (const struct metrics *m, FILE *fp);
+
+/*********************************************************************
+ *  libpromog.c -- the parser for other programs: entry views over
+ *  the caller's bytes, pulled from a buffer or pushed in chunks
+ *********************************************************************/
+#define PROMOG_CLASSIFY   1          /* promog_parser_new(): fill e->rec */
+#define PROMOG_PREDICT_TM 2          /* ... and e->rec->tm_segments (seq.c) */
+#define PROMOG_SEQ_STATS  4          /* ... and e->rec->seq_counts, nterm_kd */
+
+struct promog_parser;
+
+struct promog_span {
+  const char *p;                     /* into the entry; not '\0' terminated */
+  int len;
+};
+
+struct promog_entry {
+  const char *p;                     /* the ID line */
+  long long len;                     /* through the newline of the // line */
+  long long ordinal;                 /* 0-based, in this parser */
+  const struct prot_record *rec;     /* NULL without PROMOG_CLASSIFY */
+};
+
+struct promog_feature {
+  struct promog_span key;            /* TRANSMEM */
+  struct promog_span location;       /* 40..60 */
+};
+
+typedef int (*promog_entry_fn) (const struct promog_entry *e, void *arg);
+
+struct promog_parser *promog_parser_new (int flags);
+void promog_parser_free (struct promog_parser *ps);
+void promog_carry_buffer (struct promog_parser *ps, char *buf, long long cap);
+int promog_next (struct promog_parser *ps, const char *buf, long long len, long long *pos,
+                 struct promog_entry *e);
+int promog_push (struct promog_parser *ps, const char *data, long long len,
+                 promog_entry_fn fn, void *arg);
+int promog_push_end (struct promog_parser *ps);
+int promog_lines (const struct promog_entry *e, const char *code, struct promog_span *out,
+                  int max);
+struct promog_span promog_ac (const struct promog_entry *e);
+struct promog_span promog_os (const struct promog_entry *e);
+int promog_ox (const struct promog_entry *e);
+int promog_ft (const struct promog_entry *e, struct promog_feature *out, int max);
+int promog_cc (const struct promog_entry *e, const char *topic, struct promog_span *out,
+               int max);
+int promog_dr (const struct promog_entry *e, const char *db, struct promog_span *out, int max);
+int promog_sq (const struct promog_entry *e, int *length, struct promog_span *out, int max);
+
+/*********************************************************************
+ *  cellgram.c -- the diagram.  cellgram() draws one to a file of its
+ *  own naming; cellgram_draw() draws the same picture on a width x
+ *  height area of a Cairo context the caller owns.
+ *********************************************************************/
+#define CELLGRAM_WIDTH    600
+#define CELLGRAM_HEIGHT   600
+
+struct _cairo;
+
+int cellgram (char *title, char *infile, double nuclear, double cytosolic,
+              double membrane, double extracellular);
+int cellgram_draw (struct _cairo *cr, int width, int height, char *title, char *infile,
+                   double nuclear, double cytosolic, double membrane, double extracellular);
+
+/*********************************************************************
+ *  render.c -- many cellgrams on a pool of threads
+ *********************************************************************/
+struct cellgram_job {
+  char *title, *infile;
+  double nuclear, cytosolic, membrane, extracellular;
+  const char *out;                   /* PNG path; NULL: cellgram()'s own file */
+  int status;                        /* 0 once written */
+};
+
+/*********************************************************************
+ *  cellgram_buf: an encoded cellgram in memory (cellgram_encode())
+ *********************************************************************/
+#define CELLGRAM_PNG      0
+#define CELLGRAM_SVG      1
+
+struct cellgram_buf {
+  unsigned char *data;
+  size_t len, cap;
+  int fixed;                         /* data is the caller's cap bytes: never grown */
+};
+
+/*********************************************************************
+ *  render_opts: where a run's cellgrams go (see cellgram_render())
+ *********************************************************************/
+struct render_opts {
+  struct cellgram_book *book;        /* --cellgrams: all in one file */
+  const char *dir;                   /* --cellgram-dir: a PNG each */
+  struct render_cache *rc;           /* --render-cache, for dir */
+  int n_threads;
+};
+
+int cellgram_batch (struct cellgram_job *jobs, int n_jobs, int n_threads,
+                    struct render_cache *rc);
+int cellgram_render (struct cellgram_job *jobs, int n_jobs, const struct render_opts *r);
+int cellgram_encode (const struct cellgram_job *job, int format, struct cellgram_buf *buf);
+void cellgram_buf_free (struct cellgram_buf *buf);
+struct cellgram_book *cellgram_book_open (const char *path);
+int cellgram_book_add (struct cellgram_book *bk, const struct cellgram_job *job);
+int cellgram_book_close (struct cellgram_book *bk);
+
+/*********************************************************************
+ *  rcache.c -- rendered cellgrams keyed on what they show
+ *********************************************************************/
+struct render_cache *rcache_open (const char *dir, long long max_bytes);
+int rcache_get (struct render_cache *rc, const struct cellgram_job *job, const char *out);
+void rcache_put (struct render_cache *rc, const struct cellgram_job *job, const char *png);
+void rcache_close (struct render_cache *rc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
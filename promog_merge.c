@@ -0,0 +1,201 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <getopt.h>
+#include <time.h>
+#include "promog.h"
+
+#define STDOUT 1
+
+/*********************************************************************
+ *
+ *  PROMOG-MERGE -- add --range partials back into one report
+ *
+ *     promog --range=0/3 --partial=p0 uniprot_sprot.dat    (node 0)
+ *     promog --range=1/3 --partial=p1 uniprot_sprot.dat    (node 1)
+ *     promog --range=2/3 --partial=p2 uniprot_sprot.dat    (node 2)
+ *     promog-merge p0 p1 p2
+ *
+ *  prints the report and draws the cellgrams of the whole file.  The
+ *  partials may come in any order; they must all be of one datafile
+ *  (size, rules, cubes and, if any, fingerprint) and together cover
+ *  it exactly once.  -f reports a file with gaps anyway; overlapping
+ *  shards would count entries twice and are always refused.
+ *
+ *********************************************************************/
+
+struct shard {
+  const char *path;
+  struct cache_key key;
+  long long start, end;
+  struct promog_summary sum;
+  struct crosstab **xt;
+};
+
+static int by_start (const void *a, const void *b) {
+  const struct shard *x = a, *y = b;
+
+  return (x->start > y->start) - (x->start < y->start);
+}
+
+static int same_file (const struct cache_key *a, const struct cache_key *b) {
+/*****************************************************************
+ *  Not the mtime: copies on other nodes need not keep it
+ *****************************************************************/
+  return (a->size == b->size) && (a->rules == b->rules) &&
+         (a->specs == b->specs) && (a->fingerprint == b->fingerprint);
+}
+
+int main (int argc, char *argv[]) {
+
+  const int GOOD_EXIT  = 0;
+  const int  FALSE   = 0;
+  const int  TRUE =  1;
+  const int  BAD_ARGC  = -1;
+  const int BAD_PARTIAL  = -2 ;
+  const int BAD_COVER  = -3 ;
+
+  int i, j, n, opt, bad = FALSE, force = FALSE;
+  int format = FORMAT_TEXT;
+  long long next, elapsed, longest = 0;
+  char err_msg[1024];
+  struct shard *p;
+  struct promog_summary sum;
+  static struct option long_options[] = {
+    {"format", required_argument, NULL, 'F'},
+    {NULL, 0, NULL, 0}};
+
+  while ((opt = getopt_long(argc,argv,"f",long_options,NULL)) != EOF) {
+    switch (opt) {
+      case 'f':
+        force = TRUE;
+        break;
+      case 'F':
+        if ((format = summary_format(optarg)) < 0) {
+          sprintf(err_msg,"--format must be text, json or tsv, not %s",optarg);
+          perror(err_msg);
+          return BAD_ARGC;
+        }
+        break;
+      default:
+        bad = TRUE;
+    }
+  }
+  if ((bad) || (optind >= argc)) {
+    sprintf(err_msg,"USAGE: promog-merge [-f] [--format=text|json|tsv]"
+        " <partial> ... O:=} Not");
+    perror(err_msg);
+    return BAD_ARGC;
+  }
+
+  n = argc - optind;
+  p = calloc(n, sizeof(struct shard));
+  for (i=0;i<n;i++) {
+    p[i].path = argv[optind + i];
+    if (partial_read(p[i].path, &p[i].key, &p[i].start, &p[i].end,
+                     &p[i].sum, &p[i].xt) < 0)
+      return BAD_PARTIAL;
+    if ((!same_file(&p[i].key, &p[0].key)) ||
+        (p[i].sum.n_cubes != p[0].sum.n_cubes) || (p[i].sum.seq != p[0].sum.seq)) {
+      fprintf(stderr, "%s IS NOT OF THE SAME DATAFILE, RULES, CUBES AND STAGES AS %s\n",
+              p[i].path, p[0].path);
+      return BAD_PARTIAL;
+    }
+  }
+
+  /*****************************************************************
+   *  Shards in file order must meet end to start from 0 to EOF
+   *****************************************************************/
+  qsort(p, n, sizeof(struct shard), by_start);
+  next = 0;
+  for (i=0;i<=n;i++) {
+    long long at = (i < n) ? p[i].start : LLONG_MAX;
+
+    if (at < next) {
+      fprintf(stderr, "%s OVERLAPS THE SHARD BEFORE IT AT BYTE %lld\n",
+              p[i].path, at);
+      return BAD_COVER;
+    }
+    if ((at > next) && (next < (long long)p[0].key.size)) {
+      fprintf(stderr, "NO PARTIAL COVERS BYTES %lld TO %lld%s\n", next,
+              (at < (long long)p[0].key.size) ? at : (long long)p[0].key.size,
+              force ? "" : " (-f to report anyway)");
+      bad = TRUE;
+    }
+    if (i < n)
+      next = p[i].end;
+  }
+  if ((bad) && (!force))
+    return BAD_COVER;
+
+  /*****************************************************************
+   *  Add the rest into the first.  Wall time is the slowest shard's:
+   *  they are meant to run side by side.
+   *****************************************************************/
+  sum = p[0].sum;
+  sum.mem_method = "merged";
+  sum.n_threads = 0;
+  for (i=0;i<n;i++) {
+    if (i > 0) {
+      for (j=0;j<=sum.n_cubes;j++)
+        crosstab_merge(p[0].xt[j], p[i].xt[j]);
+      sum.tot_proteins += p[i].sum.tot_proteins;
+      sum.line_num += p[i].sum.line_num;
+      sum.char_count += p[i].sum.char_count;
+      if (p[i].sum.max_line > sum.max_line)
+        sum.max_line = p[i].sum.max_line;
+      if (p[i].sum.max_prot_lines > sum.max_prot_lines)
+        sum.max_prot_lines = p[i].sum.max_prot_lines;
+      if (p[i].sum.max_prot_chars > sum.max_prot_chars)
+        sum.max_prot_chars = p[i].sum.max_prot_chars;
+      sum.corrupt_infile |= p[i].sum.corrupt_infile;
+    }
+    sum.n_threads += p[i].sum.n_threads;
+    elapsed = p[i].sum.t_end.tv_sec * 1000000000LL + p[i].sum.t_end.tv_nsec;
+    if (elapsed > longest)
+      longest = elapsed;
+  }
+  sum.t_begin.tv_sec = 0;
+  sum.t_begin.tv_nsec = 0;
+  sum.t_end.tv_sec = longest / 1000000000LL;
+  sum.t_end.tv_nsec = longest % 1000000000LL;
+
+  summary_write(&sum, format, STDOUT);
+  summary_cellgrams(&sum);
+
+  for (i=0;i<n;i++) {
+    for (j=0;j<=p[i].sum.n_cubes;j++)
+      crosstab_free(p[i].xt[j]);
+    free(p[i].xt);
+    free((char *)p[i].sum.datafile);
+  }
+  free(p);
+  return bad ? BAD_COVER : GOOD_EXIT;
+}// int main (int argc, char *argv[]) -----//
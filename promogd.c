@@ -0,0 +1,775 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  PROMOGD -- promog answers over a Unix socket
+ *
+ *     promog --partial=sprot.tables -i sprot.pix uniprot_sprot.dat
+ *     promogd -s /tmp/promog.sock -p sprot.tables -i sprot.pix
+ *
+ *  keeps the result tables of a --partial file (the whole datafile
+ *  when it was written without --range) and the bitmaps of a -i
+ *  index in memory and answers, one request per line:
+ *
+ *    COUNTS [json|tsv]        the report, as promog --format prints it
+ *    COUNT <group> <measure>  one number, e.g. COUNT human membrane_net
+ *    QUERY <expr>             matching accessions (promog -q syntax)
+ *    DEMOG <expr>             how those records fall in the compartments
+ *    LOOKUP <accession>       a record's ordinal and every term it has
+ *    CELLGRAM <group> [png|svg]   the diagram, encoded
+ *    CLASSIFY <bytes>         then that many bytes of flat file entries:
+ *                             the per-protein listing (promog -l) of them
+ *    STATUS | PING | RELOAD
+ *
+ *  Answers are "OK <bytes>\n" and that many bytes, or "ERR <why>\n".
+ *  An accession may stand in a QUERY or DEMOG expression for its one
+ *  record, so "DEMOG P12345 OR Q8N158 OR O43602" describes a list.
+ *
+ *  One thread waits in epoll for connections, readable clients and
+ *  signals; a pool of -j workers reads, answers and re-arms the
+ *  clients (EPOLLONESHOT, so one client is on one worker at a time).
+ *  Every worker compiles the rules once, for CLASSIFY.
+ *
+ *  The tables and index are a generation.  RELOAD or SIGHUP builds a
+ *  new one from the same paths while the old one keeps answering,
+ *  then swaps it in under a lock held for a pointer store; requests
+ *  already running finish on the old generation, which is freed by
+ *  the last of them.  Replace the files by rename() before a reload
+ *  so a half written one is never read.
+ *
+ *********************************************************************/
+
+#define MAX_WORKERS      64
+#define MAX_LINE         (1<<16)          /* one request line */
+#define MAX_CLASSIFY     (64<<20)         /* bytes of entries in one CLASSIFY */
+#define BLOCKSIZE        (1<<14)
+
+struct generation {
+  int refs;
+  long long serial;
+  time_t loaded;
+  struct cache_key key;
+  struct promog_summary sum;         /* sum.datafile NULL: no tables */
+  struct crosstab **cubes;
+  long long start, end;
+  long long *values;                 /* summary_values() */
+  int n_values;
+  char *counts[3];                   /* by FORMAT_*; text is not kept */
+  size_t counts_len[3];
+  struct pindex_view *ix;
+  pthread_mutex_t art_lock;
+  struct cellgram_buf art[GROUP_COUNT][2];   /* by CELLGRAM_PNG/SVG, made on demand */
+};
+
+struct conn {
+  int fd;
+  char *buf;
+  size_t len, cap;
+  struct conn *next;                 /* in the work queue */
+};
+
+struct worker {
+  pthread_t tid;
+  struct promog_rules rules;
+  int have_rules;
+  char *block, *line;
+  int entries_fd, listing_fd;        /* CLASSIFY scratch files */
+};
+
+static const char *TABLES_PATH = NULL, *INDEX_PATH = NULL;
+static struct generation *CURRENT = NULL;
+static pthread_mutex_t CURRENT_LOCK = PTHREAD_MUTEX_INITIALIZER;
+static long long SERIAL = 0, SERVED = 0;
+static pthread_mutex_t RELOAD_LOCK = PTHREAD_MUTEX_INITIALIZER;
+
+static struct conn *QUEUE_HEAD = NULL, *QUEUE_TAIL = NULL;
+static struct conn RELOAD_ITEM = {-1, NULL, 0, 0, NULL}, SIGNAL_ITEM = {-1, NULL, 0, 0, NULL};
+static int RELOAD_QUEUED = 0;
+static pthread_mutex_t QUEUE_LOCK = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t QUEUE_COND = PTHREAD_COND_INITIALIZER;
+static int STOPPING = 0;
+static int EPOLL_FD = -1;
+
+
+/*********************************************************************
+ *
+ *  Generations
+ *
+ *********************************************************************/
+static void gen_release (struct generation *g) {
+  int i, f;
+
+  if ((g == NULL) || (__atomic_sub_fetch(&g->refs, 1, __ATOMIC_ACQ_REL) > 0))
+    return;
+  if (g->cubes != NULL) {
+    for (i=0;i<=g->sum.n_cubes;i++)
+      crosstab_free(g->cubes[i]);
+    free(g->cubes);
+  }
+  free((char *)g->sum.datafile);
+  free(g->values);
+  for (i=0;i<3;i++)
+    free(g->counts[i]);
+  pindex_close(g->ix);
+  for (i=0;i<GROUP_COUNT;i++)
+    for (f=0;f<2;f++)
+      cellgram_buf_free(&g->art[i][f]);
+  pthread_mutex_destroy(&g->art_lock);
+  free(g);
+} //----- gen_release -----//
+
+
+static struct generation * gen_acquire (void) {
+  struct generation *g;
+
+  pthread_mutex_lock(&CURRENT_LOCK);
+  g = CURRENT;
+  __atomic_add_fetch(&g->refs, 1, __ATOMIC_ACQ_REL);
+  pthread_mutex_unlock(&CURRENT_LOCK);
+  return g;
+}
+
+
+static int gen_format (struct generation *g, int format) {
+/*****************************************************************
+ *  summary_write() the tables once, into memory, for COUNTS
+ *****************************************************************/
+  FILE *tmp;
+  long len;
+
+  if (((tmp = tmpfile()) == NULL) || (summary_write(&g->sum, format, fileno(tmp)) < 0) ||
+      ((len = lseek(fileno(tmp), 0, SEEK_END)) < 0)) {
+    if (tmp != NULL)
+      fclose(tmp);
+    return -1;
+  }
+  g->counts[format] = malloc(len + 1);
+  g->counts_len[format] = pread(fileno(tmp), g->counts[format], len, 0);
+  fclose(tmp);
+  return (g->counts_len[format] == (size_t)len) ? 0 : -1;
+}
+
+
+static struct generation * gen_load (void) {
+/*****************************************************************
+ *  A new generation from TABLES_PATH and INDEX_PATH, or NULL
+ *****************************************************************/
+  struct generation *g = calloc(1, sizeof(struct generation));
+
+  g->refs = 1;
+  g->loaded = time(NULL);
+  pthread_mutex_init(&g->art_lock, NULL);
+  if (TABLES_PATH != NULL) {
+    if (partial_read(TABLES_PATH, &g->key, &g->start, &g->end, &g->sum, &g->cubes) < 0) {
+      gen_release(g);
+      return NULL;
+    }
+    g->sum.mem_method = "promogd";
+    if (g->key.rules != rules_hash())
+      fprintf(stderr, "promogd: %s was built with other rules than these\n", TABLES_PATH);
+    if ((g->start > 0) || (g->end < (long long)g->key.size))
+      fprintf(stderr, "promogd: %s covers bytes %lld to %lld of %lld only\n",
+              TABLES_PATH, g->start, (g->end < (long long)g->key.size) ? g->end :
+              (long long)g->key.size, (long long)g->key.size);
+    g->values = malloc(GROUP_COUNT*(REPORT_MEASURES+1)*sizeof(long long));
+    g->n_values = summary_values(&g->sum, g->values);
+    if ((gen_format(g, FORMAT_JSON) < 0) || (gen_format(g, FORMAT_TSV) < 0)) {
+      fprintf(stderr, "promogd: CAN'T FORMAT THE TABLES OF %s\n", TABLES_PATH);
+      gen_release(g);
+      return NULL;
+    }
+  }
+  if ((INDEX_PATH != NULL) && ((g->ix = pindex_open(INDEX_PATH)) == NULL)) {
+    gen_release(g);
+    return NULL;
+  }
+  g->serial = ++SERIAL;
+  return g;
+} //----- gen_load -----//
+
+
+static int gen_reload (void) {
+/*****************************************************************
+ *  Load, then swap.  One reload at a time; the old generation
+ *  answers until the swap.
+ *****************************************************************/
+  struct generation *g, *old;
+
+  pthread_mutex_lock(&RELOAD_LOCK);
+  if ((g = gen_load()) == NULL) {
+    pthread_mutex_unlock(&RELOAD_LOCK);
+    fprintf(stderr, "promogd: reload failed, still serving the last generation\n");
+    return -1;
+  }
+  pthread_mutex_lock(&CURRENT_LOCK);
+  old = CURRENT;
+  CURRENT = g;
+  pthread_mutex_unlock(&CURRENT_LOCK);
+  pthread_mutex_unlock(&RELOAD_LOCK);
+  gen_release(old);
+  fprintf(stderr, "promogd: serving generation %lld\n", g->serial);
+  return 0;
+}
+
+
+/*********************************************************************
+ *
+ *  Requests
+ *
+ *********************************************************************/
+static int send_all (int fd, const void *data, size_t len) {
+/*****************************************************************
+ *  The client socket is non-blocking: wait out a full buffer
+ *****************************************************************/
+  const char *p = data;
+  struct pollfd pfd;
+  ssize_t w;
+
+  while (len > 0) {
+    if ((w = send(fd, p, len, MSG_NOSIGNAL)) < 0) {
+      if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        return -1;
+      pfd.fd = fd;
+      pfd.events = POLLOUT;
+      poll(&pfd, 1, 1000);
+      continue;
+    }
+    p += w;
+    len -= w;
+  }
+  return 0;
+}
+
+static int reply (int fd, int ok, const char *data, size_t len) {
+  char head[64];
+  const char *nl;
+
+  if (!ok) {
+    /*  the first line of the complaint  */
+    nl = memchr(data, '\n', len);
+    snprintf(head, sizeof(head), "ERR ");
+    return (send_all(fd, head, 4) || send_all(fd, data, nl ? (size_t)(nl - data) : len) ||
+            send_all(fd, "\n", 1)) ? -1 : 0;
+  }
+  snprintf(head, sizeof(head), "OK %zu\n", len);
+  return (send_all(fd, head, strlen(head)) || send_all(fd, data, len)) ? -1 : 0;
+}
+
+
+static int answer_count (struct generation *g, const char *args, FILE *out) {
+  char group[64], measure[64], name[64];
+  const char *gname;
+  int i;
+
+  if (sscanf(args, "%63s %63s", group, measure) != 2) {
+    fprintf(out, "COUNT needs a group and a measure\n");
+    return -1;
+  }
+  for (i=0;i<g->n_values;i++) {
+    summary_value_name(i, &gname, name, sizeof(name));
+    if ((!strcasecmp(gname, group)) && (!strcasecmp(name, measure))) {
+      fprintf(out, "%lld\n", g->values[i]);
+      return 0;
+    }
+  }
+  fprintf(out, "no count %s %s\n", group, measure);
+  return -1;
+}
+
+
+static int answer_cellgram (struct generation *g, const char *args, int fd) {
+/*****************************************************************
+ *  Encoded once per generation, group and format, then sent from
+ *  memory
+ *****************************************************************/
+  struct cellgram_job jobs[GROUP_COUNT];
+  struct cellgram_buf *art;
+  char group[64], kind[8] = "png", why[128];
+  const char *gname;
+  char name[64];
+  int i, format, status = 0;
+
+  if (sscanf(args, "%63s %7s", group, kind) < 1) {
+    snprintf(why, sizeof(why), "CELLGRAM needs a group");
+    return reply(fd, 0, why, strlen(why));
+  }
+  format = strcasecmp(kind, "svg") ? CELLGRAM_PNG : CELLGRAM_SVG;
+  for (i=0;i<GROUP_COUNT;i++) {
+    summary_value_name(i*(REPORT_MEASURES+1), &gname, name, sizeof(name));
+    if (!strcasecmp(gname, group))
+      break;
+  }
+  if (i == GROUP_COUNT) {
+    snprintf(why, sizeof(why), "no group %s", group);
+    return reply(fd, 0, why, strlen(why));
+  }
+  art = &g->art[i][format];
+  pthread_mutex_lock(&g->art_lock);
+  if (art->len == 0) {
+    summary_jobs(&g->sum, jobs);
+    status = cellgram_encode(&jobs[i], format, art);
+  }
+  pthread_mutex_unlock(&g->art_lock);
+  if (status < 0) {
+    snprintf(why, sizeof(why), "CAN'T ENCODE CELLGRAM %s", group);
+    return reply(fd, 0, why, strlen(why));
+  }
+  return reply(fd, 1, (const char *)art->data, art->len);
+} //----- answer_cellgram -----//
+
+
+static int answer_classify (struct worker *w, const char *entries, size_t len, FILE *out) {
+/*****************************************************************
+ *
+ *  Scan the entries with this worker's compiled rules and write
+ *  their per-protein listing.  The entries go through a scratch
+ *  file so that scan_range() reads them as it reads a datafile.
+ *
+ *****************************************************************/
+  struct scan_state st;
+  char buf[1<<16];
+  ssize_t n;
+  off_t at = 0;
+
+  if (!w->have_rules) {
+    fprintf(out, "no compiled rules\n");
+    return -1;
+  }
+  if ((ftruncate(w->entries_fd, 0)) || (pwrite(w->entries_fd, entries, len, 0) != (ssize_t)len) ||
+      (ftruncate(w->listing_fd, 0)) || (lseek(w->listing_fd, 0, SEEK_SET) < 0)) {
+    fprintf(out, "CAN'T WRITE SCRATCH FILE\n");
+    return -1;
+  }
+  memset(&st, 0, sizeof(st));
+  st.fd = w->entries_fd;
+  st.start = st.origin = 0;
+  st.end = LLONG_MAX;
+  st.blocksize = BLOCKSIZE;
+  st.block = w->block;
+  st.line = w->line;
+  st.rules = &w->rules;
+  if ((st.pl = plist_new(w->listing_fd)) == NULL) {
+    fprintf(out, "CAN'T START LISTING\n");
+    return -1;
+  }
+  scan_range(&st);
+  if (plist_close(st.pl) < 0) {
+    fprintf(out, "CAN'T WRITE LISTING\n");
+    return -1;
+  }
+  while ((n = pread(w->listing_fd, buf, sizeof(buf), at)) > 0) {
+    fwrite(buf, 1, n, out);
+    at += n;
+  }
+  return 0;
+} //----- answer_classify -----//
+
+
+static int answer (struct worker *w, int fd, char *line, const char *payload, size_t payload_len) {
+/*****************************************************************
+ *  One request.  -1 if the client should be dropped.
+ *****************************************************************/
+  struct generation *g;
+  char *args, *text = NULL;
+  size_t text_len = 0;
+  FILE *out;
+  int ok = 0, format, status;
+
+  for (args=line;(*args)&&(*args!=' ');args++)
+    ;
+  if (*args)
+    *args++ = '\0';
+  g = gen_acquire();
+  __atomic_add_fetch(&SERVED, 1, __ATOMIC_RELAXED);
+
+  if (!strcasecmp(line, "CELLGRAM")) {
+    status = (g->sum.datafile == NULL) ? reply(fd, 0, "no tables loaded", 16) :
+             answer_cellgram(g, args, fd);
+    gen_release(g);
+    return status;
+  }
+  if ((!strcasecmp(line, "COUNTS")) && (g->sum.datafile != NULL)) {
+    format = strcasecmp(args, "json") ? FORMAT_TSV : FORMAT_JSON;
+    status = reply(fd, 1, g->counts[format], g->counts_len[format]);
+    gen_release(g);
+    return status;
+  }
+
+  out = open_memstream(&text, &text_len);
+  if (!strcasecmp(line, "PING"))
+    ok = 1;
+  else if (!strcasecmp(line, "STATUS")) {
+    fprintf(out, "generation %lld loaded %ld\nrequests %lld\n", g->serial,
+            (long)g->loaded, __atomic_load_n(&SERVED, __ATOMIC_RELAXED));
+    if (g->sum.datafile != NULL)
+      fprintf(out, "tables %s datafile %s proteins %lld bytes %lld-%lld\n", TABLES_PATH,
+              g->sum.datafile, g->sum.tot_proteins, g->start,
+              (g->end < (long long)g->key.size) ? g->end : (long long)g->key.size);
+    if (g->ix != NULL)
+      fprintf(out, "index %s records %lld\n", INDEX_PATH, pindex_view_records(g->ix));
+    ok = 1;
+  }
+  else if (!strcasecmp(line, "RELOAD")) {
+    gen_release(g);
+    if (!(ok = (gen_reload() == 0)))
+      fprintf(out, "reload failed, still serving the last generation\n");
+    g = gen_acquire();
+    if (ok)
+      fprintf(out, "generation %lld\n", g->serial);
+  }
+  else if ((!strcasecmp(line, "COUNT")) && (g->sum.datafile != NULL))
+    ok = (answer_count(g, args, out) == 0);
+  else if ((!strcasecmp(line, "QUERY")) && (g->ix != NULL))
+    ok = (pindex_view_query(g->ix, args, out) == 0);
+  else if ((!strcasecmp(line, "DEMOG")) && (g->ix != NULL))
+    ok = (pindex_view_demog(g->ix, args, out) == 0);
+  else if ((!strcasecmp(line, "LOOKUP")) && (g->ix != NULL))
+    ok = (pindex_view_lookup(g->ix, args, out) == 0);
+  else if (!strcasecmp(line, "CLASSIFY"))
+    ok = (answer_classify(w, payload, payload_len, out) == 0);
+  else if ((!strcasecmp(line, "COUNTS")) || (!strcasecmp(line, "COUNT")))
+    fprintf(out, "no tables loaded (-p)\n");
+  else if ((!strcasecmp(line, "QUERY")) || (!strcasecmp(line, "DEMOG")) ||
+           (!strcasecmp(line, "LOOKUP")))
+    fprintf(out, "no index loaded (-i)\n");
+  else
+    fprintf(out, "unknown request %s\n", line);
+  fclose(out);
+  gen_release(g);
+  status = reply(fd, ok, text, text_len);
+  free(text);
+  return status;
+} //----- answer -----//
+
+
+static int serve_conn (struct worker *w, struct conn *c) {
+/*****************************************************************
+ *
+ *  Read what the client has sent and answer every whole request
+ *  in it.  -1 when the client is gone or misbehaves; else the
+ *  rest waits for more input.
+ *
+ *****************************************************************/
+  char *nl, *line;
+  size_t used, need;
+  long long payload;
+  ssize_t n;
+  int eof = 0;
+
+  for (;;) {
+    if (c->cap - c->len < 4096) {
+      c->cap = c->cap ? 2*c->cap : 8192;
+      c->buf = realloc(c->buf, c->cap);
+    }
+    if ((n = recv(c->fd, c->buf + c->len, c->cap - c->len - 1, 0)) > 0) {
+      if ((c->len += n) > MAX_CLASSIFY + MAX_LINE)
+        break;                       /* answer what is here first */
+      continue;
+    }
+    if ((n == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)))
+      eof = 1;
+    if ((n < 0) && (errno == EINTR))
+      continue;
+    break;
+  }
+
+  used = 0;
+  while ((nl = memchr(c->buf + used, '\n', c->len - used)) != NULL) {
+    line = c->buf + used;
+    *nl = '\0';
+    if ((nl > line) && (nl[-1] == '\r'))
+      nl[-1] = '\0';
+    need = nl + 1 - line;
+    payload = 0;
+    if (!strncasecmp(line, "CLASSIFY ", 9)) {
+      payload = atoll(line + 9);
+      if ((payload < 0) || (payload > MAX_CLASSIFY)) {
+        reply(c->fd, 0, "CLASSIFY is limited to 64MB", 27);
+        return -1;
+      }
+      if (used + need + payload > c->len) {
+        *nl = '\n';                  /* whole next time */
+        break;
+      }
+      line[8] = '\0';
+    }
+    if (answer(w, c->fd, line, nl + 1, payload) < 0)
+      return -1;
+    used += need + payload;
+  }
+  memmove(c->buf, c->buf + used, c->len - used);
+  c->len -= used;
+  if ((c->len > MAX_LINE) && (memchr(c->buf, '\n', c->len) == NULL)) {
+    reply(c->fd, 0, "request line too long", 21);
+    return -1;
+  }
+  return eof ? -1 : 0;
+} //----- serve_conn -----//
+
+
+/*********************************************************************
+ *
+ *  The event loop and the worker pool
+ *
+ *********************************************************************/
+static void queue_push (struct conn *c) {
+  pthread_mutex_lock(&QUEUE_LOCK);
+  if (c == &RELOAD_ITEM) {
+    if (RELOAD_QUEUED) {             /* one pending reload covers both */
+      pthread_mutex_unlock(&QUEUE_LOCK);
+      return;
+    }
+    RELOAD_QUEUED = 1;
+  }
+  c->next = NULL;
+  if (QUEUE_TAIL != NULL)
+    QUEUE_TAIL->next = c;
+  else
+    QUEUE_HEAD = c;
+  QUEUE_TAIL = c;
+  pthread_cond_signal(&QUEUE_COND);
+  pthread_mutex_unlock(&QUEUE_LOCK);
+}
+
+static struct conn * queue_pop (void) {
+  struct conn *c;
+
+  pthread_mutex_lock(&QUEUE_LOCK);
+  while ((QUEUE_HEAD == NULL) && (!STOPPING))
+    pthread_cond_wait(&QUEUE_COND, &QUEUE_LOCK);
+  if ((c = QUEUE_HEAD) != NULL)
+    if ((QUEUE_HEAD = c->next) == NULL)
+      QUEUE_TAIL = NULL;
+  if (c == &RELOAD_ITEM)
+    RELOAD_QUEUED = 0;
+  pthread_mutex_unlock(&QUEUE_LOCK);
+  return c;
+}
+
+
+static void * worker_main (void *arg) {
+  struct worker *w = arg;
+  struct epoll_event ev;
+  struct conn *c;
+
+  while ((c = queue_pop()) != NULL) {
+    if (c == &RELOAD_ITEM) {
+      gen_reload();
+      continue;
+    }
+    if (serve_conn(w, c) < 0) {
+      epoll_ctl(EPOLL_FD, EPOLL_CTL_DEL, c->fd, NULL);
+      close(c->fd);
+      free(c->buf);
+      free(c);
+      continue;
+    }
+    ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    ev.data.ptr = c;
+    epoll_ctl(EPOLL_FD, EPOLL_CTL_MOD, c->fd, &ev);
+  }
+  return NULL;
+} //----- worker_main -----//
+
+
+static int worker_init (struct worker *w) {
+  FILE *a, *b;
+
+  memset(w, 0, sizeof(*w));
+  w->have_rules = (compile_rules(&w->rules) == 0);
+  w->block = malloc(BLOCKSIZE);
+  w->line = malloc(getpagesize() + 2);
+  if (((a = tmpfile()) == NULL) || ((b = tmpfile()) == NULL)) {
+    perror("CAN'T OPEN CLASSIFY SCRATCH FILES\ncause");
+    return -1;
+  }
+  w->entries_fd = dup(fileno(a));
+  w->listing_fd = dup(fileno(b));
+  fclose(a);
+  fclose(b);
+  return 0;
+}
+
+
+int main (int argc, char *argv[]) {
+
+  const int GOOD_EXIT  = 0;
+  const int  FALSE   = 0;
+  const int  TRUE =  1;
+  const int  BAD_ARGC  = -1;
+  const int BAD_TABLES  = -2 ;
+  const int BAD_SOCKET  = -3 ;
+
+  const char *socket_path = NULL;
+  int i, k, n, opt, bad = FALSE, n_workers = 4;
+  int listen_fd, sig_fd, fd;
+  char err_msg[1024];
+  struct sockaddr_un addr;
+  struct epoll_event ev, events[64];
+  struct signalfd_siginfo si;
+  struct worker *w;
+  struct conn *c;
+  sigset_t mask;
+
+  while ((opt = getopt(argc, argv, "s:p:i:j:")) != EOF) {
+    switch (opt) {
+      case 's':
+        socket_path = optarg;
+        break;
+      case 'p':
+        TABLES_PATH = optarg;
+        break;
+      case 'i':
+        INDEX_PATH = optarg;
+        break;
+      case 'j':
+        n_workers = atoi(optarg);
+        if (n_workers < 1)
+          n_workers = 1;
+        if (n_workers > MAX_WORKERS)
+          n_workers = MAX_WORKERS;
+        break;
+      default:
+        bad = TRUE;
+    }
+  }
+  if ((bad) || (socket_path == NULL) || (optind < argc) ||
+      (strlen(socket_path) >= sizeof(addr.sun_path))) {
+    sprintf(err_msg,"USAGE: promogd -s <socket> [-p <tables>] [-i <index>]"
+        " [-j <workers>] O:=} Not");
+    perror(err_msg);
+    return BAD_ARGC;
+  }
+  if ((CURRENT = gen_load()) == NULL)
+    return BAD_TABLES;
+
+  /*****************************************************************
+   *  Signals arrive on a descriptor in the event loop, so every
+   *  thread blocks them
+   *****************************************************************/
+  signal(SIGPIPE, SIG_IGN);
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGHUP);
+  sigaddset(&mask, SIGINT);
+  sigaddset(&mask, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &mask, NULL);
+  sig_fd = signalfd(-1, &mask, SFD_CLOEXEC);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socket_path);
+  unlink(socket_path);
+  if (((listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0) ||
+      (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) ||
+      (listen(listen_fd, 128) < 0)) {
+    sprintf(err_msg,"CAN'T LISTEN ON %s\ncause", socket_path);
+    perror(err_msg);
+    return BAD_SOCKET;
+  }
+  EPOLL_FD = epoll_create1(EPOLL_CLOEXEC);
+  ev.events = EPOLLIN;
+  ev.data.ptr = NULL;                /* the listener */
+  epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, listen_fd, &ev);
+  ev.data.ptr = &SIGNAL_ITEM;
+  epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, sig_fd, &ev);
+
+  w = calloc(n_workers, sizeof(struct worker));
+  for (k=0;k<n_workers;k++)
+    if ((worker_init(&w[k]) < 0) || (pthread_create(&w[k].tid, NULL, worker_main, &w[k]))) {
+      fprintf(stderr, "CAN'T START WORKER %d\n", k);
+      return BAD_SOCKET;
+    }
+  fprintf(stderr, "promogd: %s, %d workers, generation %lld\n", socket_path, n_workers,
+          CURRENT->serial);
+
+  while (!STOPPING) {
+    if ((n = epoll_wait(EPOLL_FD, events, 64, -1)) < 0) {
+      if (errno == EINTR)
+        continue;
+      perror("epoll_wait");
+      break;
+    }
+    for (i=0;i<n;i++) {
+      if (events[i].data.ptr == NULL) {
+        while ((fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+          c = calloc(1, sizeof(struct conn));
+          c->fd = fd;
+          ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+          ev.data.ptr = c;
+          epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, fd, &ev);
+        }
+      }
+      else if (events[i].data.ptr == &SIGNAL_ITEM) {
+        if (read(sig_fd, &si, sizeof(si)) != sizeof(si))
+          continue;
+        if (si.ssi_signo == SIGHUP)
+          queue_push(&RELOAD_ITEM);
+        else
+          STOPPING = TRUE;
+      }
+      else
+        queue_push(events[i].data.ptr);
+    }
+  } //--- while (!STOPPING) ---//
+
+  pthread_mutex_lock(&QUEUE_LOCK);
+  pthread_cond_broadcast(&QUEUE_COND);
+  pthread_mutex_unlock(&QUEUE_LOCK);
+  for (k=0;k<n_workers;k++) {
+    pthread_join(w[k].tid, NULL);
+    if (w[k].have_rules)
+      free_rules(&w[k].rules);
+    free(w[k].block);
+    free(w[k].line);
+    close(w[k].entries_fd);
+    close(w[k].listing_fd);
+  }
+  free(w);
+  close(listen_fd);
+  unlink(socket_path);
+  gen_release(CURRENT);
+  return GOOD_EXIT;
+}// int main (int argc, char *argv[]) -----//
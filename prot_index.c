@@ -0,0 +1,1409 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  PROT_INDEX -- inverted record bitmaps per term
+ *
+ *  Every SCL term, GO term, FT feature, compartment, RC tissue and
+ *  OX taxon gets one compressed bitmap of the record ordinals that
+ *  carry it.  The bitmaps are Roaring-style: the 32 bit ordinal
+ *  space is cut into 65536-value chunks keyed by the high 16 bits,
+ *  and each chunk is held either as a sorted array of low 16 bits
+ *  (up to 4096 values) or as a 65536 bit bitset.  Bitset-vs-bitset
+ *  AND/OR/ANDNOT run over 256 bit vectors, which gcc lowers to
+ *  SSE/AVX, so set algebra over all of TrEMBL is a few hundred
+ *  thousand vector operations.
+ *
+ *  Index file layout (native byte order):
+ *
+ *    header            struct pindex_header, 64 bytes
+ *    accessions        n_records * ACC_WIDTH bytes, '\0' padded
+ *    bitmaps           one serialized roaring per term
+ *    directory         per term: int name_len, name, offset, card
+ *
+ *  pindex_query() reads only the bitmaps a query names.  A server
+ *  that answers many queries opens a pindex_view instead, which
+ *  holds every bitmap in memory, maps the accessions and hashes
+ *  them, so a query does no I/O and an accession is found in O(1).
+ *
+ *********************************************************************/
+
+#define RB_ARRAY        0
+#define RB_BITSET       1
+#define RB_ARRAY_MAX    4096
+#define RB_WORDS        1024       /* 65536 bits of unsigned long long */
+#define RB_VEC_WORDS    4
+#define PINDEX_MAGIC    "PROMOGIX"
+#define PINDEX_VERSION  1
+#define MAX_TERM_NAME   (TISSUE_LEN+16)
+
+typedef unsigned long long rb_vec __attribute__ ((vector_size (8*RB_VEC_WORDS)));
+
+struct rb_container {
+  unsigned short key;          /* high 16 bits of every value held */
+  unsigned short type;         /* RB_ARRAY or RB_BITSET */
+  int card;
+  int cap;                     /* array capacity in values */
+  void *data;                  /* unsigned short[cap] or unsigned long long[RB_WORDS] */
+};
+
+struct roaring {
+  int n, cap;
+  struct rb_container *c;
+};
+
+struct pterm {
+  char *name;
+  struct roaring bits;
+};
+
+struct pindex {
+  long long n_records;
+  FILE *acc_fp;                /* accessions in ordinal order, until pindex_write */
+  int n_terms, cap_terms;
+  struct pterm *terms;
+  int *hash, hash_cap;         /* open addressing over terms[], -1 is empty */
+  struct arena names;          /* of terms[] */
+};
+
+struct pindex_header {
+  char magic[8];
+  int version;
+  int acc_width;
+  long long n_records;
+  long long n_terms;
+  long long dir_offset;
+  char pad[24];
+};
+
+struct pindex_view {
+  struct pindex_header hdr;
+  char **names;
+  long long *offsets;
+  struct roaring *bits;        /* per term, all resident */
+  void *map;                   /* the whole file, read only */
+  size_t map_len;
+  const char *acc;             /* n_records * ACC_WIDTH within map */
+  unsigned int *acc_hash;      /* ordinal+1 by accession, 0 is empty */
+  long long acc_hash_cap;
+};
+
+/*********************************************************************
+ *  Query term aliases for features spelled out in prose
+ *********************************************************************/
+static const char *ALIAS_ARRAY[][2] = {
+  {"signal peptide", "ft:SIGNAL"}, {"transmembrane", "ft:TRANSMEM"},
+  {"intramembrane", "ft:INTRAMEM"}, {"lipidation", "ft:LIPID"},
+  {"dna binding", "ft:DNA_BIND"}, {"human", "taxon:9606"} };
+static const int ALIAS_COUNT = sizeof(ALIAS_ARRAY)/sizeof(ALIAS_ARRAY[0]);
+
+
+/*********************************************************************
+ *
+ *  Containers
+ *
+ *********************************************************************/
+static unsigned long long * rb_bitset_alloc (void) {
+  void *words = NULL;
+
+  if (posix_memalign(&words, 64, RB_WORDS*sizeof(unsigned long long))) {
+    perror("CAN'T ALLOCATE BITSET CONTAINER\ncause");
+    exit(-2);
+  }
+  memset(words, 0, RB_WORDS*sizeof(unsigned long long));
+  return words;
+}
+
+static int rb_bitset_card (const unsigned long long *w) {
+  int i, card = 0;
+
+  for (i=0;i<RB_WORDS;i++)
+    card += __builtin_popcountll(w[i]);
+  return card;
+}
+
+static void rb_to_bitset (struct rb_container *c) {
+  unsigned short *a = c->data;
+  unsigned long long *w = rb_bitset_alloc();
+  int i;
+
+  for (i=0;i<c->card;i++)
+    w[a[i]>>6] |= 1ULL << (a[i] & 63);
+  free(a);
+  c->data = w;
+  c->type = RB_BITSET;
+  c->cap = 0;
+}
+
+static void rb_normalize (struct rb_container *c) {
+/*****************************************************************
+ *  A bitset holding no more than RB_ARRAY_MAX values goes back
+ *  to being an array, which is both smaller and faster to probe.
+ *****************************************************************/
+  unsigned long long *w = c->data, word;
+  unsigned short *a;
+  int i, n = 0;
+
+  if ((c->type != RB_BITSET) || (c->card > RB_ARRAY_MAX))
+    return;
+  a = malloc((c->card ? c->card : 1)*sizeof(unsigned short));
+  for (i=0;i<RB_WORDS;i++) {
+    word = w[i];
+    while (word) {
+      a[n++] = (unsigned short)(i*64 + __builtin_ctzll(word));
+      word &= word - 1;
+    }
+  }
+  free(w);
+  c->data = a;
+  c->type = RB_ARRAY;
+  c->cap = c->card ? c->card : 1;
+}
+
+static int rb_contains (const struct rb_container *c, unsigned short low) {
+  const unsigned short *a;
+  int lo, hi, mid;
+
+  if (c->type == RB_BITSET)
+    return (((const unsigned long long *)c->data)[low>>6] >> (low & 63)) & 1;
+  a = c->data;
+  lo = 0;
+  hi = c->card - 1;
+  while (lo <= hi) {
+    mid = (lo + hi) >> 1;
+    if (a[mid] == low)
+      return 1;
+    if (a[mid] < low)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+  return 0;
+}
+
+static void rb_clone (const struct rb_container *src, struct rb_container *dst) {
+  size_t bytes;
+
+  *dst = *src;
+  if (src->type == RB_BITSET) {
+    dst->data = rb_bitset_alloc();
+    bytes = RB_WORDS*sizeof(unsigned long long);
+  }
+  else {
+    dst->cap = src->card ? src->card : 1;
+    bytes = src->card*sizeof(unsigned short);
+    dst->data = malloc(dst->cap*sizeof(unsigned short));
+  }
+  memcpy(dst->data, src->data, bytes);
+}
+
+static void rb_container_and (const struct rb_container *a, const struct rb_container *b,
+                              struct rb_container *out) {
+  const unsigned short *x, *y;
+  unsigned short *z;
+  const rb_vec *va, *vb;
+  rb_vec *vz;
+  int i = 0, j = 0, n = 0;
+
+  out->key = a->key;
+  if ((a->type == RB_BITSET) && (b->type == RB_BITSET)) {
+    out->type = RB_BITSET;
+    out->data = rb_bitset_alloc();
+    va = a->data;
+    vb = b->data;
+    vz = out->data;
+    for (i=0;i<RB_WORDS/RB_VEC_WORDS;i++)
+      vz[i] = va[i] & vb[i];
+    out->card = rb_bitset_card(out->data);
+    rb_normalize(out);
+    return;
+  }
+  if (a->type == RB_BITSET) {
+    const struct rb_container *t = a;
+    a = b;
+    b = t;
+  }
+  /*  a is an array: the result can only shrink  */
+  x = a->data;
+  z = malloc((a->card ? a->card : 1)*sizeof(unsigned short));
+  if (b->type == RB_BITSET) {
+    for (i=0;i<a->card;i++)
+      if (rb_contains(b, x[i]))
+        z[n++] = x[i];
+  }
+  else {
+    y = b->data;
+    while ((i < a->card) && (j < b->card)) {
+      if (x[i] < y[j])
+        i++;
+      else if (x[i] > y[j])
+        j++;
+      else {
+        z[n++] = x[i];
+        i++;
+        j++;
+      }
+    }
+  }
+  out->type = RB_ARRAY;
+  out->data = z;
+  out->card = n;
+  out->cap = a->card ? a->card : 1;
+}
+
+static void rb_container_or (const struct rb_container *a, const struct rb_container *b,
+                             struct rb_container *out) {
+  const unsigned short *x, *y;
+  unsigned short *z;
+  const rb_vec *va, *vb;
+  rb_vec *vz;
+  unsigned long long *w;
+  int i = 0, j = 0, n = 0;
+
+  out->key = a->key;
+  if ((a->type == RB_ARRAY) && (b->type == RB_ARRAY) &&
+      (a->card + b->card <= RB_ARRAY_MAX)) {
+    x = a->data;
+    y = b->data;
+    z = malloc((a->card + b->card + 1)*sizeof(unsigned short));
+    while ((i < a->card) || (j < b->card)) {
+      if ((j == b->card) || ((i < a->card) && (x[i] < y[j])))
+        z[n++] = x[i++];
+      else if ((i == a->card) || (x[i] > y[j]))
+        z[n++] = y[j++];
+      else {
+        z[n++] = x[i++];
+        j++;
+      }
+    }
+    out->type = RB_ARRAY;
+    out->data = z;
+    out->card = n;
+    out->cap = a->card + b->card + 1;
+    return;
+  }
+  out->type = RB_BITSET;
+  out->data = w = rb_bitset_alloc();
+  if ((a->type == RB_BITSET) && (b->type == RB_BITSET)) {
+    va = a->data;
+    vb = b->data;
+    vz = out->data;
+    for (i=0;i<RB_WORDS/RB_VEC_WORDS;i++)
+      vz[i] = va[i] | vb[i];
+  }
+  else {
+    if (a->type == RB_ARRAY) {
+      const struct rb_container *t = a;
+      a = b;
+      b = t;
+    }
+    if (a->type == RB_BITSET)
+      memcpy(w, a->data, RB_WORDS*sizeof(unsigned long long));
+    else
+      for (x = a->data, i=0;i<a->card;i++)
+        w[x[i]>>6] |= 1ULL << (x[i] & 63);
+    for (y = b->data, j=0;j<b->card;j++)
+      w[y[j]>>6] |= 1ULL << (y[j] & 63);
+  }
+  out->card = rb_bitset_card(w);
+  rb_normalize(out);
+}
+
+static void rb_container_andnot (const struct rb_container *a, const struct rb_container *b,
+                                 struct rb_container *out) {
+  const unsigned short *x, *y;
+  unsigned short *z;
+  const rb_vec *va, *vb;
+  rb_vec *vz;
+  unsigned long long *w;
+  int i = 0, j = 0, n = 0;
+
+  out->key = a->key;
+  if (a->type == RB_ARRAY) {
+    x = a->data;
+    z = malloc((a->card ? a->card : 1)*sizeof(unsigned short));
+    if (b->type == RB_BITSET) {
+      for (i=0;i<a->card;i++)
+        if (!rb_contains(b, x[i]))
+          z[n++] = x[i];
+    }
+    else {
+      y = b->data;
+      while (i < a->card) {
+        while ((j < b->card) && (y[j] < x[i]))
+          j++;
+        if ((j == b->card) || (y[j] != x[i]))
+          z[n++] = x[i];
+        i++;
+      }
+    }
+    out->type = RB_ARRAY;
+    out->data = z;
+    out->card = n;
+    out->cap = a->card ? a->card : 1;
+    return;
+  }
+  out->type = RB_BITSET;
+  out->data = w = rb_bitset_alloc();
+  if (b->type == RB_BITSET) {
+    va = a->data;
+    vb = b->data;
+    vz = out->data;
+    for (i=0;i<RB_WORDS/RB_VEC_WORDS;i++)
+      vz[i] = va[i] & ~vb[i];
+  }
+  else {
+    memcpy(w, a->data, RB_WORDS*sizeof(unsigned long long));
+    for (y = b->data, j=0;j<b->card;j++)
+      w[y[j]>>6] &= ~(1ULL << (y[j] & 63));
+  }
+  out->card = rb_bitset_card(w);
+  rb_normalize(out);
+}
+
+
+/*********************************************************************
+ *
+ *  Bitmaps
+ *
+ *********************************************************************/
+static void rb_free (struct roaring *r) {
+  int i;
+
+  for (i=0;i<r->n;i++)
+    free(r->c[i].data);
+  free(r->c);
+  r->c = NULL;
+  r->n = r->cap = 0;
+}
+
+static struct rb_container * rb_push (struct roaring *r) {
+  if (r->n == r->cap) {
+    r->cap = r->cap ? 2*r->cap : 4;
+    r->c = realloc(r->c, r->cap*sizeof(struct rb_container));
+  }
+  return &r->c[r->n++];
+}
+
+static void rb_keep (struct roaring *r, struct rb_container *c) {
+/*****************************************************************
+ *  Add a computed container, dropping it if it came out empty
+ *****************************************************************/
+  if (c->card)
+    *rb_push(r) = *c;
+  else
+    free(c->data);
+}
+
+static void rb_append (struct roaring *r, unsigned int v) {
+/*****************************************************************
+ *  Add v, which must not be less than any value already present.
+ *  Record ordinals arrive in file order, so this is the only
+ *  insertion the index builder needs.
+ *****************************************************************/
+  unsigned short key = v >> 16, low = v & 0xffff, *a;
+  unsigned long long *w;
+  struct rb_container *c;
+
+  if ((r->n == 0) || (r->c[r->n-1].key != key)) {
+    c = rb_push(r);
+    c->key = key;
+    c->type = RB_ARRAY;
+    c->card = 0;
+    c->cap = 16;
+    c->data = malloc(c->cap*sizeof(unsigned short));
+  }
+  c = &r->c[r->n-1];
+  if (c->type == RB_ARRAY) {
+    a = c->data;
+    if ((c->card) && (a[c->card-1] == low))
+      return;
+    if (c->card < RB_ARRAY_MAX) {
+      if (c->card == c->cap) {
+        c->cap *= 2;
+        c->data = a = realloc(a, c->cap*sizeof(unsigned short));
+      }
+      a[c->card++] = low;
+      return;
+    }
+    rb_to_bitset(c);
+  }
+  w = c->data;
+  if (!((w[low>>6] >> (low & 63)) & 1)) {
+    w[low>>6] |= 1ULL << (low & 63);
+    c->card++;
+  }
+}
+
+static long long rb_card (const struct roaring *r) {
+  long long card = 0;
+  int i;
+
+  for (i=0;i<r->n;i++)
+    card += r->c[i].card;
+  return card;
+}
+
+static void rb_and (const struct roaring *a, const struct roaring *b, struct roaring *out) {
+  struct rb_container c;
+  int i = 0, j = 0;
+
+  memset(out, 0, sizeof(*out));
+  while ((i < a->n) && (j < b->n)) {
+    if (a->c[i].key < b->c[j].key)
+      i++;
+    else if (a->c[i].key > b->c[j].key)
+      j++;
+    else {
+      rb_container_and(&a->c[i++], &b->c[j++], &c);
+      rb_keep(out, &c);
+    }
+  }
+}
+
+static void rb_or (const struct roaring *a, const struct roaring *b, struct roaring *out) {
+  struct rb_container c;
+  int i = 0, j = 0;
+
+  memset(out, 0, sizeof(*out));
+  while ((i < a->n) || (j < b->n)) {
+    if ((j == b->n) || ((i < a->n) && (a->c[i].key < b->c[j].key)))
+      rb_clone(&a->c[i++], &c);
+    else if ((i == a->n) || (a->c[i].key > b->c[j].key))
+      rb_clone(&b->c[j++], &c);
+    else
+      rb_container_or(&a->c[i++], &b->c[j++], &c);
+    rb_keep(out, &c);
+  }
+}
+
+static void rb_andnot (const struct roaring *a, const struct roaring *b, struct roaring *out) {
+  struct rb_container c;
+  int i = 0, j = 0;
+
+  memset(out, 0, sizeof(*out));
+  while (i < a->n) {
+    while ((j < b->n) && (b->c[j].key < a->c[i].key))
+      j++;
+    if ((j < b->n) && (b->c[j].key == a->c[i].key))
+      rb_container_andnot(&a->c[i], &b->c[j], &c);
+    else
+      rb_clone(&a->c[i], &c);
+    rb_keep(out, &c);
+    i++;
+  }
+}
+
+static void rb_universe (struct roaring *r, long long n) {
+/*****************************************************************
+ *  Every ordinal in [0,n): the complement base for NOT
+ *****************************************************************/
+  struct rb_container *c;
+  unsigned long long *w;
+  long long base;
+  int i, left;
+
+  memset(r, 0, sizeof(*r));
+  for (base=0;base<n;base+=65536) {
+    c = rb_push(r);
+    c->key = (unsigned short)(base >> 16);
+    c->type = RB_BITSET;
+    c->cap = 0;
+    c->data = w = rb_bitset_alloc();
+    left = (n - base < 65536) ? (int)(n - base) : 65536;
+    for (i=0;i<left/64;i++)
+      w[i] = ~0ULL;
+    if (left & 63)
+      w[i] = (1ULL << (left & 63)) - 1;
+    c->card = left;
+    rb_normalize(c);
+  }
+}
+
+static int rb_write (const struct roaring *r, FILE *fp) {
+  int i;
+
+  if (fwrite(&r->n, sizeof(int), 1, fp) != 1)
+    return -1;
+  for (i=0;i<r->n;i++) {
+    fwrite(&r->c[i].key, sizeof(unsigned short), 1, fp);
+    fwrite(&r->c[i].type, sizeof(unsigned short), 1, fp);
+    fwrite(&r->c[i].card, sizeof(int), 1, fp);
+    if (r->c[i].type == RB_BITSET)
+      fwrite(r->c[i].data, sizeof(unsigned long long), RB_WORDS, fp);
+    else
+      fwrite(r->c[i].data, sizeof(unsigned short), r->c[i].card, fp);
+  }
+  return ferror(fp) ? -1 : 0;
+}
+
+static int rb_read (struct roaring *r, FILE *fp) {
+  struct rb_container *c;
+  int i, n;
+
+  memset(r, 0, sizeof(*r));
+  if (fread(&n, sizeof(int), 1, fp) != 1)
+    return -1;
+  for (i=0;i<n;i++) {
+    c = rb_push(r);
+    c->data = NULL;
+    if ((fread(&c->key, sizeof(unsigned short), 1, fp) != 1) ||
+        (fread(&c->type, sizeof(unsigned short), 1, fp) != 1) ||
+        (fread(&c->card, sizeof(int), 1, fp) != 1) ||
+        (c->card < 0) || (c->card > 65536))
+      return -1;
+    if (c->type == RB_BITSET) {
+      c->data = rb_bitset_alloc();
+      c->cap = 0;
+      if (fread(c->data, sizeof(unsigned long long), RB_WORDS, fp) != RB_WORDS)
+        return -1;
+    }
+    else {
+      c->cap = c->card ? c->card : 1;
+      c->data = malloc(c->cap*sizeof(unsigned short));
+      if (fread(c->data, sizeof(unsigned short), c->card, fp) != (size_t)c->card)
+        return -1;
+    }
+  }
+  return 0;
+}
+
+
+/*********************************************************************
+ *
+ *  Index builder
+ *
+ *********************************************************************/
+static unsigned int name_hash (const char *s) {
+  unsigned int h = 2166136261u;
+
+  while (*s)
+    h = (h ^ (unsigned char)*s++) * 16777619u;
+  return h;
+}
+
+static int pindex_add_term (struct pindex *ix, const char *name) {
+  int i, slot;
+
+  if (ix->n_terms == ix->cap_terms) {
+    ix->cap_terms = ix->cap_terms ? 2*ix->cap_terms : 128;
+    ix->terms = realloc(ix->terms, ix->cap_terms*sizeof(struct pterm));
+  }
+  ix->terms[ix->n_terms].name = arena_strndup(&ix->names, name, strlen(name));
+  memset(&ix->terms[ix->n_terms].bits, 0, sizeof(struct roaring));
+
+  if (2*(ix->n_terms+1) > ix->hash_cap) {
+    free(ix->hash);
+    ix->hash_cap = ix->hash_cap ? 2*ix->hash_cap : 256;
+    ix->hash = malloc(ix->hash_cap*sizeof(int));
+    for (i=0;i<ix->hash_cap;i++)
+      ix->hash[i] = -1;
+    for (i=0;i<ix->n_terms;i++) {
+      slot = name_hash(ix->terms[i].name) & (ix->hash_cap - 1);
+      while (ix->hash[slot] >= 0)
+        slot = (slot + 1) & (ix->hash_cap - 1);
+      ix->hash[slot] = i;
+    }
+  }
+  slot = name_hash(name) & (ix->hash_cap - 1);
+  while (ix->hash[slot] >= 0)
+    slot = (slot + 1) & (ix->hash_cap - 1);
+  ix->hash[slot] = ix->n_terms;
+  return ix->n_terms++;
+}
+
+static int pindex_term (struct pindex *ix, const char *name) {
+  int slot = name_hash(name) & (ix->hash_cap - 1);
+
+  while (ix->hash[slot] >= 0) {
+    if (!strcmp(ix->terms[ix->hash[slot]].name, name))
+      return ix->hash[slot];
+    slot = (slot + 1) & (ix->hash_cap - 1);
+  }
+  return pindex_add_term(ix, name);
+}
+
+struct pindex * pindex_new (void) {
+/*****************************************************************
+ *
+ *  The fixed terms come first, in the order the report prints
+ *  them: compartments, SCL, GO, minor GO, FT.  Tissues and taxa
+ *  are added as they are first seen.
+ *
+ *****************************************************************/
+  struct pindex *ix = calloc(1, sizeof(struct pindex));
+  char name[MAX_TERM_NAME];
+  int i;
+
+  if ((ix->acc_fp = tmpfile()) == NULL) {
+    perror("CAN'T OPEN INDEX SCRATCH FILE\ncause");
+    free(ix);
+    return NULL;
+  }
+  for (i=0;i<COMP_COUNT;i++) {
+    snprintf(name, sizeof(name), "comp:%s", COMP_NAMES_ARRAY[i]);
+    pindex_add_term(ix, name);
+  }
+  for (i=0;i<REGEX_COUNT;i++) {
+    snprintf(name, sizeof(name), "scl:%s", NAMES_ARRAY[i]);
+    pindex_add_term(ix, name);
+  }
+  for (i=0;i<GO_COUNT;i++) {
+    snprintf(name, sizeof(name), "go:%s", GO_NAMES_ARRAY[i]);
+    pindex_add_term(ix, name);
+  }
+  for (i=0;i<GO_MINOR_COUNT;i++) {
+    snprintf(name, sizeof(name), "go:%s", GO_NAMES_MINOR_ARRAY[i]);
+    pindex_add_term(ix, name);
+  }
+  for (i=0;i<FT_COUNT;i++) {
+    snprintf(name, sizeof(name), "ft:%s", FT_NAMES_ARRAY[i]);
+    pindex_add_term(ix, name);
+  }
+  return ix;
+} //----- pindex_new (void) -----//
+
+
+void pindex_add (struct pindex *ix, const struct prot_record *rec) {
+  char name[MAX_TERM_NAME], acc[ACC_WIDTH+1];
+  unsigned int ord = (unsigned int)rec->ordinal;
+  int i, t = 0;
+
+  memset(acc, 0, sizeof(acc));
+  while (ix->n_records < rec->ordinal) {
+    fwrite(acc, 1, ACC_WIDTH, ix->acc_fp);
+    ix->n_records++;
+  }
+  strncpy(acc, rec->accession, sizeof(acc) - 1);
+  acc[ACC_WIDTH] = '\0';
+  fwrite(acc, 1, ACC_WIDTH, ix->acc_fp);   /* fixed width, NUL padded */
+  ix->n_records = rec->ordinal + 1;
+
+  for (i=0;i<COMP_COUNT;i++,t++)
+    if (rec->compartments & (1<<i))
+      rb_append(&ix->terms[t].bits, ord);
+  for (i=0;i<REGEX_COUNT;i++,t++)
+    if (rec->is_SCL_ARRAY[i])
+      rb_append(&ix->terms[t].bits, ord);
+  for (i=0;i<GO_COUNT;i++,t++)
+    if (rec->has_GO_ARRAY[i])
+      rb_append(&ix->terms[t].bits, ord);
+  for (i=0;i<GO_MINOR_COUNT;i++,t++)
+    if (rec->has_GO_MINOR_ARRAY[i])
+      rb_append(&ix->terms[t].bits, ord);
+  for (i=0;i<FT_COUNT;i++,t++)
+    if (record_has_ft(rec, i))
+      rb_append(&ix->terms[t].bits, ord);
+
+  for (i=0;i<rec->n_tissues;i++) {
+    snprintf(name, sizeof(name), "tissue:%s", rec->tissues[i]);
+    t = pindex_term(ix, name);          /* may move terms[] */
+    rb_append(&ix->terms[t].bits, ord);
+  }
+  if (rec->taxid) {
+    snprintf(name, sizeof(name), "taxon:%d", rec->taxid);
+    t = pindex_term(ix, name);
+    rb_append(&ix->terms[t].bits, ord);
+  }
+} //----- pindex_add (struct pindex *ix, const struct prot_record *rec) -----//
+
+
+void pindex_merge (struct pindex *dst, struct pindex *src, long long base) {
+/*****************************************************************
+ *
+ *  Append the index one scanning thread built over its own range
+ *  to dst, renumbering its records from base (the number of
+ *  entries in all earlier ranges).  Called in range order, so
+ *  every value still arrives in nondecreasing order.
+ *
+ *****************************************************************/
+  char buf[1<<16], acc[ACC_WIDTH];
+  struct rb_container *c;
+  struct roaring *r;
+  unsigned long long word;
+  unsigned int high;
+  unsigned short *a;
+  size_t n;
+  int i, j, k, t;
+
+  memset(acc, 0, ACC_WIDTH);
+  fseeko(dst->acc_fp, 0, SEEK_END);
+  while (dst->n_records < base) {
+    fwrite(acc, 1, ACC_WIDTH, dst->acc_fp);
+    dst->n_records++;
+  }
+  fflush(src->acc_fp);
+  rewind(src->acc_fp);
+  while ((n = fread(buf, 1, sizeof(buf), src->acc_fp)) > 0)
+    fwrite(buf, 1, n, dst->acc_fp);
+  dst->n_records = base + src->n_records;
+
+  for (i=0;i<src->n_terms;i++) {
+    t = pindex_term(dst, src->terms[i].name);    /* may move terms[] */
+    r = &dst->terms[t].bits;
+    for (j=0;j<src->terms[i].bits.n;j++) {
+      c = &src->terms[i].bits.c[j];
+      high = (unsigned int)c->key << 16;
+      if (c->type == RB_ARRAY) {
+        a = c->data;
+        for (k=0;k<c->card;k++)
+          rb_append(r, (unsigned int)(base + (high | a[k])));
+      }
+      else
+        for (k=0;k<RB_WORDS;k++)
+          for (word = ((unsigned long long *)c->data)[k]; word; word &= word - 1)
+            rb_append(r, (unsigned int)(base + (high | (k << 6) | __builtin_ctzll(word))));
+    }
+  }
+} //----- pindex_merge (struct pindex *dst, struct pindex *src, long long base) -----//
+
+
+int pindex_write (struct pindex *ix, const char *path) {
+  struct pindex_header hdr;
+  long long *offsets;
+  char buf[1<<16];
+  size_t n;
+  FILE *fp;
+  int i, len;
+
+  if ((fp = fopen(path, "w")) == NULL) {
+    fprintf(stderr, "CAN'T OPEN INDEX FILE: %s\n", path);
+    return -1;
+  }
+  memset(&hdr, 0, sizeof(hdr));
+  fwrite(&hdr, sizeof(hdr), 1, fp);
+
+  fflush(ix->acc_fp);
+  rewind(ix->acc_fp);
+  while ((n = fread(buf, 1, sizeof(buf), ix->acc_fp)) > 0)
+    fwrite(buf, 1, n, fp);
+
+  offsets = malloc(ix->n_terms*sizeof(long long));
+  for (i=0;i<ix->n_terms;i++) {
+    offsets[i] = ftello(fp);
+    rb_write(&ix->terms[i].bits, fp);
+  }
+
+  memcpy(hdr.magic, PINDEX_MAGIC, 8);
+  hdr.version = PINDEX_VERSION;
+  hdr.acc_width = ACC_WIDTH;
+  hdr.n_records = ix->n_records;
+  hdr.n_terms = ix->n_terms;
+  hdr.dir_offset = ftello(fp);
+  for (i=0;i<ix->n_terms;i++) {
+    long long card = rb_card(&ix->terms[i].bits);
+
+    len = strlen(ix->terms[i].name);
+    fwrite(&len, sizeof(int), 1, fp);
+    fwrite(ix->terms[i].name, 1, len, fp);
+    fwrite(&offsets[i], sizeof(long long), 1, fp);
+    fwrite(&card, sizeof(long long), 1, fp);
+  }
+  free(offsets);
+  rewind(fp);
+  fwrite(&hdr, sizeof(hdr), 1, fp);
+  if (ferror(fp) | fclose(fp)) {
+    fprintf(stderr, "FAILED WRITING INDEX FILE: %s\n", path);
+    return -1;
+  }
+  return 0;
+} //----- pindex_write (struct pindex *ix, const char *path) -----//
+
+
+void pindex_free (struct pindex *ix) {
+  int i;
+
+  if (ix == NULL)
+    return;
+  for (i=0;i<ix->n_terms;i++)
+    rb_free(&ix->terms[i].bits);
+  arena_free(&ix->names);
+  free(ix->terms);
+  free(ix->hash);
+  fclose(ix->acc_fp);
+  free(ix);
+}
+
+
+/*********************************************************************
+ *
+ *  Query evaluation
+ *
+ *    expr   := term { OR term }
+ *    term   := factor { AND factor }
+ *    factor := NOT factor | ( expr ) | name
+ *
+ *  AND, OR, NOT may also be written &, |, !.  A name is one or more
+ *  words (or a "quoted string") and is looked up, ignoring case, as
+ *  a full term name ("scl:Cell Membrane"), an alias ("signal
+ *  peptide"), or a bare term name ("membrane"), the first match in
+ *  index order winning: compartments, SCL, GO, FT, tissues, taxa.
+ *
+ *********************************************************************/
+#define Q_END     0
+#define Q_LPAREN  1
+#define Q_RPAREN  2
+#define Q_AND     3
+#define Q_OR      4
+#define Q_NOT     5
+#define Q_NAME    6
+
+struct qstate {
+  const char *s;
+  FILE *fp;                    /* NULL when the index is a view */
+  const struct pindex_view *v;
+  FILE *msg;                   /* where query errors go */
+  struct pindex_header hdr;
+  char **names;
+  long long *offsets;
+  int err;
+};
+
+static int q_word_op (const char *s, int len) {
+  if ((len == 3) && (!strncasecmp(s, "AND", 3)))
+    return Q_AND;
+  if ((len == 2) && (!strncasecmp(s, "OR", 2)))
+    return Q_OR;
+  if ((len == 3) && (!strncasecmp(s, "NOT", 3)))
+    return Q_NOT;
+  return Q_NAME;
+}
+
+static int q_token (struct qstate *q, char *name, int advance) {
+/*****************************************************************
+ *  Next token; a multi-word name is gathered into name[].
+ *****************************************************************/
+  const char *s = q->s, *w;
+  int type, len, n = 0;
+
+  while (isspace((unsigned char)*s))
+    s++;
+  switch (*s) {
+    case '\0':
+      type = Q_END;
+      break;
+    case '(':
+      type = Q_LPAREN;
+      s++;
+      break;
+    case ')':
+      type = Q_RPAREN;
+      s++;
+      break;
+    case '&':
+      type = Q_AND;
+      s++;
+      break;
+    case '|':
+      type = Q_OR;
+      s++;
+      break;
+    case '!':
+      type = Q_NOT;
+      s++;
+      break;
+    case '"':
+      type = Q_NAME;
+      for (s++; (*s) && (*s != '"'); s++)
+        if (n < MAX_TERM_NAME - 1)
+          name[n++] = *s;
+      if (*s == '"')
+        s++;
+      break;
+    default:
+      type = Q_NAME;
+      for (;;) {
+        for (w = s; (*w) && (!isspace((unsigned char)*w)) && (!strchr("()&|!\"", *w)); w++)
+          ;
+        len = w - s;
+        if ((len == 0) || (q_word_op(s, len) != Q_NAME)) {
+          if (n == 0) {
+            type = q_word_op(s, len);
+            s = w;
+          }
+          break;
+        }
+        if ((n) && (n < MAX_TERM_NAME - 1))
+          name[n++] = ' ';
+        for (; s < w; s++)
+          if (n < MAX_TERM_NAME - 1)
+            name[n++] = *s;
+        while (isspace((unsigned char)*w))
+          w++;
+        if ((*w == '\0') || (strchr("()&|!\"", *w)))
+          break;
+        s = w;
+      }
+  } //--- switch (*s) ---//
+  name[n] = '\0';
+  if (advance)
+    q->s = s;
+  return type;
+}
+
+static int q_lookup (struct qstate *q, const char *name) {
+  const char *colon;
+  int i;
+
+  for (i=0;i<q->hdr.n_terms;i++)
+    if (!strcasecmp(q->names[i], name))
+      return i;
+  for (i=0;i<ALIAS_COUNT;i++)
+    if (!strcasecmp(ALIAS_ARRAY[i][0], name))
+      return q_lookup(q, ALIAS_ARRAY[i][1]);
+  for (i=0;i<q->hdr.n_terms;i++)
+    if (((colon = strchr(q->names[i], ':')) != NULL) && (!strcasecmp(colon+1, name)))
+      return i;
+  return -1;
+}
+
+static unsigned int acc_hash (const char *acc) {
+  unsigned int h = 2166136261u;
+  int i;
+
+  for (i=0;(i<ACC_WIDTH)&&(acc[i]);i++)
+    h = (h ^ (unsigned char)toupper((unsigned char)acc[i])) * 16777619u;
+  return h;
+}
+
+static long long view_find (const struct pindex_view *v, const char *acc) {
+/*****************************************************************
+ *  The ordinal of the record with this accession, or -1
+ *****************************************************************/
+  long long slot, ord;
+
+  if ((strlen(acc) > ACC_WIDTH) || (v->acc_hash_cap == 0))
+    return -1;
+  for (slot=acc_hash(acc)&(v->acc_hash_cap-1);v->acc_hash[slot];slot=(slot+1)&(v->acc_hash_cap-1)) {
+    ord = v->acc_hash[slot] - 1;
+    if (!strncasecmp(v->acc + ord*ACC_WIDTH, acc, ACC_WIDTH))
+      return ord;
+  }
+  return -1;
+}
+
+static void rb_copy (const struct roaring *src, struct roaring *dst) {
+  int i;
+
+  memset(dst, 0, sizeof(*dst));
+  for (i=0;i<src->n;i++)
+    rb_clone(&src->c[i], rb_push(dst));
+}
+
+static void q_expr (struct qstate *q, struct roaring *out);
+
+static void q_factor (struct qstate *q, struct roaring *out) {
+  char name[MAX_TERM_NAME];
+  struct roaring x, all;
+  long long ord;
+  int t;
+
+  memset(out, 0, sizeof(*out));
+  switch (q_token(q, name, 1)) {
+    case Q_NOT:
+      q_factor(q, &x);
+      rb_universe(&all, q->hdr.n_records);
+      rb_andnot(&all, &x, out);
+      rb_free(&all);
+      rb_free(&x);
+      break;
+    case Q_LPAREN:
+      q_expr(q, out);
+      if (q_token(q, name, 1) != Q_RPAREN) {
+        fprintf(q->msg, "query: missing ')'\n");
+        q->err = 1;
+      }
+      break;
+    case Q_NAME:
+      if (((t = q_lookup(q, name)) < 0) && (q->v != NULL) &&
+          ((ord = view_find(q->v, name)) >= 0)) {
+        rb_append(out, (unsigned int)ord);    /* an accession: just that record */
+        break;
+      }
+      if (t < 0) {
+        fprintf(q->msg, "query: no term \"%s\" in the index\n", name);
+        q->err = 1;
+        break;
+      }
+      if (q->v != NULL) {
+        rb_copy(&q->v->bits[t], out);
+        break;
+      }
+      fseeko(q->fp, q->offsets[t], SEEK_SET);
+      if (rb_read(out, q->fp)) {
+        fprintf(q->msg, "query: corrupt bitmap for \"%s\"\n", q->names[t]);
+        q->err = 1;
+      }
+      break;
+    default:
+      fprintf(q->msg, "query: expected a term near \"%s\"\n", q->s);
+      q->err = 1;
+  } //--- switch (q_token(q, name, 1)) ---//
+}
+
+static void q_term (struct qstate *q, struct roaring *out) {
+  char name[MAX_TERM_NAME];
+  struct roaring rhs, acc;
+
+  q_factor(q, out);
+  while ((!q->err) && (q_token(q, name, 0) == Q_AND)) {
+    q_token(q, name, 1);
+    q_factor(q, &rhs);
+    rb_and(out, &rhs, &acc);
+    rb_free(out);
+    rb_free(&rhs);
+    *out = acc;
+  }
+}
+
+static void q_expr (struct qstate *q, struct roaring *out) {
+  char name[MAX_TERM_NAME];
+  struct roaring rhs, acc;
+
+  q_term(q, out);
+  while ((!q->err) && (q_token(q, name, 0) == Q_OR)) {
+    q_token(q, name, 1);
+    q_term(q, &rhs);
+    rb_or(out, &rhs, &acc);
+    rb_free(out);
+    rb_free(&rhs);
+    *out = acc;
+  }
+}
+
+
+static int q_acc (struct qstate *q, long long ord, char *acc) {
+  if (q->v != NULL) {
+    memcpy(acc, q->v->acc + ord*ACC_WIDTH, ACC_WIDTH);
+    return 0;
+  }
+  fseeko(q->fp, sizeof(q->hdr) + ord*ACC_WIDTH, SEEK_SET);
+  return (fread(acc, 1, ACC_WIDTH, q->fp) == ACC_WIDTH) ? 0 : -1;
+}
+
+static void q_print (struct qstate *q, const struct roaring *result, const char *expr,
+                     FILE *out) {
+/*****************************************************************
+ *  The count of matches, then their accessions in ordinal order
+ *****************************************************************/
+  const struct rb_container *c;
+  unsigned long long word;
+  char acc[ACC_WIDTH+1];
+  long long ord;
+  int i, j;
+
+  fprintf(out, "%lld of %lld records match: %s\n", rb_card(result), q->hdr.n_records, expr);
+  acc[ACC_WIDTH] = '\0';
+  for (i=0;i<result->n;i++) {
+    c = &result->c[i];
+    if (c->type == RB_ARRAY) {
+      for (j=0;j<c->card;j++) {
+        ord = ((long long)c->key << 16) | ((unsigned short *)c->data)[j];
+        if (q_acc(q, ord, acc) == 0)
+          fprintf(out, "%s\n", acc);
+      }
+      continue;
+    }
+    for (j=0;j<RB_WORDS;j++) {
+      for (word = ((unsigned long long *)c->data)[j]; word; word &= word - 1) {
+        ord = ((long long)c->key << 16) | (j*64 + __builtin_ctzll(word));
+        if (q_acc(q, ord, acc) == 0)
+          fprintf(out, "%s\n", acc);
+      }
+    }
+  }
+} //----- q_print -----//
+
+
+static int read_directory (FILE *fp, const char *path, struct pindex_header *hdr,
+                           char ***names, long long **offsets) {
+/*****************************************************************
+ *  Check the header and read the term directory of an index
+ *****************************************************************/
+  long long card;
+  int i, len;
+
+  if ((fread(hdr, sizeof(*hdr), 1, fp) != 1) ||
+      (memcmp(hdr->magic, PINDEX_MAGIC, 8)) || (hdr->version != PINDEX_VERSION) ||
+      (hdr->acc_width != ACC_WIDTH)) {
+    fprintf(stderr, "NOT A PROMOG INDEX: %s\n", path);
+    *names = NULL;
+    *offsets = NULL;
+    return -1;
+  }
+  *names = calloc(hdr->n_terms, sizeof(char *));
+  *offsets = malloc(hdr->n_terms*sizeof(long long));
+  fseeko(fp, hdr->dir_offset, SEEK_SET);
+  for (i=0;i<hdr->n_terms;i++) {
+    if ((fread(&len, sizeof(int), 1, fp) != 1) || (len < 0) || (len > 1<<16))
+      break;
+    (*names)[i] = calloc(len+1, 1);
+    if ((fread((*names)[i], 1, len, fp) != (size_t)len) ||
+        (fread(&(*offsets)[i], sizeof(long long), 1, fp) != 1) ||
+        (fread(&card, sizeof(long long), 1, fp) != 1))
+      break;
+  }
+  if (i < hdr->n_terms) {
+    fprintf(stderr, "CORRUPT INDEX DIRECTORY: %s\n", path);
+    return -1;
+  }
+  return 0;
+} //----- read_directory -----//
+
+
+int pindex_query (const char *path, const char *expr, FILE *out) {
+/*****************************************************************
+ *
+ *  Evaluate expr against the index at path and print the number
+ *  of matching records followed by their accessions, one per
+ *  line.  Only the bitmaps named in expr are read from disk.
+ *
+ *****************************************************************/
+  struct qstate q;
+  struct roaring result;
+  char name[MAX_TERM_NAME];
+  int i, status = 0;
+
+  memset(&q, 0, sizeof(q));
+  q.s = expr;
+  q.msg = stderr;
+  if ((q.fp = fopen(path, "r")) == NULL) {
+    fprintf(stderr, "CAN'T OPEN INDEX FILE: %s\n", path);
+    return -1;
+  }
+  if (read_directory(q.fp, path, &q.hdr, &q.names, &q.offsets) < 0)
+    q.err = 1;
+  else {
+    q_expr(&q, &result);
+    if ((!q.err) && (q_token(&q, name, 0) != Q_END)) {
+      fprintf(stderr, "query: unexpected \"%s\"\n", q.s);
+      q.err = 1;
+    }
+    if (!q.err)
+      q_print(&q, &result, expr, out);
+    rb_free(&result);
+  }
+  status = q.err ? -1 : 0;
+  for (i=0;(q.names!=NULL)&&(i<q.hdr.n_terms);i++)
+    free(q.names[i]);
+  free(q.names);
+  free(q.offsets);
+  fclose(q.fp);
+  return status;
+} //----- pindex_query (const char *path, const char *expr, FILE *out) -----//
+
+
+/*********************************************************************
+ *
+ *  Resident views, for promogd
+ *
+ *  A view answers the same queries as pindex_query(), and also
+ *  takes an accession as a name (the set of that one record), so
+ *  "P12345 OR Q8N158" is a list.  Query errors go to out, not
+ *  stderr, for the server to pass back.
+ *
+ *********************************************************************/
+struct pindex_view * pindex_open (const char *path) {
+  struct pindex_view *v = calloc(1, sizeof(struct pindex_view));
+  struct stat sb;
+  FILE *fp;
+  long long ord, slot;
+  int i, bad = 0;
+
+  if ((fp = fopen(path, "r")) == NULL) {
+    fprintf(stderr, "CAN'T OPEN INDEX FILE: %s\n", path);
+    free(v);
+    return NULL;
+  }
+  if (read_directory(fp, path, &v->hdr, &v->names, &v->offsets) < 0)
+    bad = 1;
+  else {
+    v->bits = calloc(v->hdr.n_terms, sizeof(struct roaring));
+    for (i=0;(!bad)&&(i<v->hdr.n_terms);i++)
+      if ((fseeko(fp, v->offsets[i], SEEK_SET)) || (rb_read(&v->bits[i], fp))) {
+        fprintf(stderr, "CORRUPT BITMAP FOR %s IN %s\n", v->names[i], path);
+        bad = 1;
+      }
+  }
+  if ((!bad) && ((fstat(fileno(fp), &sb)) ||
+      (sb.st_size < (off_t)(sizeof(v->hdr) + v->hdr.n_records*ACC_WIDTH)) ||
+      ((v->map = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, fileno(fp), 0)) == MAP_FAILED))) {
+    fprintf(stderr, "CAN'T MAP INDEX FILE: %s\n", path);
+    v->map = NULL;
+    bad = 1;
+  }
+  fclose(fp);
+  if (bad) {
+    pindex_close(v);
+    return NULL;
+  }
+  v->map_len = sb.st_size;
+  v->acc = (const char *)v->map + sizeof(v->hdr);
+
+  for (v->acc_hash_cap=1;v->acc_hash_cap<2*v->hdr.n_records;v->acc_hash_cap*=2)
+    ;
+  v->acc_hash = calloc(v->acc_hash_cap, sizeof(unsigned int));
+  for (ord=0;ord<v->hdr.n_records;ord++) {
+    slot = acc_hash(v->acc + ord*ACC_WIDTH) & (v->acc_hash_cap - 1);
+    while (v->acc_hash[slot])
+      slot = (slot + 1) & (v->acc_hash_cap - 1);
+    v->acc_hash[slot] = ord + 1;
+  }
+  return v;
+} //----- pindex_open (const char *path) -----//
+
+
+long long pindex_view_records (const struct pindex_view *v) {
+  return v->hdr.n_records;
+}
+
+
+static int view_eval (const struct pindex_view *v, const char *expr, FILE *out,
+                      struct qstate *q, struct roaring *result) {
+  char name[MAX_TERM_NAME];
+
+  memset(q, 0, sizeof(*q));
+  q->s = expr;
+  q->v = v;
+  q->msg = out;
+  q->hdr = v->hdr;
+  q->names = v->names;
+  q->offsets = v->offsets;
+  q_expr(q, result);
+  if ((!q->err) && (q_token(q, name, 0) != Q_END)) {
+    fprintf(out, "query: unexpected \"%s\"\n", q->s);
+    q->err = 1;
+  }
+  if (q->err) {
+    rb_free(result);
+    return -1;
+  }
+  return 0;
+}
+
+
+int pindex_view_query (const struct pindex_view *v, const char *expr, FILE *out) {
+  struct qstate q;
+  struct roaring result;
+
+  if (view_eval(v, expr, out, &q, &result) < 0)
+    return -1;
+  q_print(&q, &result, expr, out);
+  rb_free(&result);
+  return 0;
+} //----- pindex_view_query -----//
+
+
+int pindex_view_demog (const struct pindex_view *v, const char *expr, FILE *out) {
+/*****************************************************************
+ *  How the records matching expr fall into the four compartments
+ *****************************************************************/
+  struct qstate q;
+  struct roaring result, in;
+  char name[MAX_TERM_NAME];
+  int i, t;
+
+  if (view_eval(v, expr, out, &q, &result) < 0)
+    return -1;
+  fprintf(out, "%lld of %lld records match: %s\n", rb_card(&result), v->hdr.n_records, expr);
+  for (i=0;i<COMP_COUNT;i++) {
+    snprintf(name, sizeof(name), "comp:%s", COMP_NAMES_ARRAY[i]);
+    if ((t = q_lookup(&q, name)) < 0)
+      continue;
+    rb_and(&result, &v->bits[t], &in);
+    fprintf(out, "%s\t%lld\n", COMP_NAMES_ARRAY[i], rb_card(&in));
+    rb_free(&in);
+  }
+  rb_free(&result);
+  return 0;
+} //----- pindex_view_demog -----//
+
+
+int pindex_view_lookup (const struct pindex_view *v, const char *acc, FILE *out) {
+/*****************************************************************
+ *  An accession's record ordinal and every term it carries
+ *****************************************************************/
+  const struct roaring *r;
+  long long ord;
+  unsigned short key;
+  int t, lo, hi, mid;
+
+  if ((ord = view_find(v, acc)) < 0) {
+    fprintf(out, "lookup: no accession \"%s\" in the index\n", acc);
+    return -1;
+  }
+  fprintf(out, "%.*s\trecord %lld\n", ACC_WIDTH, v->acc + ord*ACC_WIDTH, ord);
+  key = ord >> 16;
+  for (t=0;t<v->hdr.n_terms;t++) {
+    r = &v->bits[t];
+    lo = 0;
+    hi = r->n - 1;
+    while (lo <= hi) {
+      mid = (lo + hi) >> 1;
+      if (r->c[mid].key == key) {
+        if (rb_contains(&r->c[mid], ord & 0xffff))
+          fprintf(out, "%s\n", v->names[t]);
+        break;
+      }
+      if (r->c[mid].key < key)
+        lo = mid + 1;
+      else
+        hi = mid - 1;
+    }
+  }
+  return 0;
+} //----- pindex_view_lookup -----//
+
+
+void pindex_close (struct pindex_view *v) {
+  int i;
+
+  if (v == NULL)
+    return;
+  for (i=0;(v->names!=NULL)&&(i<v->hdr.n_terms);i++) {
+    free(v->names[i]);
+    if (v->bits != NULL)
+      rb_free(&v->bits[i]);
+  }
+  free(v->names);
+  free(v->offsets);
+  free(v->bits);
+  free(v->acc_hash);
+  if (v->map != NULL)
+    munmap(v->map, v->map_len);
+  free(v);
+}
@@ -0,0 +1,230 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  RCACHE -- rendered cellgrams keyed on what they show
+ *
+ *  A cellgram is a function of its title, infile, four counts and
+ *  the drawing code, so the PNG of an earlier render can stand in
+ *  for a new one.  rcache_get() copies <dir>/<key>.png to the job's
+ *  output if it is there, and render.c only draws on a miss, then
+ *  rcache_put() files the new image under its key (a temporary name
+ *  and a rename, so that promog and stub can share one directory).
+ *
+ *  The key hashes the title, the infile, the counts printed with
+ *  %.17g, the image size and RCACHE_STYLE, which is to be bumped
+ *  whenever cellgram_draw() changes what it draws.
+ *
+ *  Hits touch their entry.  Once the directory holds more than
+ *  max_bytes, the least recently used entries are removed until it
+ *  is back under 90% of that.
+ *
+ *********************************************************************/
+
+#define RCACHE_STYLE      1
+
+struct render_cache {
+  char dir[4096];
+  long long max_bytes, bytes;
+  pthread_mutex_t lock;
+};
+
+struct rcache_entry {
+  char name[64];
+  long long size;
+  time_t mtime;
+};
+
+
+static unsigned long long rcache_hash (unsigned long long h, const void *p, int len) {
+  const unsigned char *s = p;
+
+  while (len--) {
+    h ^= *s++;
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+static void rcache_path (const struct render_cache *rc, const struct cellgram_job *job,
+                         char *path, int size) {
+  unsigned long long h = 14695981039346656037ULL;
+  char buf[256];
+  int n;
+
+  h = rcache_hash(h, job->title, strlen(job->title) + 1);
+  h = rcache_hash(h, job->infile, strlen(job->infile) + 1);
+  n = snprintf(buf, sizeof(buf), "%.17g %.17g %.17g %.17g %d %d %d",
+      job->nuclear, job->cytosolic, job->membrane, job->extracellular,
+      CELLGRAM_WIDTH, CELLGRAM_HEIGHT, RCACHE_STYLE);
+  h = rcache_hash(h, buf, n);
+  snprintf(path, size, "%s/%016llx.png", rc->dir, h);
+}
+
+static int copy_file (const char *from, const char *to) {
+  char buf[65536];
+  size_t n;
+  FILE *in, *out;
+  int bad = 0;
+
+  if ((in = fopen(from, "r")) == NULL)
+    return -1;
+  if ((out = fopen(to, "w")) == NULL) {
+    fclose(in);
+    return -1;
+  }
+  while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+    if (fwrite(buf, 1, n, out) != n)
+      bad = -1;
+  bad |= ferror(in) ? -1 : 0;
+  fclose(in);
+  if (fclose(out))
+    bad = -1;
+  return bad;
+}
+
+static int by_mtime (const void *a, const void *b) {
+  const struct rcache_entry *x = a, *y = b;
+
+  return (x->mtime > y->mtime) - (x->mtime < y->mtime);
+}
+
+static long long rcache_scan (struct render_cache *rc, int trim) {
+/*****************************************************************
+ *  The bytes in the cache; with trim, oldest entries removed
+ *  first until under 90% of max_bytes
+ *****************************************************************/
+  struct rcache_entry *e = NULL;
+  struct dirent *d;
+  struct stat sb;
+  char path[4200];
+  long long total = 0;
+  int n = 0, cap = 0, i, len;
+  DIR *dp;
+
+  if ((dp = opendir(rc->dir)) == NULL)
+    return 0;
+  while ((d = readdir(dp)) != NULL) {
+    len = strlen(d->d_name);
+    if ((len != 20) || strcmp(d->d_name + 16, ".png"))
+      continue;
+    snprintf(path, sizeof(path), "%s/%s", rc->dir, d->d_name);
+    if (stat(path, &sb) < 0)
+      continue;
+    if (n == cap) {
+      cap = cap ? 2*cap : 256;
+      e = realloc(e, cap*sizeof(struct rcache_entry));
+    }
+    strcpy(e[n].name, d->d_name);
+    e[n].size = sb.st_size;
+    e[n].mtime = sb.st_mtime;
+    total += sb.st_size;
+    n++;
+  }
+  closedir(dp);
+  if ((trim) && (total > rc->max_bytes)) {
+    qsort(e, n, sizeof(struct rcache_entry), by_mtime);
+    for (i=0;(i<n)&&(total > rc->max_bytes/10*9);i++) {
+      snprintf(path, sizeof(path), "%s/%s", rc->dir, e[i].name);
+      if (unlink(path) == 0)
+        total -= e[i].size;
+    }
+  }
+  free(e);
+  return total;
+} //----- rcache_scan -----//
+
+
+struct render_cache *rcache_open (const char *dir, long long max_bytes) {
+  struct render_cache *rc;
+
+  if ((mkdir(dir, 0755) < 0) && (access(dir, W_OK) < 0)) {
+    fprintf(stderr, "CAN'T USE RENDER CACHE: %s\n", dir);
+    return NULL;
+  }
+  rc = calloc(1, sizeof(struct render_cache));
+  snprintf(rc->dir, sizeof(rc->dir), "%s", dir);
+  rc->max_bytes = max_bytes;
+  pthread_mutex_init(&rc->lock, NULL);
+  rc->bytes = rcache_scan(rc, 1);
+  return rc;
+} //----- rcache_open -----//
+
+
+int rcache_get (struct render_cache *rc, const struct cellgram_job *job, const char *out) {
+/*****************************************************************
+ *  0 if job's image was cached and is now at out
+ *****************************************************************/
+  char path[4200];
+
+  rcache_path(rc, job, path, sizeof(path));
+  if (access(path, R_OK) < 0)
+    return -1;
+  if (copy_file(path, out) < 0)
+    return -1;
+  utimes(path, NULL);                /* recently used */
+  return 0;
+} //----- rcache_get -----//
+
+
+void rcache_put (struct render_cache *rc, const struct cellgram_job *job, const char *png) {
+/*****************************************************************
+ *  File the freshly rendered png under job's key
+ *****************************************************************/
+  char path[4200], tmp[4300];
+  struct stat sb;
+
+  rcache_path(rc, job, path, sizeof(path));
+  snprintf(tmp, sizeof(tmp), "%s.%d.%lx", path, (int)getpid(), (unsigned long)pthread_self());
+  if ((copy_file(png, tmp) < 0) || (stat(tmp, &sb) < 0) || (rename(tmp, path) < 0)) {
+    unlink(tmp);
+    return;
+  }
+  pthread_mutex_lock(&rc->lock);
+  if ((rc->bytes += sb.st_size) > rc->max_bytes)
+    rc->bytes = rcache_scan(rc, 1);
+  pthread_mutex_unlock(&rc->lock);
+} //----- rcache_put -----//
+
+
+void rcache_close (struct render_cache *rc) {
+  if (rc == NULL)
+    return;
+  pthread_mutex_destroy(&rc->lock);
+  free(rc);
+}
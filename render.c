@@ -0,0 +1,479 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <cairo.h>
+#include <cairo-pdf.h>
+#include <cairo-svg.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  RENDER -- many cellgrams in one call
+ *
+ *  cellgram_batch() takes an array of jobs, a title, an infile and
+ *  the four compartment counts each, and renders them on a pool of
+ *  threads that take the jobs in order.
+ *
+ *  A job with an out path is drawn by cellgram_draw() onto the
+ *  thread's own CELLGRAM_WIDTH x CELLGRAM_HEIGHT image surface,
+ *  which is created once, cleared between jobs and written with
+ *  cairo_surface_write_to_png(): no surface or context is set up
+ *  and torn down per diagram, and the threads share nothing but
+ *  the job counter.
+ *
+ *  A job without one goes to cellgram() itself, which names and
+ *  writes its own file.  cellgram() is not known to be reentrant,
+ *  so those calls are made one at a time.
+ *
+ *  With a render cache (rcache.c) an out job whose image is cached
+ *  is copied from the cache without drawing, and a drawn one is
+ *  added to it.
+ *
+ *  cellgram_render() is what the reports call: every diagram into
+ *  a book (below) if there is one, else a PNG each in a directory,
+ *  else cellgram()'s own files.
+ *
+ *********************************************************************/
+
+struct render_pool {
+  struct cellgram_job *jobs;
+  int n_jobs, next;
+  struct render_cache *rc;
+  pthread_mutex_t serial;            /* around cellgram() */
+};
+
+struct render_worker {
+  struct render_pool *rp;
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  pthread_t tid;
+};
+
+
+static int render_one (struct render_worker *w, struct cellgram_job *job) {
+  if (job->out == NULL) {
+    pthread_mutex_lock(&w->rp->serial);
+    cellgram(job->title, job->infile, job->nuclear, job->cytosolic,
+             job->membrane, job->extracellular);
+    pthread_mutex_unlock(&w->rp->serial);
+    return 0;
+  }
+  if ((w->rp->rc != NULL) && (rcache_get(w->rp->rc, job, job->out) == 0))
+    return 0;
+  if (w->surface == NULL) {
+    w->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                            CELLGRAM_WIDTH, CELLGRAM_HEIGHT);
+    w->cr = cairo_create(w->surface);
+  }
+  cairo_save(w->cr);
+  cairo_set_operator(w->cr, CAIRO_OPERATOR_CLEAR);
+  cairo_paint(w->cr);
+  cairo_restore(w->cr);
+
+  cairo_save(w->cr);
+  cellgram_draw(w->cr, CELLGRAM_WIDTH, CELLGRAM_HEIGHT, job->title, job->infile,
+                job->nuclear, job->cytosolic, job->membrane, job->extracellular);
+  cairo_restore(w->cr);
+  cairo_surface_flush(w->surface);
+  if (cairo_surface_write_to_png(w->surface, job->out) != CAIRO_STATUS_SUCCESS) {
+    fprintf(stderr, "CAN'T WRITE CELLGRAM: %s\n", job->out);
+    return -1;
+  }
+  if (w->rp->rc != NULL)
+    rcache_put(w->rp->rc, job, job->out);
+  return 0;
+} //----- render_one -----//
+
+
+static void * render_worker (void *arg) {
+  struct render_worker *w = arg;
+  struct render_pool *rp = w->rp;
+  int i;
+
+  while ((i = __atomic_fetch_add(&rp->next, 1, __ATOMIC_RELAXED)) < rp->n_jobs)
+    rp->jobs[i].status = render_one(w, &rp->jobs[i]);
+  if (w->surface != NULL) {
+    cairo_destroy(w->cr);
+    cairo_surface_destroy(w->surface);
+  }
+  return NULL;
+} //----- render_worker -----//
+
+
+int cellgram_batch (struct cellgram_job *jobs, int n_jobs, int n_threads,
+                    struct render_cache *rc) {
+/*****************************************************************
+ *  Render every job on up to n_threads threads, through rc unless
+ *  it is NULL.  Each job's status is 0 once its image is written;
+ *  returns -1 if any failed.
+ *****************************************************************/
+  struct render_pool rp;
+  struct render_worker *w;
+  int i, k, bad = 0;
+
+  if (n_threads > n_jobs)
+    n_threads = n_jobs;
+  if (n_threads < 1)
+    n_threads = 1;
+  memset(&rp, 0, sizeof(rp));
+  rp.jobs = jobs;
+  rp.n_jobs = n_jobs;
+  rp.rc = rc;
+  pthread_mutex_init(&rp.serial, NULL);
+  for (i=0;i<n_jobs;i++)
+    jobs[i].status = -1;
+
+  w = calloc(n_threads, sizeof(struct render_worker));
+  for (k=0;k<n_threads;k++)
+    w[k].rp = &rp;
+  if (n_threads == 1)
+    render_worker(&w[0]);
+  else {
+    for (k=0;k<n_threads;k++)
+      if (pthread_create(&w[k].tid, NULL, render_worker, &w[k])) {
+        fprintf(stderr, "CAN'T START RENDERING THREAD %d\n", k);
+        n_threads = k;
+        break;
+      }
+    for (k=0;k<n_threads;k++)
+      pthread_join(w[k].tid, NULL);
+    if (n_threads == 0)
+      render_worker(&w[0]);
+  }
+  free(w);
+  pthread_mutex_destroy(&rp.serial);
+
+  for (i=0;i<n_jobs;i++)
+    bad |= jobs[i].status;
+  return bad ? -1 : 0;
+} //----- cellgram_batch -----//
+
+
+int cellgram_render (struct cellgram_job *jobs, int n_jobs, const struct render_opts *r) {
+/*****************************************************************
+ *
+ *  The report's diagrams as r says: into r->book, or as
+ *  <dir>/<infile>.<title>.png (base name of the infile, any '/'
+ *  of the title as '_'), or by cellgram().  r may be NULL.
+ *
+ *****************************************************************/
+  char (*names)[512];
+  const char *base;
+  char *p;
+  int i, bad = 0;
+
+  if ((r != NULL) && (r->book != NULL)) {
+    for (i=0;i<n_jobs;i++)
+      bad |= cellgram_book_add(r->book, &jobs[i]);
+    return bad ? -1 : 0;
+  }
+  if ((r == NULL) || (r->dir == NULL))
+    return cellgram_batch(jobs, n_jobs, n_jobs, NULL);
+
+  names = malloc(n_jobs*sizeof(*names));
+  for (i=0;i<n_jobs;i++) {
+    base = strrchr(jobs[i].infile, '/') ? strrchr(jobs[i].infile, '/') + 1 : jobs[i].infile;
+    snprintf(names[i], sizeof(names[i]), "%s/%s.%s.png", r->dir, base, jobs[i].title);
+    for (p=names[i]+strlen(r->dir)+1;*p;p++)
+      if (*p == '/')
+        *p = '_';
+    jobs[i].out = names[i];
+  }
+  bad = cellgram_batch(jobs, n_jobs, r->n_threads, r->rc);
+  for (i=0;i<n_jobs;i++)
+    jobs[i].out = NULL;
+  free(names);
+  return bad;
+} //----- cellgram_render -----//
+
+
+/*********************************************************************
+ *
+ *  BOOKS -- many cellgrams in one file
+ *
+ *  cellgram_book_open("out.pdf") starts a multi-page PDF with one
+ *  diagram per page; any other path is the stem of a PNG atlas:
+ *  sheets <stem>-0000.png, <stem>-0001.png, ... of ATLAS_COLUMNS x
+ *  ATLAS_ROWS tiles at half size, and <stem>.json listing, for each
+ *  diagram in order, its title, infile, counts, sheet and the tile
+ *  offset within it.
+ *
+ *  Both are streamed: a PDF page is emitted by cairo_show_page()
+ *  as soon as it is drawn, and an atlas sheet is written as soon as
+ *  its last tile is, then reused, so memory holds one page or one
+ *  sheet whatever the number of diagrams.  The manifest is written
+ *  as entries are added.
+ *
+ *********************************************************************/
+
+#define ATLAS_COLUMNS     8
+#define ATLAS_ROWS        8
+#define TILE_WIDTH        (CELLGRAM_WIDTH/2)
+#define TILE_HEIGHT       (CELLGRAM_HEIGHT/2)
+
+struct cellgram_book {
+  int pdf;
+  char stem[4096];
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  FILE *manifest;                    /* atlas only */
+  int n, sheet, tile;                /* diagrams, current sheet, next tile on it */
+  int bad;
+};
+
+
+static void manifest_string (FILE *fp, const char *s) {
+/*****************************************************************
+ *  As json_string(), which would pull summary.c into stub
+ *****************************************************************/
+  fputc('"', fp);
+  for (;*s;s++)
+    if ((*s == '"') || (*s == '\\'))
+      fprintf(fp, "\\%c", *s);
+    else if ((unsigned char)*s < ' ')
+      fprintf(fp, "\\u%04x", *s);
+    else
+      fputc(*s, fp);
+  fputc('"', fp);
+}
+
+static int book_sheet_name (const struct cellgram_book *bk, int sheet, char *name, int size) {
+  return snprintf(name, size, "%s-%04d.png", bk->stem, sheet);
+}
+
+static int book_flush_sheet (struct cellgram_book *bk) {
+/*****************************************************************
+ *  Write the atlas sheet in progress, if any tile is on it
+ *****************************************************************/
+  char name[4200];
+
+  if (bk->tile == 0)
+    return 0;
+  book_sheet_name(bk, bk->sheet, name, sizeof(name));
+  cairo_surface_flush(bk->surface);
+  if (cairo_surface_write_to_png(bk->surface, name) != CAIRO_STATUS_SUCCESS) {
+    fprintf(stderr, "CAN'T WRITE ATLAS SHEET: %s\n", name);
+    return -1;
+  }
+  cairo_save(bk->cr);
+  cairo_set_operator(bk->cr, CAIRO_OPERATOR_CLEAR);
+  cairo_paint(bk->cr);
+  cairo_restore(bk->cr);
+  bk->sheet++;
+  bk->tile = 0;
+  return 0;
+} //----- book_flush_sheet -----//
+
+
+struct cellgram_book *cellgram_book_open (const char *path) {
+  struct cellgram_book *bk = calloc(1, sizeof(struct cellgram_book));
+  char name[4200];
+  int len = strlen(path);
+
+  bk->pdf = (len > 4) && (!strcmp(path + len - 4, ".pdf"));
+  if (bk->pdf) {
+    bk->surface = cairo_pdf_surface_create(path, CELLGRAM_WIDTH, CELLGRAM_HEIGHT);
+  }
+  else {
+    snprintf(bk->stem, sizeof(bk->stem), "%s", path);
+    if ((len > 4) && (!strcmp(bk->stem + len - 4, ".png")))
+      bk->stem[len - 4] = '\0';
+    snprintf(name, sizeof(name), "%s.json", bk->stem);
+    if ((bk->manifest = fopen(name, "w")) == NULL) {
+      fprintf(stderr, "CAN'T OPEN ATLAS MANIFEST: %s\n", name);
+      free(bk);
+      return NULL;
+    }
+    fprintf(bk->manifest, "{\n  \"tile_width\": %d,\n  \"tile_height\": %d,\n"
+        "  \"columns\": %d,\n  \"rows\": %d,\n  \"cellgrams\": [",
+        TILE_WIDTH, TILE_HEIGHT, ATLAS_COLUMNS, ATLAS_ROWS);
+    bk->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+        ATLAS_COLUMNS*TILE_WIDTH, ATLAS_ROWS*TILE_HEIGHT);
+  }
+  if (cairo_surface_status(bk->surface) != CAIRO_STATUS_SUCCESS) {
+    fprintf(stderr, "CAN'T OPEN CELLGRAM BOOK: %s\n", path);
+    cairo_surface_destroy(bk->surface);
+    if (bk->manifest != NULL)
+      fclose(bk->manifest);
+    free(bk);
+    return NULL;
+  }
+  bk->cr = cairo_create(bk->surface);
+  return bk;
+} //----- cellgram_book_open -----//
+
+
+int cellgram_book_add (struct cellgram_book *bk, const struct cellgram_job *job) {
+/*****************************************************************
+ *  The next page or tile.  job->out is not used.
+ *****************************************************************/
+  char name[4200], *sheet;
+  int x, y;
+
+  if (bk->pdf) {
+    cellgram_draw(bk->cr, CELLGRAM_WIDTH, CELLGRAM_HEIGHT, job->title, job->infile,
+                  job->nuclear, job->cytosolic, job->membrane, job->extracellular);
+    cairo_show_page(bk->cr);
+    bk->n++;
+    return 0;
+  }
+
+  x = (bk->tile % ATLAS_COLUMNS)*TILE_WIDTH;
+  y = (bk->tile / ATLAS_COLUMNS)*TILE_HEIGHT;
+  cairo_save(bk->cr);
+  cairo_translate(bk->cr, x, y);
+  cairo_rectangle(bk->cr, 0, 0, TILE_WIDTH, TILE_HEIGHT);
+  cairo_clip(bk->cr);
+  cellgram_draw(bk->cr, TILE_WIDTH, TILE_HEIGHT, job->title, job->infile,
+                job->nuclear, job->cytosolic, job->membrane, job->extracellular);
+  cairo_restore(bk->cr);
+
+  book_sheet_name(bk, bk->sheet, name, sizeof(name));
+  sheet = strrchr(name, '/') ? strrchr(name, '/') + 1 : name;   /* beside the manifest */
+  fprintf(bk->manifest, "%s\n    {\"title\": ", bk->n ? "," : "");
+  manifest_string(bk->manifest, job->title);
+  fprintf(bk->manifest, ", \"infile\": ");
+  manifest_string(bk->manifest, job->infile);
+  fprintf(bk->manifest, ", \"nuclear\": %.0f, \"cytosolic\": %.0f, \"membrane\": %.0f,"
+      " \"extracellular\": %.0f, \"sheet\": ", job->nuclear, job->cytosolic,
+      job->membrane, job->extracellular);
+  manifest_string(bk->manifest, sheet);
+  fprintf(bk->manifest, ", \"x\": %d, \"y\": %d}", x, y);
+  bk->n++;
+
+  if (++bk->tile == ATLAS_COLUMNS*ATLAS_ROWS)
+    bk->bad |= book_flush_sheet(bk);
+  return bk->bad;
+} //----- cellgram_book_add -----//
+
+
+int cellgram_book_close (struct cellgram_book *bk) {
+  int bad;
+
+  if (bk == NULL)
+    return 0;
+  if (!bk->pdf) {
+    bk->bad |= book_flush_sheet(bk);
+    fprintf(bk->manifest, "%s]\n}\n", bk->n ? "\n  " : "");
+    bk->bad |= ferror(bk->manifest) | fclose(bk->manifest);
+  }
+  cairo_destroy(bk->cr);
+  if (bk->pdf)
+    cairo_surface_finish(bk->surface);
+  cairo_surface_destroy(bk->surface);
+  bad = bk->bad;
+  free(bk);
+  return bad ? -1 : 0;
+} //----- cellgram_book_close -----//
+
+
+/*********************************************************************
+ *
+ *  ENCODE -- a cellgram as PNG or SVG bytes in memory
+ *
+ *  cellgram_encode() draws one job with cellgram_draw() and hands
+ *  the encoded image to Cairo's stream writers, which append it to
+ *  a struct cellgram_buf: nothing touches the filesystem, so a
+ *  long-running process can serve diagrams as it makes them.
+ *
+ *  The buffer is either the caller's (fixed: data and cap set, and
+ *  the encode fails rather than grow it) or grown here with
+ *  realloc() and released with cellgram_buf_free().  A buffer can
+ *  be reused across calls; len is reset each time.
+ *
+ *********************************************************************/
+
+static cairo_status_t encode_write (void *closure, const unsigned char *data,
+                                    unsigned int length) {
+  struct cellgram_buf *buf = closure;
+  unsigned char *grown;
+  size_t cap;
+
+  if (buf->len + length > buf->cap) {
+    if (buf->fixed)
+      return CAIRO_STATUS_WRITE_ERROR;
+    for (cap=buf->cap ? buf->cap : 16384;cap<buf->len+length;cap*=2)
+      ;
+    if ((grown = realloc(buf->data, cap)) == NULL)
+      return CAIRO_STATUS_WRITE_ERROR;
+    buf->data = grown;
+    buf->cap = cap;
+  }
+  memcpy(buf->data + buf->len, data, length);
+  buf->len += length;
+  return CAIRO_STATUS_SUCCESS;
+} //----- encode_write -----//
+
+
+int cellgram_encode (const struct cellgram_job *job, int format, struct cellgram_buf *buf) {
+/*****************************************************************
+ *  job's diagram (its out is ignored) into buf as CELLGRAM_PNG or
+ *  CELLGRAM_SVG.  Returns 0, or -1 with buf->len 0 if it could
+ *  not be encoded or a fixed buffer was too small.
+ *****************************************************************/
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  cairo_status_t status;
+
+  buf->len = 0;
+  if (format == CELLGRAM_SVG)
+    surface = cairo_svg_surface_create_for_stream(encode_write, buf,
+                                                  CELLGRAM_WIDTH, CELLGRAM_HEIGHT);
+  else
+    surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                         CELLGRAM_WIDTH, CELLGRAM_HEIGHT);
+  cr = cairo_create(surface);
+  cellgram_draw(cr, CELLGRAM_WIDTH, CELLGRAM_HEIGHT, job->title, job->infile,
+                job->nuclear, job->cytosolic, job->membrane, job->extracellular);
+  cairo_destroy(cr);
+
+  if (format == CELLGRAM_SVG) {
+    cairo_surface_finish(surface);    /* the SVG is written here */
+    status = cairo_surface_status(surface);
+  }
+  else {
+    cairo_surface_flush(surface);
+    status = cairo_surface_write_to_png_stream(surface, encode_write, buf);
+  }
+  cairo_surface_destroy(surface);
+  if (status != CAIRO_STATUS_SUCCESS) {
+    buf->len = 0;
+    return -1;
+  }
+  return 0;
+} //----- cellgram_encode -----//
+
+
+void cellgram_buf_free (struct cellgram_buf *buf) {
+  if (!buf->fixed)
+    free(buf->data);
+  buf->data = NULL;
+  buf->len = buf->cap = 0;
+} //----- cellgram_buf_free -----//
@@ -0,0 +1,355 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include "promog.h"
+
+#define STDOUT 1
+
+/*********************************************************************
+ *
+ *  SAMPLE -- approximate counts from a random sample of the file
+ *
+ *  promog --sample=<fraction> cuts the datafile into windows of
+ *  --sample-window bytes (1M by default), reads a random <fraction>
+ *  of them and counts the entries that START in each one, seeking
+ *  to the first entry at or after the window (snap_to_record()) and
+ *  reading on past its end only to finish the last entry.  Every
+ *  entry starts in exactly one window, so the windows are clusters
+ *  of a simple random sample without replacement, and each counter
+ *  of the report is estimated as
+ *
+ *     T = W * mean(y),   se(T) = W * sqrt((1 - m/W) * var(y) / m)
+ *
+ *  for W windows, m of them read, y the counter in one window, with
+ *  T +/- 1.96 se as the 95% interval.  --sample-error=<rel> stops
+ *  early once the interval on the total protein count is within
+ *  <rel> of it (after at least MIN_WINDOWS windows); --seed picks
+ *  the windows, and the same seed and fraction always read the
+ *  same ones.
+ *
+ *  The windows are taken in a shuffled order by -j workers, each
+ *  with its own descriptor, rules and buffers.  Cellgrams are drawn
+ *  from the estimates.
+ *
+ *********************************************************************/
+
+#define MIN_WINDOWS       30
+#define Z_95              1.959964
+#define TOTAL_PROTEINS    (1*(REPORT_MEASURES+1) + M_PROTEINS)   /* the "total" group */
+
+struct sample {
+  const struct sample_opts *o;
+  const char *path;
+  long long size;
+  int n_windows, n_take;
+  int *order;                        /* shuffled window numbers */
+  int next, taken, stop, bad;
+  int n_values;
+  double *s, *ss;                    /* sums and sums of squares of y */
+  long long proteins;
+  pthread_mutex_t lock;
+};
+
+struct sample_worker {
+  struct sample *sp;
+  int fd;
+  struct promog_rules rules;
+  char *block, *line;
+  long long *y;
+  struct metrics met;
+  pthread_t tid;
+};
+
+
+/*********************************************************************
+ *  splitmix64, for the shuffle
+ *********************************************************************/
+static unsigned long long next_rand (unsigned long long *s) {
+  unsigned long long z = (*s += 0x9E3779B97F4A7C15ULL);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+
+static void sample_estimate (const struct sample *sp, int i, double *est, double *se) {
+  double m = sp->taken, w = sp->n_windows, mean, var;
+
+  if (m < 1) {
+    *est = *se = 0;
+    return;
+  }
+  mean = sp->s[i]/m;
+  *est = w*mean;
+  var = (m > 1) ? (sp->ss[i] - m*mean*mean)/(m - 1) : 0;
+  if (var < 0)
+    var = 0;
+  *se = w*sqrt((1 - m/w)*var/m);
+} //----- sample_estimate -----//
+
+
+static void * sample_worker (void *arg) {
+  struct sample_worker *w = arg;
+  struct sample *sp = w->sp;
+  const struct sample_opts *o = sp->o;
+  struct scan_state st;
+  struct crosstab *cube;
+  struct promog_summary one;
+  double est, se;
+  int i, k;
+
+  for (;;) {
+    pthread_mutex_lock(&sp->lock);
+    if ((sp->stop) || (sp->next >= sp->n_take)) {
+      pthread_mutex_unlock(&sp->lock);
+      break;
+    }
+    k = sp->order[sp->next++];
+    pthread_mutex_unlock(&sp->lock);
+
+    memset(&st, 0, sizeof(st));
+    st.fd = w->fd;
+    st.start = snap_to_record(w->fd, k*o->window);
+    st.end = (k == sp->n_windows - 1) ? LLONG_MAX : (k + 1)*o->window;
+    st.origin = st.start;
+    st.blocksize = o->blocksize;
+    st.block = w->block;
+    st.line = w->line;
+    st.rules = &w->rules;
+    st.met = &w->met;
+    cube = crosstab_new(o->spec);
+    st.n_cubes = 1;
+    st.cubes = &cube;
+    scan_range(&st);
+    memset(&one, 0, sizeof(one));
+    one.report = cube;
+    summary_values(&one, w->y);
+    crosstab_free(cube);
+
+    pthread_mutex_lock(&sp->lock);
+    for (i=0;i<sp->n_values;i++) {
+      sp->s[i] += w->y[i];
+      sp->ss[i] += (double)w->y[i]*w->y[i];
+    }
+    sp->taken++;
+    sp->proteins += st.tot_proteins;
+    if ((o->max_error > 0) && (sp->taken >= MIN_WINDOWS)) {
+      sample_estimate(sp, TOTAL_PROTEINS, &est, &se);
+      if (Z_95*se <= o->max_error*est)
+        sp->stop = 1;
+    }
+    pthread_mutex_unlock(&sp->lock);
+  }
+  return NULL;
+} //----- sample_worker -----//
+
+
+static void sample_print (const struct sample *sp, double sec, int format, FILE *fp) {
+  const struct sample_opts *o = sp->o;
+  const char *group;
+  char name[128];
+  double est, se;
+  int i;
+
+  if (format == FORMAT_JSON) {
+    fprintf(fp, "{\n  \"datafile\": ");
+    json_string(fp, sp->path);
+    fprintf(fp, ",\n  \"windows\": %d,\n  \"windows_total\": %d,\n"
+        "  \"window_bytes\": %lld,\n  \"seed\": %llu,\n  \"confidence\": 0.95,\n"
+        "  \"sample_proteins\": %lld,\n  \"elapsed_sec\": %.6f,\n  \"groups\": {",
+        sp->taken, sp->n_windows, o->window, o->seed, sp->proteins, sec);
+    for (i=0;i<sp->n_values;i++) {
+      summary_value_name(i, &group, name, sizeof(name));
+      sample_estimate(sp, i, &est, &se);
+      if (i%(REPORT_MEASURES+1) == 0)
+        fprintf(fp, "%s\n    \"%s\": {", i ? "\n    }," : "", group);
+      fprintf(fp, "%s\n      ", (i%(REPORT_MEASURES+1)) ? "," : "");
+      json_string(fp, name);
+      fprintf(fp, ": {\"estimate\": %.0f, \"stderr\": %.1f, \"ci_low\": %.0f, \"ci_high\": %.0f}",
+          est, se, est - Z_95*se, est + Z_95*se);
+    }
+    fprintf(fp, "\n    }\n  }\n}\n");
+    return;
+  }
+  if (format == FORMAT_TSV) {
+    fprintf(fp, "group\tmeasure\testimate\tstderr\tci_low\tci_high\n");
+    fprintf(fp, "run\tdatafile\t%s\n", sp->path);
+    fprintf(fp, "run\twindows\t%d\n", sp->taken);
+    fprintf(fp, "run\twindows_total\t%d\n", sp->n_windows);
+    fprintf(fp, "run\twindow_bytes\t%lld\n", o->window);
+    fprintf(fp, "run\tseed\t%llu\n", o->seed);
+    fprintf(fp, "run\tsample_proteins\t%lld\n", sp->proteins);
+    fprintf(fp, "run\telapsed_sec\t%.6f\n", sec);
+    for (i=0;i<sp->n_values;i++) {
+      summary_value_name(i, &group, name, sizeof(name));
+      sample_estimate(sp, i, &est, &se);
+      fprintf(fp, "%s\t%s\t%.0f\t%.1f\t%.0f\t%.0f\n", group, name, est, se,
+          est - Z_95*se, est + Z_95*se);
+    }
+    return;
+  }
+  fprintf(fp, "--------SAMPLE ESTIMATES--------------------\n");
+  fprintf(fp, "datafile: %s\n", sp->path);
+  fprintf(fp, "sampled %d of %d windows of %lld bytes (%.2f%%), seed %llu\n",
+      sp->taken, sp->n_windows, o->window,
+      sp->n_windows ? 100.0*sp->taken/sp->n_windows : 0.0, o->seed);
+  fprintf(fp, "%lld proteins in the sample, intervals at 95%% confidence\n", sp->proteins);
+  for (i=0;i<sp->n_values;i++) {
+    summary_value_name(i, &group, name, sizeof(name));
+    sample_estimate(sp, i, &est, &se);
+    fprintf(fp, "%s %s: %.0f +/- %.0f", group, name, est, Z_95*se);
+    if (est > 0)
+      fprintf(fp, " (%.2f%%)", 100*Z_95*se/est);
+    fprintf(fp, "\n");
+  }
+  fprintf(fp, "it took %.3f sec to run.\n", sec);
+} //----- sample_print -----//
+
+
+int sample_run (const char *path, long long size, const struct sample_opts *o) {
+/*****************************************************************
+ *  Estimate, print and draw.  0, or -1 if the file could not be
+ *  opened or a worker started.
+ *****************************************************************/
+  const int MAXLINE  = getpagesize();
+  struct sample sp;
+  struct sample_worker *w;
+  struct timespec t_begin, t_end;
+  unsigned long long seed = o->seed;
+  struct cellgram_job *jobs;
+  double se;
+  const char *group;
+  char name[128];
+  int i, j, k, g, t;
+
+  memset(&sp, 0, sizeof(sp));
+  sp.o = o;
+  sp.path = path;
+  sp.size = size;
+  pthread_mutex_init(&sp.lock, NULL);
+
+  metrics_begin(o->met, MX_SETUP);
+  sp.n_windows = (size + o->window - 1)/o->window;
+  sp.n_take = ceil(o->fraction*sp.n_windows);
+  if (sp.n_take < MIN_WINDOWS)
+    sp.n_take = MIN_WINDOWS;
+  if (sp.n_take > sp.n_windows)
+    sp.n_take = sp.n_windows;
+  sp.order = malloc((sp.n_windows + 1)*sizeof(int));
+  for (i=0;i<sp.n_windows;i++)
+    sp.order[i] = i;
+  for (i=0;i<sp.n_take;i++) {
+    /*  the first n_take of a Fisher-Yates shuffle  */
+    j = i + next_rand(&seed) % (sp.n_windows - i);
+    t = sp.order[i];
+    sp.order[i] = sp.order[j];
+    sp.order[j] = t;
+  }
+  sp.n_values = summary_values(NULL, NULL);
+  sp.s = calloc(sp.n_values, sizeof(double));
+  sp.ss = calloc(sp.n_values, sizeof(double));
+
+  w = calloc(o->n_threads, sizeof(struct sample_worker));
+  for (k=0;k<o->n_threads;k++) {
+    w[k].sp = &sp;
+    if ((w[k].fd = open(path, O_RDONLY)) < 0) {
+      fprintf(stderr, "CAN'T OPEN FILE: %s\n", path);
+      return -1;
+    }
+    if (compile_rules(&w[k].rules))
+      return -1;
+    w[k].rules.seq = o->seq;
+    w[k].block = valloc(o->blocksize);
+    w[k].line = malloc((MAXLINE+2)*sizeof(char));
+    w[k].y = malloc(sp.n_values*sizeof(long long));
+    metrics_init(&w[k].met);
+  }
+  metrics_end(o->met, MX_SETUP);
+
+  clock_gettime(CLOCK_MONOTONIC, &t_begin);
+  metrics_begin(o->met, MX_SCAN);
+  for (k=0;k<o->n_threads;k++)
+    if (pthread_create(&w[k].tid, NULL, sample_worker, &w[k])) {
+      fprintf(stderr, "CAN'T START SCANNING THREAD %d\n", k);
+      return -1;
+    }
+  for (k=0;k<o->n_threads;k++)
+    pthread_join(w[k].tid, NULL);
+  metrics_end(o->met, MX_SCAN);
+  clock_gettime(CLOCK_MONOTONIC, &t_end);
+  for (k=0;k<o->n_threads;k++)
+    metrics_merge(o->met, &w[k].met);
+  o->met->ph[MX_SCAN].bytes = o->met->ph[MX_READ].bytes;
+  o->met->ph[MX_SCAN].records = sp.proteins;
+
+  metrics_begin(o->met, MX_OUTPUT);
+  sample_print(&sp, (t_end.tv_sec - t_begin.tv_sec) + (t_end.tv_nsec - t_begin.tv_nsec)/1e9,
+      o->format, stdout);
+  fflush(stdout);
+  metrics_end(o->met, MX_OUTPUT);
+
+  /*****************************************************************
+   *  Cellgrams of the estimated nuclear, cytosolic, net membrane
+   *  and extracellular counts of each group
+   *****************************************************************/
+  metrics_begin(o->met, MX_RENDER);
+  jobs = calloc(sp.n_values/(REPORT_MEASURES+1), sizeof(struct cellgram_job));
+  for (i=0,g=0;i<sp.n_values;i+=REPORT_MEASURES+1,g++) {
+    summary_value_name(i, &group, name, sizeof(name));
+    jobs[g].title = (char *)group;
+    jobs[g].infile = (char *)path;
+    sample_estimate(&sp, i + M_NUCLEAR, &jobs[g].nuclear, &se);
+    sample_estimate(&sp, i + M_CYTOSOLIC, &jobs[g].cytosolic, &se);
+    sample_estimate(&sp, i + REPORT_MEASURES, &jobs[g].membrane, &se);
+    sample_estimate(&sp, i + M_EXTRACELLULAR, &jobs[g].extracellular, &se);
+  }
+  cellgram_render(jobs, g, o->render);
+  free(jobs);
+  metrics_end(o->met, MX_RENDER);
+
+  for (k=0;k<o->n_threads;k++) {
+    close(w[k].fd);
+    free_rules(&w[k].rules);
+    free(w[k].block);
+    free(w[k].line);
+    free(w[k].y);
+  }
+  free(w);
+  free(sp.order);
+  free(sp.s);
+  free(sp.ss);
+  return 0;
+} //----- sample_run -----//
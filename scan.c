@@ -0,0 +1,332 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <regex.h>
+#include <sys/types.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  SCAN -- the block reader of promog
+ *
+ *  scan_range() walks the entries whose // terminator lies in one
+ *  byte range of the datafile, classifies their lines (classify.c)
+ *  and adds every finished protein to the scanner's cubes and index.  main() runs one of these per
+ *  thread over ranges cut by snap_to_record().
+ *
+ *********************************************************************/
+
+long long snap_to_record (int fd, long long offset) {
+/*****************************************************************
+ *
+ *  First entry start at or after offset: the byte just past a
+ *  "//" terminator line.  Offset 0 is the start of the first
+ *  entry; the file size is returned when no entry follows.
+ *
+ *****************************************************************/
+  const int CHUNK = 1<<16;
+  char *buf;
+  long long pos, q;
+  int n, i;
+
+  if (offset <= 0)
+    return 0;
+  buf = malloc(CHUNK);
+  pos = (offset > 4) ? offset - 4 : 0;
+  for (;;) {
+    if ((n = pread(fd, buf, CHUNK, (off_t) pos)) <= 0)
+      break;
+    for (i=0;i+2<n;i++) {
+      q = pos + i;
+      if ((buf[i] == '/')&&(buf[i+1] == '/')&&(buf[i+2] == '\n')&&
+          ((q == 0)||((i > 0) && (buf[i-1] == '\n'))) && (q + 3 >= offset)) {
+        free(buf);
+        return q + 3;
+      }
+    }
+    if (n < CHUNK)
+      break;
+    pos += n - 3;           /* keep "\n//" whole across the seam */
+  }
+  free(buf);
+  pos = lseek(fd, 0, SEEK_END);
+  return pos;
+} //----- snap_to_record (int fd, long long offset) -----//
+
+
+static int scan_read (struct scan_state *st, struct metrics *met, char *block, int n,
+                      long long offset) {
+/*****************************************************************
+ *  read(), with the wait charged to the read phase and the
+ *  position published for progress.c
+ *****************************************************************/
+  unsigned long long t = metrics_ticks();
+  int got = read(st->fd, block, n);
+
+  met->ph[MX_READ].ticks += metrics_ticks() - t;
+  if (got > 0) {
+    met->ph[MX_READ].bytes += got;
+    /*  for the progress thread: two relaxed stores per block  */
+    __atomic_store_n(&st->progress_bytes, offset + got - st->origin, __ATOMIC_RELAXED);
+    __atomic_store_n(&st->progress_records, st->tot_proteins, __ATOMIC_RELAXED);
+  }
+  return got;
+}
+
+
+void scan_range (struct scan_state *st) {
+/*****************************************************************
+ *
+ *   Data parameterization: 
+ *
+ *    blocksize chunks of the files are removed as this_seek
+ *     is incremented by that amount in the outer  while
+ *     loop with termination on read failure.  The next
+ *     level of while loop iterates on a variable line_begin,
+ *     which must be less than blocksize. This index steps
+ *     through the currently examined block by leaps determined
+ *     by an iterator b that checks for newline. 
+ *
+ *    The scan starts at st->start, which is the first byte of an
+ *    entry, and stops after the entry whose successor would start
+ *    at or past st->end.
+ *
+ *****************************************************************/
+  const int MAXLINE  = getpagesize();
+  const int  FALSE   = 0;
+  const int  TRUE =  1;
+  const int BLOCKSIZE = st->blocksize;
+  struct prot_record *rec = &st->rec;
+  struct promog_rules *rules = st->rules;
+  char *block = st->block, *line = st->line;
+  int m[MEASURE_COUNT];
+  int b, k, got_EOL, wrap_SHIFT, done, block_done, bytes_read;
+  int n_prot_lines = 0, this_prot_chars = 0;
+  long long this_seek, line_begin, status;
+  struct metrics scratch, *met = st->met;
+  unsigned long long t, t_range, busy0, busy;
+  long long bytes0, lines0;
+
+  if (met == NULL) {
+    metrics_init(&scratch);
+    met = &scratch;
+  }
+  t_range = metrics_ticks();
+  busy0 = met->ph[MX_READ].ticks + met->ph[MX_MATCH].ticks + met->ph[MX_AGGREGATE].ticks;
+  bytes0 = met->ph[MX_READ].bytes;
+  lines0 = st->line_num;
+
+  rec->ordinal = 0;
+  arena_init(&rec->arena, ARENA_BLOCK);
+  reset_record(rec);
+  this_seek = st->start;
+  line_begin = 0;
+  done = FALSE; 
+  block_done = FALSE; 
+
+  if ((lseek(st->fd, (off_t) this_seek, SEEK_SET))<0)
+    done = TRUE;  
+  if (st->start >= st->end)
+    done = TRUE;
+
+/*********************************************************************
+ *   this_seek--ing BLOCKSIZE steps
+ *********************************************************************/
+  if ((!done) && ((bytes_read = scan_read(st, met, block, BLOCKSIZE, this_seek)) <= 0))
+    done = TRUE;
+  while (!done)  {
+   /*****************************************************************
+    *   hopping line by line through one block
+    *   block_done indicates data in block has been exhausted. 
+    *
+    *****************************************************************/
+    block_done =  FALSE;
+    while (!block_done) {
+       
+      b=0;
+      /**************************************************************
+       *  finding next line_begin with b 
+       **************************************************************/
+      got_EOL =  FALSE;
+      while (!got_EOL) { 
+           if (line_begin == bytes_read) {
+             this_seek += BLOCKSIZE;
+             if ((status= (lseek(st->fd, (off_t) this_seek, SEEK_SET)) < 0)) {
+               done = TRUE;  
+               got_EOL = TRUE;
+               block_done = TRUE;
+               break;
+             }
+             if ((bytes_read = scan_read(st, met, block, BLOCKSIZE, this_seek)) <= 0)  {
+               got_EOL = TRUE;
+               block_done = TRUE;
+               done = TRUE;
+               break;
+             }
+             else
+               line_begin = 0;
+             }
+           b++; 
+           if (line_begin + b >= bytes_read) {
+           /**************************************************************
+            *  this line has wrapped accross a block.
+            *  shift the file pointer so that the beginning of the line
+            *  is the beginning of the new block.
+            **************************************************************/
+             if (bytes_read  < BLOCKSIZE) {
+               /**************************************************************
+                *  If bytes_read is less than BLOCKSIZE, this should imply
+                *  that we are reading the last block of the infile.  Therefore,
+                *  all loops should end.  In the event the file does not terminate
+                *  correctly, the corrupt_infile flag is set. 
+                **************************************************************/
+               if (block[bytes_read-1] != '\n' )
+                 st->corrupt_infile = TRUE; 
+               got_EOL = TRUE;
+               block_done = TRUE;
+               done = TRUE;
+               break;
+             }
+             wrap_SHIFT = b;
+             this_seek += BLOCKSIZE - wrap_SHIFT;
+             if ((status= (lseek(st->fd, (off_t) this_seek, SEEK_SET)) < 0))
+               done = TRUE;  
+             line_begin = 0;
+           if ((bytes_read = scan_read(st, met, block, BLOCKSIZE, this_seek)) <= 0)  {
+         /**************************************************************
+          *
+          *  there is no more file to read--end all loops.
+          *
+          **************************************************************/
+             got_EOL = TRUE;
+             block_done = TRUE;
+             done = TRUE;
+           }
+         }// if (line_begin + b == bytes_read) {
+
+         if ( block[line_begin + b ] == '\n')  {
+           n_prot_lines++;
+           st->char_count += b;
+           this_prot_chars += b;
+           got_EOL = TRUE;
+         }
+         if ( b == MAXLINE) {
+           b -= 2;
+           got_EOL = TRUE;
+         }//----- if ( b == MAXLINE) -----// 
+      }//----- while (!got_EOL) -----// 
+
+      /* a read past EOF before any byte of a new line is not a line */
+      if ((line_begin == bytes_read) || ((bytes_read <= 0) && (b == 0)))
+        break;
+      if ( b > st->max_line)
+          st->max_line = b;  
+      if (line_begin != bytes_read)
+         st->line_num++;
+
+      if ((block[line_begin] == '/')&&(block[line_begin+1] == '/')) {
+    /*****************************************************************
+     *  END OF RECORD
+     *****************************************************************/
+        st->tot_proteins++;
+        if ( n_prot_lines > st->max_prot_lines)
+          st->max_prot_lines = n_prot_lines;
+        if (this_prot_chars > st->max_prot_chars)
+          st->max_prot_chars = this_prot_chars;
+        classify_end(rec);
+
+        t = metrics_ticks();
+        record_measures(rec, m);
+        for (k=0;k<st->n_cubes;k++)
+          crosstab_add(st->cubes[k], rec, m);
+        if (st->ix != NULL)
+          pindex_add(st->ix, rec);
+        if (st->pl != NULL)
+          plist_add(st->pl, rec);
+        if (st->cx != NULL)
+          colx_add(st->cx, rec);
+        met->ph[MX_AGGREGATE].ticks += metrics_ticks() - t;
+        met->ph[MX_AGGREGATE].records++;
+
+    /*****************************************************************
+     *   RESET this protein data
+     *****************************************************************/
+        n_prot_lines = 0;
+        this_prot_chars= 0;
+        rec->ordinal++;
+        reset_record(rec);
+
+        if ((st->ckpt != NULL) && (--st->ckpt_countdown <= 0))
+          checkpoint_due(st, this_seek + line_begin + b + 1);
+        if (this_seek + line_begin + b + 1 >= st->end) {
+          /*  the next entry belongs to the following range  */
+          done = TRUE;
+          break;
+        }
+      }// ---if ((block[line_begin] == '/')&&(block[line_begin+1] == '/'))---// 
+
+    /*****************************************************************
+     *  Done with End Record processing 
+     *****************************************************************/
+
+      classify_line(rec, rules, &block[line_begin], b, line, met);
+
+        line_begin += b + 1;
+        if (line_begin >= bytes_read) {
+          block_done = TRUE;
+        }
+
+      }//----- while (!block_done)-----// 
+
+    /*****************************************************************
+     * wrap up flip
+     *****************************************************************/
+    if (done)
+      break;
+    if (line_begin != bytes_read)
+      this_seek += BLOCKSIZE;
+    block_done = FALSE;
+    lseek(st->fd, (off_t) this_seek, SEEK_SET);  
+    
+  }//----- while (!done) -----// 
+
+  /*  whatever was not reading, matching or aggregating was splitting  */
+  t = metrics_ticks() - t_range;
+  busy = met->ph[MX_READ].ticks + met->ph[MX_MATCH].ticks + met->ph[MX_AGGREGATE].ticks
+         - busy0;
+  met->ph[MX_SPLIT].ticks += (t > busy) ? t - busy : 0;
+  met->ph[MX_SPLIT].bytes += met->ph[MX_READ].bytes - bytes0;
+  met->ph[MX_SPLIT].lines += st->line_num - lines0;
+  __atomic_store_n(&st->progress_records, st->tot_proteins, __ATOMIC_RELAXED);
+  arena_free(&rec->arena);
+  if (st->ckpt != NULL)
+    checkpoint_done(st);
+} //----- scan_range (struct scan_state *st) -----//
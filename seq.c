@@ -0,0 +1,269 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  SEQ -- what the residues say when the annotation is silent
+ *
+ *  Membrane membership otherwise rests on curated FT and CC lines,
+ *  which most unreviewed entries lack.  With --predict-tm the SQ
+ *  block is read too: classify_line() hands it to seq_begin() and
+ *  seq_line(), which gather the residues into the record's arena,
+ *  and classify_end() asks seq_tm_segments() how many stretches of
+ *  the chain are hydrophobic enough to span a bilayer.  That is the
+ *  Kyte & Doolittle hydropathy averaged over a 19 residue window
+ *  reaching 1.6 (J Mol Biol 157: 105-132; 1982); each maximal run
+ *  of such windows counts as one predicted segment.
+ *
+ *  With --seq-stats the same residues give the composition, the
+ *  length and the hydropathy of the N-terminus (the most
+ *  hydrophobic 8 of the first 30 residues, a signal peptide's core)
+ *  that record_measures() turns into the sequence measures, summed
+ *  per compartment by the "compartment:sequence" cube.
+ *
+ *  The window sums are formed 8 at a time in short lanes (GCC
+ *  vector extensions, so SSE2 or NEON with no flags), with the
+ *  hydropathies in tenths so nineteen of them fit.  A window slides
+ *  by adding the residue it gains and taking off the one it drops;
+ *  a run starts at a window over the bar whose predecessor, the
+ *  lane before, is not.
+ *
+ *  The composition is a plain histogram, four of them interleaved
+ *  so consecutive equal residues do not wait on one counter: a
+ *  compare and count per residue kind in byte lanes needs twenty
+ *  compares a vector and came out three times slower on SSE2.
+ *
+ *********************************************************************/
+
+#define KD_LANES     8
+#define KD_BAR       (16*KD_WINDOW)           /* an average of 1.6, in tenths */
+#define KD_PAD       -1000                    /* sinks any window it is in */
+
+typedef short kd_vec __attribute__ ((vector_size (2*KD_LANES)));
+
+#define NTERM_SPAN   30                       /* residues searched for a core */
+#define NTERM_WINDOW 8
+
+/*  Kyte-Doolittle hydropathy x 10, A to Z; B and Z as D/N and E/Q, others 0  */
+static const signed char KD_ARRAY[26] = {
+             18, -35, 25, -35, -35, 28, -4, -32, 45, 0, -39, 38, 19,
+             -35, 0, -16, -35, -45, -8, -7, 0, 42, -9, 0, -13, -35};
+
+/*  SEQ_AA index of A to Z, SEQ_AA_COUNT-1 for the nonstandard  */
+static const unsigned char AA_INDEX_ARRAY[26] = {
+             0, 20, 1, 2, 3, 4, 5, 6, 7, 20, 8, 9, 10,
+             11, 20, 12, 13, 14, 15, 16, 20, 17, 18, 20, 19, 20};
+
+const char *SEQ_AA_NAMES_ARRAY[SEQ_AA_COUNT] = {"A","C","D","E","F","G","H","I",
+             "K","L","M","N","P","Q","R","S","T","V","W","Y","other"};
+const char *SEQ_LEN_NAMES_ARRAY[SEQ_LEN_BINS] = {"<100","100-199","200-399",
+             "400-799","800-1599","1600+"};
+const char *SEQ_NTERM_NAMES_ARRAY[SEQ_NTERM_BINS] = {"<0","0-1","1-2","2+"};
+
+
+void seq_begin (struct prot_record *rec, const char *p, int b, int stages) {
+/*****************************************************************
+ *
+ *  At the SQ line
+ *
+ *    SQ   SEQUENCE   386 AA;  43811 MW;  5D1A4E2BD3C8A2F1 CRC64;
+ *
+ *  room for the residues it declares, from the record's arena
+ *
+ *****************************************************************/
+  int i, n = 0;
+
+  for (i=5;(i<b)&&((p[i]<'0')||(p[i]>'9'));i++)
+    ;
+  for (;(i<b)&&(p[i]>='0')&&(p[i]<='9')&&(n<SEQ_MAX_LEN);i++)
+    n = 10*n + (p[i] - '0');
+  if (n > SEQ_MAX_LEN)
+    n = SEQ_MAX_LEN;
+  rec->seq = arena_alloc(&rec->arena, n + 1);
+  rec->seq_cap = n;
+  rec->seq_len = 0;
+  rec->seq_stages = stages;
+  rec->in_SQ = 1;
+}
+
+
+void seq_line (struct prot_record *rec, const char *p, int b) {
+/*****************************************************************
+ *  The residues of one sequence line, blanks squeezed out; any
+ *  beyond the declared length are dropped
+ *****************************************************************/
+  char *s = rec->seq;
+  int i, n = rec->seq_len;
+
+  for (i=0;(i<b)&&(n<rec->seq_cap);i++) {
+    s[n] = p[i];
+    n += (p[i] != ' ');
+  }
+  rec->seq_len = n;
+}
+
+
+int seq_tm_segments (const char *seq, int n, short *scratch) {
+/*****************************************************************
+ *
+ *  Predicted transmembrane segments of seq[0..n), given scratch
+ *  of SEQ_SCRATCH(n) shorts.  h[] below is the hydropathy of each
+ *  residue with KD_PAD on both sides, so the windows that would
+ *  run off either end never clear the bar.
+ *
+ *  The window sum at i is the one at i-1 plus h[i+18] - h[i-1],
+ *  so each pass takes those differences for KD_LANES windows,
+ *  adds them up across the lanes in three shifts and carries in
+ *  the last sum of the pass before.
+ *
+ *****************************************************************/
+  const kd_vec zero = {0}, up1 = {8,0,1,2,3,4,5,6}, up2 = {8,8,0,1,2,3,4,5},
+               up4 = {8,8,8,8,0,1,2,3}, last = {7,7,7,7,7,7,7,7};
+  short *h = scratch + 1;
+  kd_vec s, d, w, carry, starts = {0};
+  int i, k, count = 0;
+  unsigned char c;
+
+  if (n < KD_WINDOW)
+    return 0;
+  h[-1] = KD_PAD;
+  for (i=0;i<n;i++) {
+    c = seq[i] - 'A';
+    h[i] = KD_ARRAY[(c < 26) ? c : 'X' - 'A'];
+  }
+  for (;i<n+KD_WINDOW+KD_LANES;i++)
+    h[i] = KD_PAD;
+
+  k = 0;
+  for (i=-1;i<KD_WINDOW-1;i++)
+    k += h[i];
+  carry = zero + (short)k;
+
+  for (i=0;i<=n-KD_WINDOW;i+=KD_LANES) {
+    memcpy(&d, h + i + KD_WINDOW - 1, sizeof(d));
+    memcpy(&w, h + i - 1, sizeof(w));
+    d -= w;
+    d += __builtin_shuffle(d, zero, up1);
+    d += __builtin_shuffle(d, zero, up2);
+    d += __builtin_shuffle(d, zero, up4);
+    s = carry + d;
+    w = __builtin_shuffle(s, carry, up1);
+    starts -= (s >= KD_BAR) & (w < KD_BAR);
+    carry = __builtin_shuffle(s, last);
+  }
+  for (k=0;k<KD_LANES;k++)
+    count += starts[k];
+  return count;
+} //----- seq_tm_segments -----//
+
+
+void seq_count_residues (const char *seq, int n, int *counts) {
+/*****************************************************************
+ *  counts[SEQ_AA_COUNT] of each residue kind in seq[0..n)
+ *****************************************************************/
+  int h[4][SEQ_AA_COUNT], i, k;
+  unsigned char c[4];
+
+  memset(h, 0, sizeof(h));
+  for (i=0;i+4<=n;i+=4) {
+    for (k=0;k<4;k++) {
+      c[k] = seq[i+k] - 'A';
+      c[k] = (c[k] < 26) ? AA_INDEX_ARRAY[c[k]] : SEQ_AA_COUNT - 1;
+    }
+    h[0][c[0]]++;
+    h[1][c[1]]++;
+    h[2][c[2]]++;
+    h[3][c[3]]++;
+  }
+  for (;i<n;i++) {
+    c[0] = seq[i] - 'A';
+    h[0][(c[0] < 26) ? AA_INDEX_ARRAY[c[0]] : SEQ_AA_COUNT - 1]++;
+  }
+  for (k=0;k<SEQ_AA_COUNT;k++)
+    counts[k] = h[0][k] + h[1][k] + h[2][k] + h[3][k];
+} //----- seq_count_residues -----//
+
+
+int seq_nterm_kd (const char *seq, int n) {
+/*****************************************************************
+ *  Highest mean hydropathy (x 10) of NTERM_WINDOW residues among
+ *  the first NTERM_SPAN; of all of them in a shorter chain
+ *****************************************************************/
+  int i, w, sum = 0, best = -1000*NTERM_WINDOW;
+  unsigned char c;
+
+  if (n > NTERM_SPAN)
+    n = NTERM_SPAN;
+  w = (n < NTERM_WINDOW) ? n : NTERM_WINDOW;
+  if (w == 0)
+    return 0;
+  for (i=0;i<n;i++) {
+    c = seq[i] - 'A';
+    sum += KD_ARRAY[(c < 26) ? c : 'X' - 'A'];
+    if (i >= w) {
+      c = seq[i-w] - 'A';
+      sum -= KD_ARRAY[(c < 26) ? c : 'X' - 'A'];
+    }
+    if ((i >= w - 1) && (sum > best))
+      best = sum;
+  }
+  return best/w;
+} //----- seq_nterm_kd -----//
+
+
+int seq_len_bin (int n) {
+  int bin = 0, edge;
+
+  for (edge=100;(n >= edge)&&(bin < SEQ_LEN_BINS-1);edge*=2)
+    bin++;
+  return bin;
+}
+
+
+int seq_nterm_bin (int kd) {
+  if (kd < 0)
+    return 0;
+  return (kd < 20) ? 1 + kd/10 : SEQ_NTERM_BINS - 1;
+}
+
+
+void seq_end (struct prot_record *rec) {
+/*****************************************************************
+ *  At the // line, the stages asked for at the SQ line
+ *****************************************************************/
+  if (rec->seq_stages & SEQ_TM)
+    rec->tm_segments = seq_tm_segments(rec->seq, rec->seq_len,
+                           arena_alloc(&rec->arena, SEQ_SCRATCH(rec->seq_len)*sizeof(short)));
+  if (rec->seq_stages & SEQ_STATS) {
+    seq_count_residues(rec->seq, rec->seq_len, rec->seq_counts);
+    rec->nterm_kd = seq_nterm_kd(rec->seq, rec->seq_len);
+  }
+}
@@ -24,27 +24,232 @@ along with this program; if not, see
 <https://www.gnu.org/licenses/>.
 
 */
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 #include <cairo.h>
+#include "promog.h"
+
+#define MAX_THREADS  64
+
+
+static int stub_rows (FILE *fp, const char *path, const char *dir,
+                      struct cellgram_job **jobs_out) {
+/*****************************************************************
+ *
+ *  One job per row of fp: title, infile, nuclear, cytosolic,
+ *  membrane, extracellular and optionally the PNG to write,
+ *  separated by tabs, or by commas on a line without a tab.
+ *  Blank lines and lines beginning '#' are skipped, and so is the
+ *  first other line if its counts are not numbers (a header).
+ *  Without a PNG column a row goes to <dir>/<infile>.<title>.png
+ *  named as promog --cellgram-dir names them.  Returns the number
+ *  of jobs, or -1 on a short row or a count that is not a number;
+ *  path is only for the message.
+ *
+ *****************************************************************/
+  struct cellgram_job *jobs = NULL, *job;
+  char *line = NULL, *field[7], *p, *end, *out, delim[2] = "\t";
+  const char *base;
+  size_t cap = 0;
+  ssize_t len;
+  int n = 0, max = 0, n_fields, line_no = 0, n_rows = 0, k;
+  double v[4];
+
+  while ((len = getline(&line, &cap, fp)) != -1) {
+    line_no++;
+    while ((len > 0) && ((line[len-1] == '\n') || (line[len-1] == '\r')))
+      line[--len] = '\0';
+    if ((len == 0) || (line[0] == '#'))
+      continue;
+    delim[0] = strchr(line, '\t') ? '\t' : ',';
+    n_fields = 0;
+    for (p=line;n_fields<7;p=end+1) {
+      field[n_fields++] = p;
+      if ((end = strchr(p, delim[0])) == NULL)
+        break;
+      *end = '\0';
+    }
+    n_rows++;
+    if (n_fields < 6) {
+      fprintf(stderr, "CAN'T READ ROW %s:%d: %d FIELDS\n", path, line_no, n_fields);
+      free(line);
+      free(jobs);
+      return -1;
+    }
+    for (k=0;k<4;k++) {
+      v[k] = strtod(field[k+2], &end);
+      if ((end == field[k+2]) || (end[strspn(end, " ")] != '\0'))
+        break;
+    }
+    if ((k < 4) && (n_rows == 1))
+      continue;                        /* the header */
+    if (k < 4) {
+      fprintf(stderr, "CAN'T READ ROW %s:%d: BAD COUNT '%s'\n", path, line_no, field[k+2]);
+      free(line);
+      free(jobs);
+      return -1;
+    }
+
+    if (n == max) {
+      max = max ? 2*max : 1024;
+      jobs = realloc(jobs, max*sizeof(struct cellgram_job));
+    }
+    job = &jobs[n++];
+    memset(job, 0, sizeof(*job));
+    job->title = strdup(field[0]);
+    job->infile = strdup(field[1]);
+    job->nuclear = v[0];
+    job->cytosolic = v[1];
+    job->membrane = v[2];
+    job->extracellular = v[3];
+    if ((n_fields == 7) && (*field[6] != '\0'))
+      job->out = strdup(field[6]);
+    else {
+      base = strrchr(field[1], '/') ? strrchr(field[1], '/') + 1 : field[1];
+      out = malloc(strlen(dir) + strlen(base) + strlen(field[0]) + 8);
+      sprintf(out, "%s/%s.", dir, base);
+      p = out + strlen(out);
+      strcpy(p, field[0]);
+      for (;*p;p++)
+        if (*p == '/')
+          *p = '_';
+      strcat(out, ".png");
+      job->out = out;
+    }
+  }
+  free(line);
+  *jobs_out = jobs;
+  return n;
+} //----- stub_rows -----//
+
 
 int
 main (int argc, char *argv[]) {
-  
-   char *title = argv[1];
-   char *infile = argv[2];
-   double nuclear = atof(argv[3]);
-   double cytosolic = atof(argv[4]);
-   double membrane = atof(argv[5]);
-   double extracellular = atof(argv[6]);
-
-   
- 
+/*****************************************************************
+ *
+ *  stub [-o <png> [-c <cachedir> [-s <MB>]]] title infile
+ *       nuclear cytosolic membrane extracellular
+ *  stub -f <rows|-> [-d <dir>] [-t <threads>] [-c <cachedir> [-s <MB>]]
+ *
+ *  One cellgram.  With -o it is drawn to that file by render.c,
+ *  and with -c through the render cache promog uses as well.
+ *
+ *  With -f every row of a TSV or CSV file (- for stdin, see
+ *  stub_rows()) is drawn in this one process on -t threads (all
+ *  the processors by default), each thread reusing one surface,
+ *  and the rate is reported on stderr.
+ *
+ *****************************************************************/
+   char *out = NULL, *cache_dir = NULL, *rows = NULL, *dir = ".";
+   long long cache_mb = 256;
+   struct render_cache *rc = NULL;
+   struct cellgram_job job, *jobs;
+   struct timespec t_begin, t_end;
+   FILE *fp;
+   int opt, status, n_jobs, n_bad, i;
+   int n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+   double secs;
+
+   while ((opt = getopt(argc, argv, "o:c:s:f:d:t:")) != EOF) {
+     switch (opt) {
+       case 'o':
+         out = optarg;
+         break;
+       case 'c':
+         cache_dir = optarg;
+         break;
+       case 's':
+         cache_mb = atoll(optarg);
+         break;
+       case 'f':
+         rows = optarg;
+         break;
+       case 'd':
+         dir = optarg;
+         break;
+       case 't':
+         n_threads = atoi(optarg);
+         break;
+       default:
+         argc = 0;
+     }
+   }
+   if (n_threads < 1)
+     n_threads = 1;
+   if (n_threads > MAX_THREADS)
+     n_threads = MAX_THREADS;
+
+   if ((rows != NULL) && (argc > 0)) {
+     if (strcmp(rows, "-") == 0)
+       fp = stdin;
+     else if ((fp = fopen(rows, "r")) == NULL) {
+       perror(rows);
+       return -1;
+     }
+     n_jobs = stub_rows(fp, (fp == stdin) ? "<stdin>" : rows, dir, &jobs);
+     if (fp != stdin)
+       fclose(fp);
+     if (n_jobs < 0)
+       return -1;
+     if ((cache_dir != NULL) && ((rc = rcache_open(cache_dir, cache_mb<<20)) == NULL))
+       return -1;
+
+     clock_gettime(CLOCK_MONOTONIC, &t_begin);
+     status = cellgram_batch(jobs, n_jobs, n_threads, rc);
+     clock_gettime(CLOCK_MONOTONIC, &t_end);
+     rcache_close(rc);
+
+     secs = (t_end.tv_sec - t_begin.tv_sec) + (t_end.tv_nsec - t_begin.tv_nsec)/1e9;
+     n_bad = 0;
+     for (i=0;i<n_jobs;i++)
+       n_bad += (jobs[i].status != 0);
+     fprintf(stderr, "%d cellgrams (%d failed) on %d threads in %.3f s: %.1f charts/s\n",
+             n_jobs, n_bad, n_threads, secs, secs > 0 ? n_jobs/secs : 0.0);
+     for (i=0;i<n_jobs;i++) {
+       free(jobs[i].title);
+       free(jobs[i].infile);
+       free((char *)jobs[i].out);
+     }
+     free(jobs);
+     return status;
+   }
+   if (argc - optind < 6) {
+     perror("USAGE: stub [-o <png> [-c <cachedir> [-s <MB>]]] title infile"
+         " nuclear cytosolic membrane extracellular\n"
+         "       stub -f <rows|-> [-d <dir>] [-t <threads>] [-c <cachedir> [-s <MB>]]"
+         " O:=} Not");
+     return -1;
+   }
+
+   char *title = argv[optind];
+   char *infile = argv[optind+1];
+   double nuclear = atof(argv[optind+2]);
+   double cytosolic = atof(argv[optind+3]);
+   double membrane = atof(argv[optind+4]);
+   double extracellular = atof(argv[optind+5]);
+
    printf(" nuclear is %6.2f\n", (float)nuclear); 
    printf(" cytosolic is %6.2f\n", (float)cytosolic); 
    printf(" membrane is %6.2f\n", (float)membrane); 
    printf(" extracelluar is %6.2f\n", (float)extracellular); 
 
-   cellgram(title,infile,nuclear,cytosolic,membrane,extracellular);  
+   if (out == NULL)
+     return cellgram(title,infile,nuclear,cytosolic,membrane,extracellular);  
 
-} //----- main (int argc, char *argv[])-----// 
+   if ((cache_dir != NULL) && ((rc = rcache_open(cache_dir, cache_mb<<20)) == NULL))
+     return -1;
+   job.title = title;
+   job.infile = infile;
+   job.nuclear = nuclear;
+   job.cytosolic = cytosolic;
+   job.membrane = membrane;
+   job.extracellular = extracellular;
+   job.out = out;
+   status = cellgram_batch(&job, 1, 1, rc);
+   rcache_close(rc);
+   return status;
+} //----- main (int argc, char *argv[])-----//
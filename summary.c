@@ -0,0 +1,409 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "promog.h"
+
+/*********************************************************************
+ *
+ *  SUMMARY -- the report in machine readable form
+ *
+ *  The text report, and in machine readable form --format=json
+ *  (one JSON object) or --format=tsv (one "group<TAB>measure<TAB>
+ *  value" line per counter).  The structured formats are formatted
+ *  into a memory stream and handed to a single write(), instead of
+ *  the hundred-odd printf()s of the text report.
+ *
+ *  Everything is read from a promog_summary, so a scan and a run
+ *  answered from the result cache print the same thing.
+ *
+ *********************************************************************/
+
+/*********************************************************************
+ *  Report groups (GROUP_COUNT of them, promog.h), as matches on
+ *  the "human,brain,muscle" keys
+ *********************************************************************/
+static const char *GROUP_NAMES_ARRAY[GROUP_COUNT] = {"human", "total", "brain", "muscle"};
+static const int GROUP_MATCH_ARRAY[GROUP_COUNT][3] = {
+             {1, XT_ANY, XT_ANY}, {XT_ANY, XT_ANY, XT_ANY},
+             {XT_ANY, 1, XT_ANY}, {XT_ANY, XT_ANY, 1}};
+
+
+int summary_format (const char *name) {
+  if (!strcmp(name, "text"))
+    return FORMAT_TEXT;
+  if (!strcmp(name, "json"))
+    return FORMAT_JSON;
+  if (!strcmp(name, "tsv"))
+    return FORMAT_TSV;
+  return -1;
+}
+
+void json_string (FILE *fp, const char *s) {
+  fputc('"', fp);
+  for (;*s;s++) {
+    if ((*s == '"') || (*s == '\\'))
+      fprintf(fp, "\\%c", *s);
+    else if ((unsigned char)*s < ' ')
+      fprintf(fp, "\\u%04x", *s);
+    else
+      fputc(*s, fp);
+  }
+  fputc('"', fp);
+}
+
+static double elapsed (const struct promog_summary *sum) {
+  return (sum->t_end.tv_sec - sum->t_begin.tv_sec)
+         + (sum->t_end.tv_nsec - sum->t_begin.tv_nsec) / 1e9;
+}
+
+static long long group_sum (const struct promog_summary *sum, int g, int measure) {
+  return crosstab_sum(sum->report, GROUP_MATCH_ARRAY[g], measure);
+}
+
+static long long membrane_net (const struct promog_summary *sum, int g) {
+/*****************************************************************
+ *  The report's "total membrane proteins": membrane less the
+ *  SIGNAL peptide proteins, for the human and total groups only.
+ *****************************************************************/
+  long long membrane = group_sum(sum, g, M_MEMBRANE);
+
+  if (g < 2)
+    membrane -= group_sum(sum, g, M_FT+FT_SIGNAL_INDEX);
+  return membrane;
+}
+
+
+static void summary_text (const struct promog_summary *sum) {
+/*****************************************************************
+ *  The report as promog has always printed it
+ *****************************************************************/
+  const int HUMAN = 0, TOTAL = 1, BRAIN = 2, MUSCLE = 3;
+  int i, k;
+
+  printf("----------------------------------------\n"); 
+  printf("processing %s \n", sum->datafile ); 
+  printf("the memory allocation method is %s\n",sum->mem_method); 
+  if (sum->n_threads > 1)
+    printf("scanned in %d ranges on as many threads\n",sum->n_threads);
+  printf("The longest line has %d characters\n",sum->max_line);
+  printf("There are a total of %lld lines\n",sum->line_num);
+  printf("--------HUMAN PROTEINS--------------------\n"); 
+  printf("human proteins: %lld\n",group_sum(sum,HUMAN,M_PROTEINS));
+  printf("human FT TRANSMEM proteins: %lld\n",group_sum(sum,HUMAN,M_FT+FT_TRANSMEM_INDEX));
+  printf("human FT INTRAMEM proteins: %lld\n",group_sum(sum,HUMAN,M_FT+FT_INTRAMEM_INDEX));
+  printf("human proteins with covalent lipid binding (FT LIPID): %lld\n",
+      group_sum(sum,HUMAN,M_FT+FT_LIPID_INDEX));
+  printf("human proteins both intra- & trans- membrane: %lld\n",group_sum(sum,HUMAN,M_ITMEM));
+  printf("human FT SIGNAL signal peptide containing proteins: %lld\n",
+      group_sum(sum,HUMAN,M_FT+FT_SIGNAL_INDEX));
+  printf("human proteins with both signal sequence and transmembrane: %lld\n",
+      group_sum(sum,HUMAN,M_SIG_TRANSMEM));
+  printf("human proteins with DNA_BIND: %lld\n",group_sum(sum,HUMAN,M_FT+FT_DNA_BIND_INDEX));
+
+  for(i=0;i<REGEX_COUNT;i++) 
+     printf("%d: human proteins with CC SUBCELLULAR LOCATION \"%s\": %lld\n",
+         i, NAMES_ARRAY[i], group_sum(sum,HUMAN,M_SCL+i));
+
+  for(i=0;i<GO_COUNT;i++) 
+     printf("%d: human proteins with Gene Ontology \"%s\": %lld\n",
+         i, GO_NAMES_ARRAY[i], group_sum(sum,HUMAN,M_GO+i));
+
+  printf("human proteins with no CC SUBCELLULAR LOCATION annotation: %lld\n",
+      group_sum(sum,HUMAN,M_SCL_NULL));
+  printf("human total membrane proteins: %lld\n",membrane_net(sum,HUMAN));
+  printf("human cytoplasmic proteins: %lld\n",group_sum(sum,HUMAN,M_CYTOSOLIC));
+  printf("human extracellular proteins: %lld\n",group_sum(sum,HUMAN,M_EXTRACELLULAR));
+  printf("human nuclear proteins: %lld\n",group_sum(sum,HUMAN,M_NUCLEAR));
+  printf("REMAINDER human proteins: %lld\n",group_sum(sum,HUMAN,M_REMAINDER));
+  if (sum->seq & SEQ_TM) {
+    printf("human proteins with a predicted transmembrane segment: %lld\n",
+        group_sum(sum,HUMAN,M_PREDICTED));
+    printf("human predicted membrane proteins without a membrane annotation: %lld\n",
+        group_sum(sum,HUMAN,M_PREDICTED_ONLY));
+  }
+  printf("----------------------------------------\n"); 
+
+  printf("There are %lld total proteins \n",sum->tot_proteins);
+  printf("total FT TRANSMEM proteins: %lld\n",group_sum(sum,TOTAL,M_FT+FT_TRANSMEM_INDEX));
+  printf("total FT INTRAMEM proteins: %lld\n",group_sum(sum,TOTAL,M_FT+FT_INTRAMEM_INDEX));
+  printf("total proteins with covalent lipid binding: %lld\n",
+      group_sum(sum,TOTAL,M_FT+FT_LIPID_INDEX));
+  printf("total proteins both intra- & trans- membrane: %lld\n",group_sum(sum,TOTAL,M_ITMEM));
+  printf("total FT SIGNAL signal peptide containing proteins: %lld\n",
+      group_sum(sum,TOTAL,M_FT+FT_SIGNAL_INDEX));
+  printf("total proteins with both signal sequence and transmembrane: %lld\n",
+      group_sum(sum,TOTAL,M_SIG_TRANSMEM));
+  printf("total proteins with DNA_BIND: %lld\n",group_sum(sum,TOTAL,M_FT+FT_DNA_BIND_INDEX));
+
+  for(i=0;i<REGEX_COUNT;i++) 
+     printf("%d: total proteins with CC SUBCELLULAR LOCATION \"%s\": %lld\n",
+         i, NAMES_ARRAY[i], group_sum(sum,TOTAL,M_SCL+i));
+
+  for(i=0;i<GO_COUNT;i++) 
+     printf("%d: total proteins with Gene Ontology \"%s\": %lld\n",
+         i, GO_NAMES_ARRAY[i], group_sum(sum,TOTAL,M_GO+i));
+
+  printf("total proteins with no CC SUBCELLULAR LOCATION annotation: %lld\n",
+      group_sum(sum,TOTAL,M_SCL_NULL));
+  printf("total total membrane proteins: %lld\n",membrane_net(sum,TOTAL));
+  printf("total cytoplasmic proteins: %lld\n",group_sum(sum,TOTAL,M_CYTOSOLIC));
+  printf("total extracellular proteins: %lld\n",group_sum(sum,TOTAL,M_EXTRACELLULAR));
+  printf("total nuclear proteins: %lld\n",group_sum(sum,TOTAL,M_NUCLEAR));
+  printf("REMAINDER total proteins: %lld\n",group_sum(sum,TOTAL,M_REMAINDER));
+  if (sum->seq & SEQ_TM) {
+    printf("total proteins with a predicted transmembrane segment: %lld\n",
+        group_sum(sum,TOTAL,M_PREDICTED));
+    printf("total predicted membrane proteins without a membrane annotation: %lld\n",
+        group_sum(sum,TOTAL,M_PREDICTED_ONLY));
+  }
+  printf("----------------------------------------\n"); 
+  printf("total brain proteins: %lld\n",group_sum(sum,BRAIN,M_PROTEINS));
+  printf("brain nuclear proteins: %lld\n",group_sum(sum,BRAIN,M_NUCLEAR));
+  printf("brain cytoplasmic proteins: %lld\n",group_sum(sum,BRAIN,M_CYTOSOLIC));
+  printf("brain membrane proteins: %lld\n",group_sum(sum,BRAIN,M_MEMBRANE));
+  printf("brain extracellular proteins: %lld\n",group_sum(sum,BRAIN,M_EXTRACELLULAR));
+  printf("----------------------------------------\n"); 
+  printf("total muscle proteins: %lld\n",group_sum(sum,MUSCLE,M_PROTEINS));
+  printf("muscle nuclear proteins: %lld\n",group_sum(sum,MUSCLE,M_NUCLEAR));
+  printf("muscle cytoplasmic proteins: %lld\n",group_sum(sum,MUSCLE,M_CYTOSOLIC));
+  printf("muscle membrane proteins: %lld\n",group_sum(sum,MUSCLE,M_MEMBRANE));
+  printf("muscle extracellular proteins: %lld\n",group_sum(sum,MUSCLE,M_EXTRACELLULAR));
+  printf("----------------------------------------\n"); 
+  printf("The protein with the most lines has %d lines\n",sum->max_prot_lines);/**/
+  printf("BLOCKSIZE IS %d\n",sum->blocksize);
+  if (sum->index_path != NULL)
+    printf("record index of %lld proteins written to %s\n",sum->tot_proteins,sum->index_path);
+  if (sum->list_path != NULL)
+    printf("protein list of %lld proteins written to %s\n",sum->tot_proteins,sum->list_path);
+  if (sum->export_path != NULL)
+    printf("columnar export of %lld proteins written to %s\n",sum->tot_proteins,
+        sum->export_path);
+  printf("it took");
+  metrics_interval(stdout, (sum->t_end.tv_sec - sum->t_begin.tv_sec) * 1000000000LL
+                   + (sum->t_end.tv_nsec - sum->t_begin.tv_nsec));
+  printf(" to run.\n");
+  printf("----------------------------------------\n"); 
+  for (k=0;k<sum->n_cubes;k++) {
+    printf("--------CROSSTAB %s--------\n", crosstab_spec(sum->cubes[k]));
+    crosstab_print(sum->cubes[k], stdout);
+    printf("----------------------------------------\n"); 
+  }
+  fflush(stdout);
+} //----- summary_text (const struct promog_summary *sum) -----//
+
+
+static void summary_json (const struct promog_summary *sum, FILE *fp) {
+  char name[128];
+  int g, m, k, first;
+
+  fprintf(fp, "{\n  \"datafile\": ");
+  json_string(fp, sum->datafile);
+  fprintf(fp, ",\n  \"memory_allocation\": \"%s\",\n", sum->mem_method);
+  fprintf(fp, "  \"threads\": %d,\n  \"blocksize\": %d,\n", sum->n_threads, sum->blocksize);
+  fprintf(fp, "  \"proteins\": %lld,\n  \"lines\": %lld,\n  \"chars\": %lld,\n",
+      sum->tot_proteins, sum->line_num, sum->char_count);
+  fprintf(fp, "  \"max_line\": %d,\n  \"max_protein_lines\": %d,\n"
+      "  \"max_protein_chars\": %d,\n  \"corrupt_infile\": %s,\n",
+      sum->max_line, sum->max_prot_lines, sum->max_prot_chars,
+      sum->corrupt_infile ? "true" : "false");
+  fprintf(fp, "  \"elapsed_sec\": %.6f,\n", elapsed(sum));
+
+  fprintf(fp, "  \"groups\": {");
+  for (g=0;g<GROUP_COUNT;g++) {
+    fprintf(fp, "%s\n    \"%s\": {", g ? "," : "", GROUP_NAMES_ARRAY[g]);
+    for (m=0;m<REPORT_MEASURES;m++) {
+      measure_name(m, name, sizeof(name));
+      fprintf(fp, "%s\n      ", m ? "," : "");
+      json_string(fp, name);
+      fprintf(fp, ": %lld", group_sum(sum, g, m));
+    }
+    fprintf(fp, ",\n      \"membrane_net\": %lld\n    }", membrane_net(sum, g));
+  }
+  fprintf(fp, "\n  },\n");
+
+  fprintf(fp, "  \"outputs\": {");
+  first = 1;
+  if (sum->index_path != NULL) {
+    fprintf(fp, "\"index\": ");
+    json_string(fp, sum->index_path);
+    first = 0;
+  }
+  if (sum->list_path != NULL) {
+    fprintf(fp, "%s\"list\": ", first ? "" : ", ");
+    json_string(fp, sum->list_path);
+    first = 0;
+  }
+  if (sum->export_path != NULL) {
+    fprintf(fp, "%s\"export\": ", first ? "" : ", ");
+    json_string(fp, sum->export_path);
+  }
+  fprintf(fp, "},\n");
+
+  fprintf(fp, "  \"crosstabs\": [");
+  for (k=0;k<sum->n_cubes;k++) {
+    fprintf(fp, "%s\n  ", k ? "," : "");
+    crosstab_print_json(sum->cubes[k], fp);
+  }
+  fprintf(fp, "%s]\n}\n", sum->n_cubes ? "\n  " : "");
+} //----- summary_json (const struct promog_summary *sum, FILE *fp) -----//
+
+
+static void summary_tsv (const struct promog_summary *sum, FILE *fp) {
+  char name[128];
+  int g, m, k;
+
+  fprintf(fp, "group\tmeasure\tvalue\n");
+  fprintf(fp, "run\tdatafile\t%s\n", sum->datafile);
+  fprintf(fp, "run\tmemory_allocation\t%s\n", sum->mem_method);
+  fprintf(fp, "run\tthreads\t%d\n", sum->n_threads);
+  fprintf(fp, "run\tblocksize\t%d\n", sum->blocksize);
+  fprintf(fp, "run\tproteins\t%lld\n", sum->tot_proteins);
+  fprintf(fp, "run\tlines\t%lld\n", sum->line_num);
+  fprintf(fp, "run\tchars\t%lld\n", sum->char_count);
+  fprintf(fp, "run\tmax_line\t%d\n", sum->max_line);
+  fprintf(fp, "run\tmax_protein_lines\t%d\n", sum->max_prot_lines);
+  fprintf(fp, "run\tmax_protein_chars\t%d\n", sum->max_prot_chars);
+  fprintf(fp, "run\tcorrupt_infile\t%d\n", sum->corrupt_infile ? 1 : 0);
+  fprintf(fp, "run\telapsed_sec\t%.6f\n", elapsed(sum));
+  for (g=0;g<GROUP_COUNT;g++) {
+    for (m=0;m<REPORT_MEASURES;m++) {
+      measure_name(m, name, sizeof(name));
+      fprintf(fp, "%s\t%s\t%lld\n", GROUP_NAMES_ARRAY[g], name,
+          group_sum(sum, g, m));
+    }
+    fprintf(fp, "%s\tmembrane_net\t%lld\n", GROUP_NAMES_ARRAY[g], membrane_net(sum, g));
+  }
+  /*  cross-tabulations follow as their own tables  */
+  for (k=0;k<sum->n_cubes;k++) {
+    fprintf(fp, "\n# crosstab %s\n", crosstab_spec(sum->cubes[k]));
+    crosstab_print(sum->cubes[k], fp);
+  }
+} //----- summary_tsv (const struct promog_summary *sum, FILE *fp) -----//
+
+
+int summary_write (const struct promog_summary *sum, int format, int fd) {
+/*****************************************************************
+ *  FORMAT_TEXT goes to stdout.  The others are formatted whole in
+ *  memory, then one write() to fd.
+ *****************************************************************/
+  char *buf = NULL, *p;
+  size_t len = 0;
+  ssize_t w;
+  FILE *fp;
+
+  if (format == FORMAT_TEXT) {
+    summary_text(sum);
+    return 0;
+  }
+  fflush(stdout);
+  if ((fp = open_memstream(&buf, &len)) == NULL) {
+    perror("CAN'T OPEN SUMMARY BUFFER\ncause");
+    return -1;
+  }
+  if (format == FORMAT_JSON)
+    summary_json(sum, fp);
+  else
+    summary_tsv(sum, fp);
+  fclose(fp);
+  for (p = buf; len > 0; p += w, len -= w)
+    if ((w = write(fd, p, len)) < 0) {
+      perror("FAILED WRITING SUMMARY\ncause");
+      free(buf);
+      return -1;
+    }
+  free(buf);
+  return 0;
+} //----- summary_write (const struct promog_summary *sum, int format, int fd) -----//
+
+
+int summary_values (const struct promog_summary *sum, long long *v) {
+/*****************************************************************
+ *
+ *  The group counters of the report as one vector, as the tsv
+ *  format lists them: for each group its REPORT_MEASURES measures
+ *  then membrane_net, so group g measure m is at
+ *  g*(REPORT_MEASURES+1)+m.  Returns the length; v may be NULL.
+ *
+ *****************************************************************/
+  int g, m, n = 0;
+
+  for (g=0;g<GROUP_COUNT;g++) {
+    for (m=0;m<REPORT_MEASURES;m++,n++)
+      if (v != NULL)
+        v[n] = group_sum(sum, g, m);
+    if (v != NULL)
+      v[n] = membrane_net(sum, g);
+    n++;
+  }
+  return n;
+} //----- summary_values -----//
+
+
+void summary_value_name (int i, const char **group, char *measure, int size) {
+  *group = GROUP_NAMES_ARRAY[i/(REPORT_MEASURES+1)];
+  if (i%(REPORT_MEASURES+1) == REPORT_MEASURES)
+    snprintf(measure, size, "membrane_net");
+  else
+    measure_name(i%(REPORT_MEASURES+1), measure, size);
+}
+
+
+int summary_jobs (const struct promog_summary *sum, struct cellgram_job *jobs) {
+/*****************************************************************
+ *  One cellgram job per report group, GROUP_COUNT in all:
+ *  nuclear, cytosolic, membrane and extracellular counts,
+ *  membrane as printed in the report.  No out paths.
+ *****************************************************************/
+  int g;
+
+  memset(jobs, 0, GROUP_COUNT*sizeof(struct cellgram_job));
+  for (g=0;g<GROUP_COUNT;g++) {
+    jobs[g].title = (char *)GROUP_NAMES_ARRAY[g];
+    jobs[g].infile = (char *)sum->datafile;
+    jobs[g].nuclear = group_sum(sum,g,M_NUCLEAR);
+    jobs[g].cytosolic = group_sum(sum,g,M_CYTOSOLIC);
+    jobs[g].membrane = membrane_net(sum,g);
+    jobs[g].extracellular = group_sum(sum,g,M_EXTRACELLULAR);
+  }
+  return GROUP_COUNT;
+}
+
+
+void summary_cellgrams (const struct promog_summary *sum) {
+/*****************************************************************
+ *  The report groups' cellgrams, where sum->render says
+ *****************************************************************/
+  struct cellgram_job jobs[GROUP_COUNT];
+
+  summary_jobs(sum, jobs);
+  cellgram_render(jobs, GROUP_COUNT, sum->render);
+}
@@ -0,0 +1,316 @@
+/*
+
+This project aims to simplify the picture of proteomic studies without losing fine details. These studies are defined in the medical literature by data from myriad quantitative techniques that are difficult to distil holistically. The original thrust was determining which exact proteomic gene products were confined within plasma membranes.  According to the work of Singer and Nicolson from Science 175; 720-731; 1972, these proteins could be thought of as being constrained in space along folded sheets confined to two dimensional diffusion only, as opposed to having complete freedom to diffuse in three dimensions.  This idea was coined the Fluid Mosaic Model (FMM) of the Structure of Cell Membranes.  The raw proteomic data chosen for this study was obtained from the UniProt Knowledgebase provided publicly at http://www.uniprot.org/uniprotkb. As this work evolved, a four compartment model proposed by Satoh et al from Multiple Sclerosis; 15: 531-541; doi:10.1177/1352458508101943; 2009 was used.  This four compartment model was 1) nuclear, 2) cytosolic, 3) membrane, and 4) extracellular proteins.
+
+
+        Copyright (C)  2026     Kayven Riese
+                                kayvey@gmail.com
+                                (415) 902-5513
+                                3591 Quail Lakes Drive Unit 84
+                                Stockton, CA   95207
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see
+<https://www.gnu.org/licenses/>.
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include "promog.h"
+
+/*********************************************************************
+ *  Regular expression data 
+ *********************************************************************/
+const char* REGEX_RAW_ARRAY[REGEX_COUNT] = { "[Cc]ell [Mm]embrane", "[mM]embrane", "[cC]ytoplasm", 
+             "[cC]ytosol", "[Ee]xtracellular", "[Ss]ecreted", "[Nn]ucleus", 
+             "[Mm]itochondrion", "[Ee]ndoplasmic reticulum lumen", "[Cc]ell junction", 
+             "[Pp]eriplasm", "[Vv]acuole", "[Pp]lastid", "[Cc]apsid", 
+             "[Ee]ndoplasmic reticulum", "[Ee]ndosome", "[Ll]ysosome", "[Vv]irion", 
+             "[Cc]entromere", "[Pp]eroxisome", "[Gg]olgi", "[Cc]ell [Ss]urface", 
+             "[Gg]lyoxysome", "[Gg]lyocosome", "[Zz]ona pellucida", "[Kk]inetochore", 
+             "[Ss]pore", "[Bb]acterial", "[Ff]imbrium", "[Mm]elanosome", "[Tt]elomere", 
+             "[Pp]odosome", "[Cc]ilium", "[Tt]richocyst", "[Hh]ydrogenosome", 
+             "[Ss]arcoplasmic [Rr]eticulum", "[Aa]xon", "[Mm]icrosome", "[Aa]ngiotensin",
+             "[Cc]hlorosome", "[tT]hylakoid", "[Ss]oluble", "[bB]ud", "[Ff]lagellum",
+             "[Vv]iral"}; 
+
+const char* NAMES_ARRAY[REGEX_COUNT] = { "Cell Membrane", "Membrane", "Cytoplasm", "Cytosol", 
+             "Extracellular", "Secreted", "Nucleus", "Mitochondrion", 
+             "Endoplasmic reticulum lumen", "Cell junction", "Periplasm", "Vacuole", 
+             "Plastid", "Capsid", "Endoplasmic reticulum", "Endosome", "Lysosome", 
+             "Virion", "Centromere", "Peroxisome", "Golgi", "Cell Surface", 
+             "Glyoxysome", "Glyocosome", "Zona pellucida", "Kinetochore", "Spore", 
+             "Bacterial", "Fimbrium", "Melanosome", "Telomere", "Podosome", "Cilium",
+             "Trichocyst", "Hydrogenosome", "Sarcoplasmic Reticulum", "Axon", "Microsome",
+             "Angiotensin", "Chlorosome", "Thylakoid", "Soluble", "Bud", "Flagellum",
+             "Viral"}; 
+
+const char * GO_RAW_REGEX_ARRAY[GO_COUNT] = {"GO:0005634","GO:0007165","GO:0005737","GO:0005576","GO:0016021","GO:0031012","GO:0005886","GO:0005829","GO:0003677"};
+
+const char * GO_NAMES_ARRAY[GO_COUNT] = {"Nucleus","Signal Transduction","Cytoplasm","Extracellular","Integral to Membrane","Extracellular Matrix","Plasma Membrane","Cytosol","DNA binding"};
+
+const char * GO_RAW_REGEX_MINOR_ARRAY[GO_MINOR_COUNT] = {"GO:0009103","GO:0030573","GO:0055114","GO:0033644"};
+const char * GO_NAMES_MINOR_ARRAY[GO_MINOR_COUNT] = {"lipopolysaccharide biosynthetic process","Bile Aid Catabolic Process","Oxidation Reduction","Host Cell Membrane"
+};
+
+const char * FT_NAMES_ARRAY[FT_COUNT] = {"TRANSMEM","INTRAMEM","LIPID","SIGNAL","DNA_BIND"};
+
+const char * COMP_NAMES_ARRAY[COMP_COUNT] = {"nuclear","cytosolic","membrane","extracellular"};
+
+
+void reset_record (struct prot_record *rec) {
+/*****************************************************************
+ *
+ *   RESET this protein data
+ *
+ *   Everything is FALSE/empty except the REMAINDER flags, which
+ *   stay TRUE until some line of the entry claims the protein.
+ *   The tissue and keyword pointers are dead once their counts are
+ *   zero, so only the part of the record before them is cleared,
+ *   and their strings go back to the record's arena in one step.
+ *
+ *****************************************************************/
+  long long ordinal = rec->ordinal;
+
+  memset(rec, 0, offsetof(struct prot_record, tissues));
+  rec->ordinal = ordinal;
+  rec->is_REMAINDER = 1;
+  rec->is_GO_REMAINDER = 1;
+  arena_reset(&rec->arena);
+} //----- reset_record (struct prot_record *rec) -----//
+
+
+int compartment_mask (const struct prot_record *rec) {
+/*****************************************************************
+ *
+ *  Four compartment model membership of one protein.
+ *
+ *  These are the same determinants the report has always used;
+ *  note the report still subtracts FT SIGNAL proteins from its
+ *  human and total membrane counts after the scan.
+ *
+ *****************************************************************/
+  int mask = 0;
+
+  if ((rec->is_SCL_ARRAY[NUCLEUS_INDEX]) || (rec->is_SCL_ARRAY[TELOMERE_INDEX]) ||
+      (rec->has_GO_ARRAY[GO_NUCLEUS_INDEX]) || (rec->has_GO_ARRAY[GO_DNA_BIND_INDEX]))
+    mask |= COMP_NUCLEAR;
+
+  if ((rec->is_SCL_ARRAY[CYTOPLASM_INDEX]) || (rec->is_SCL_ARRAY[CYTOSOL_INDEX]) ||
+      (rec->is_SCL_ARRAY[SOLUBLE_INDEX]) || (rec->has_GO_ARRAY[GO_CYTOSOL_INDEX]) ||
+      (rec->has_GO_ARRAY[GO_CYTOPLASM_INDEX]))
+    mask |= COMP_CYTOSOLIC;
+
+  if ((rec->is_FT_TRANSMEM) || (rec->is_FT_INTRAMEM) || (rec->is_FT_LIPID) || 
+      (rec->is_SCL_ARRAY[CELL_SURF_INDEX]) || (rec->is_SCL_ARRAY[CELL_MEMB_INDEX])
+      || (rec->is_SCL_ARRAY[MEMB_INDEX]) )
+    mask |= COMP_MEMBRANE;
+
+  if ((rec->has_FT_SIGNAL) || (rec->is_SCL_ARRAY[EXTRACELLULAR_INDEX]) ||
+      (rec->is_SCL_ARRAY[SECRETED_INDEX]) || (rec->has_GO_ARRAY[GO_EXTRACELLULAR_INDEX]) ||
+      (rec->has_GO_ARRAY[GO_ECM_INDEX]))
+    mask |= COMP_EXTRACELLULAR;
+
+  return mask;
+} //----- compartment_mask (const struct prot_record *rec) -----//
+
+
+int record_has_ft (const struct prot_record *rec, int ft_index) {
+/*****************************************************************
+ *  FT flag by FT_NAMES_ARRAY index
+ *****************************************************************/
+  switch (ft_index) {
+    case FT_TRANSMEM_INDEX:
+      return rec->is_FT_TRANSMEM;
+    case FT_INTRAMEM_INDEX:
+      return rec->is_FT_INTRAMEM;
+    case FT_LIPID_INDEX:
+      return rec->is_FT_LIPID;
+    case FT_SIGNAL_INDEX:
+      return rec->has_FT_SIGNAL;
+    case FT_DNA_BIND_INDEX:
+      return rec->has_FT_DNA_BIND;
+  } //--- switch (ft_index) ---//
+  return 0;
+} //----- record_has_ft (const struct prot_record *rec, int ft_index) -----//
+
+
+void add_tissues (struct prot_record *rec, const char *line, int len) {
+/*****************************************************************
+ *
+ *  Collect the TISSUE= values of one RC line
+ *
+ *    RC   TISSUE=Brain, and Liver;
+ *    RC   STRAIN=Bristol N2; TISSUE=Muscle;
+ *
+ *  The list after TISSUE= runs to the next ';' (or end of line)
+ *  and is split on ',' with any leading "and " dropped.  Values
+ *  already seen in this entry are not repeated.
+ *
+ *****************************************************************/
+  int i = 0, k, start, end;
+
+  while (i + 7 <= len) {
+    if (strncmp(&line[i], "TISSUE=", 7)) {
+      i++;
+      continue;
+    }
+    i += 7;
+    while ((i < len) && (line[i] != ';') && (line[i] != '\n')) {
+      while ((i < len) && (line[i] == ' '))
+        i++;
+      if ((i + 4 <= len) && (!strncmp(&line[i], "and ", 4)))
+        i += 4;
+      start = i;
+      while ((i < len) && (line[i] != ',') && (line[i] != ';') && (line[i] != '\n'))
+        i++;
+      end = i;
+      while ((end > start) && (line[end-1] == ' '))
+        end--;
+      if (end - start >= TISSUE_LEN)
+        end = start + TISSUE_LEN - 1;
+      if ((end > start) && (rec->n_tissues < MAX_TISSUES)) {
+        for (k=0;k<rec->n_tissues;k++) 
+          if ((!strncmp(rec->tissues[k], &line[start], end-start)) &&
+              (rec->tissues[k][end-start] == '\0'))
+            break;
+        if (k == rec->n_tissues)
+          rec->tissues[rec->n_tissues++] = arena_strndup(&rec->arena, &line[start], end-start);
+      }
+      if ((i < len) && (line[i] == ','))
+        i++;
+    } //--- while (not at ';') ---//
+  } //--- while (i + 7 <= len) ---//
+} //----- add_tissues (struct prot_record *rec, const char *line, int len) -----//
+
+
+void add_keywords (struct prot_record *rec, const char *line, int len) {
+/*****************************************************************
+ *
+ *  Collect the values of one KW line
+ *
+ *    KW   Membrane; Transmembrane {ECO:0000256|ARBA:ARBA00022692};
+ *    KW   Transmembrane helix.
+ *
+ *  Values are split on ';', the final '.' and any evidence tag in
+ *  braces are dropped.
+ *
+ *****************************************************************/
+  int i = 5, j, start, end;
+
+  while (i < len) {
+    while ((i < len) && (line[i] == ' '))
+      i++;
+    start = i;
+    while ((i < len) && (line[i] != ';') && (line[i] != '\n'))
+      i++;
+    end = i;
+    for (j=start;j<end;j++)
+      if (line[j] == '{') {
+        end = j;
+        break;
+      }
+    while ((end > start) && ((line[end-1] == ' ') || (line[end-1] == '.')))
+      end--;
+    if (end - start >= KEYWORD_LEN)
+      end = start + KEYWORD_LEN - 1;
+    if ((end > start) && (rec->n_keywords < MAX_KEYWORDS))
+      rec->keywords[rec->n_keywords++] = arena_strndup(&rec->arena, &line[start], end-start);
+    i++;
+  } //--- while (i < len) ---//
+} //----- add_keywords (struct prot_record *rec, const char *line, int len) -----//
+
+
+void record_measures (const struct prot_record *rec, int *m) {
+/*****************************************************************
+ *
+ *  Fill m[MEASURE_COUNT] with what this protein contributes to
+ *  every count in the report.  Called at END OF RECORD, after
+ *  compartments has been set and is_REMAINDER has been cleared
+ *  for proteins without a SUBCELLULAR LOCATION comment.  The
+ *  sequence statistics are 0 unless SEQ_STATS read its SQ block.
+ *
+ *****************************************************************/
+  int i, stats = rec->seq_stages & SEQ_STATS;
+  int len_bin = stats ? seq_len_bin(rec->seq_len) : -1;
+  int nterm_bin = (stats && rec->seq_len) ? seq_nterm_bin(rec->nterm_kd) : -1;
+
+  m[M_PROTEINS] = 1;
+  for (i=0;i<COMP_COUNT;i++)
+    m[M_COMP+i] = (rec->compartments >> i) & 1;
+  for (i=0;i<FT_COUNT;i++)
+    m[M_FT+i] = record_has_ft(rec, i) ? 1 : 0;
+  m[M_ITMEM] = (rec->is_FT_INTRAMEM) && (rec->is_FT_TRANSMEM);
+  m[M_SIG_TRANSMEM] = (rec->has_FT_SIGNAL) && (rec->is_FT_TRANSMEM);
+  m[M_SCL_NULL] = !rec->has_SCL;
+  m[M_REMAINDER] = rec->is_REMAINDER ? 1 : 0;
+  m[M_DR_GO] = rec->has_DR_GO ? 1 : 0;
+  for (i=0;i<REGEX_COUNT;i++)
+    m[M_SCL+i] = rec->is_SCL_ARRAY[i] ? 1 : 0;
+  for (i=0;i<GO_COUNT;i++)
+    m[M_GO+i] = rec->has_GO_ARRAY[i] ? 1 : 0;
+  for (i=0;i<GO_MINOR_COUNT;i++)
+    m[M_GO_MINOR+i] = rec->has_GO_MINOR_ARRAY[i] ? 1 : 0;
+  m[M_PREDICTED] = (rec->tm_segments > 0);
+  m[M_PREDICTED_ONLY] = (rec->tm_segments > 0) && (!(rec->compartments & COMP_MEMBRANE));
+  m[M_RESIDUES] = stats ? rec->seq_len : 0;
+  for (i=0;i<SEQ_AA_COUNT;i++)
+    m[M_AA+i] = rec->seq_counts[i];
+  for (i=0;i<SEQ_LEN_BINS;i++)
+    m[M_LEN+i] = (len_bin == i);
+  for (i=0;i<SEQ_NTERM_BINS;i++)
+    m[M_NTERM+i] = (nterm_bin == i);
+} //----- record_measures (const struct prot_record *rec, int *m) -----//
+
+
+void measure_name (int measure, char *name, int size) {
+/*****************************************************************
+ *  Column name of a measure, as used by the crosstab output
+ *****************************************************************/
+  if (measure == M_PROTEINS)
+    snprintf(name, size, "proteins");
+  else if (measure < M_FT)
+    snprintf(name, size, "comp:%s", COMP_NAMES_ARRAY[measure-M_COMP]);
+  else if (measure < M_ITMEM)
+    snprintf(name, size, "ft:%s", FT_NAMES_ARRAY[measure-M_FT]);
+  else if (measure == M_ITMEM)
+    snprintf(name, size, "ft:INTRAMEM+TRANSMEM");
+  else if (measure == M_SIG_TRANSMEM)
+    snprintf(name, size, "ft:SIGNAL+TRANSMEM");
+  else if (measure == M_SCL_NULL)
+    snprintf(name, size, "scl_null");
+  else if (measure == M_REMAINDER)
+    snprintf(name, size, "remainder");
+  else if (measure == M_DR_GO)
+    snprintf(name, size, "dr_go");
+  else if (measure < M_GO)
+    snprintf(name, size, "scl:%s", NAMES_ARRAY[measure-M_SCL]);
+  else if (measure < M_GO_MINOR)
+    snprintf(name, size, "go:%s", GO_NAMES_ARRAY[measure-M_GO]);
+  else if (measure < M_PREDICTED)
+    snprintf(name, size, "go:%s", GO_NAMES_MINOR_ARRAY[measure-M_GO_MINOR]);
+  else if (measure == M_PREDICTED)
+    snprintf(name, size, "predicted_membrane");
+  else if (measure == M_PREDICTED_ONLY)
+    snprintf(name, size, "predicted_membrane_unannotated");
+  else if (measure == M_RESIDUES)
+    snprintf(name, size, "residues");
+  else if (measure < M_LEN)
+    snprintf(name, size, "aa:%s", SEQ_AA_NAMES_ARRAY[measure-M_AA]);
+  else if (measure < M_NTERM)
+    snprintf(name, size, "length:%s", SEQ_LEN_NAMES_ARRAY[measure-M_LEN]);
+  else
+    snprintf(name, size, "nterm_kd:%s", SEQ_NTERM_NAMES_ARRAY[measure-M_NTERM]);
+} //----- measure_name (int measure, char *name, int size) -----//